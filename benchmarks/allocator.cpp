@@ -0,0 +1,683 @@
+/**
+ * @file benchmarks/allocator.cpp
+ * @brief Benchmarks of the ITL allocator.
+ * @category Benchmarks
+ *
+ * This program measures the throughput and the latency distribution of
+ * itl::alloc, itl::free and itl::realloc in several scenarios: fixed-size
+ * churn, a random mix of sizes and operations, producer/consumer threads
+ * freeing each other's memory, growth through realloc, and the replay of
+ * allocation traces. Each measurement is written to the standard output
+ * as one JSON object per line.
+ *
+ * Usage: itl-bench [--quick] [--threads N] [--trace FILE]
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#include "runtime.hpp"
+#include "memory/allocator.hpp"
+#include "system/fmacros.hpp"
+#include "system/syscalls.hpp"
+#include "system/thread.hpp"
+#include "system/time.hpp"
+#include "typing/ctypes.hpp"
+
+#define CHURN_BATCH 1024 ///< Allocations held at once by the churn scenario.
+#define MIX_SLOTS 4096 ///< Live allocation slots of the random mix.
+#define RING_CAPACITY 4096 ///< Pointers buffered between a producer and its consumer.
+#define MAX_THREADS 64 ///< Maximum number of benchmark threads.
+#define REALLOC_LIMIT (64UL << 20) ///< Size reached by the realloc growth scenario.
+
+using namespace itl::benchmark;
+using namespace itl::thread;
+using namespace itl::time;
+
+/**
+ * @struct Settings
+ * @brief Parameters of a benchmark run, read from the command line.
+ */
+typedef struct {
+    itl::size_t scale; ///< Divisor applied to every iteration count.
+    itl::size_t threads; ///< Threads used by the multithreaded scenarios.
+    const char* trace; ///< Trace file to replay, or nullptr for a synthetic trace.
+} Settings;
+
+/**
+ * @enum TraceOperation
+ * @brief Operation recorded in an allocation trace.
+ */
+typedef enum {
+    TRACE_ALLOC, ///< Allocate size bytes into a slot.
+    TRACE_FREE, ///< Free the allocation of a slot.
+    TRACE_REALLOC ///< Resize the allocation of a slot to size bytes.
+} TraceOperation;
+
+/**
+ * @struct TraceEvent
+ * @brief One event of an allocation trace.
+ */
+typedef struct {
+    TraceOperation operation; ///< Operation to perform.
+    itl::uint32_t slot; ///< Slot holding the allocation.
+    itl::size_t size; ///< Requested size, for allocations and reallocations.
+} TraceEvent;
+
+/**
+ * @struct Ring
+ * @brief Single-producer, single-consumer ring of pointers.
+ */
+typedef struct {
+    alignas(64) itl::size_t head; ///< Next position written by the producer.
+    alignas(64) itl::size_t tail; ///< Next position read by the consumer.
+    alignas(64) void* slots[RING_CAPACITY]; ///< Buffered pointers.
+} Ring;
+
+/**
+ * @struct Worker
+ * @brief State of one producer or consumer thread.
+ */
+typedef struct {
+    Ring* ring; ///< Ring shared with the peer thread.
+    itl::size_t operations; ///< Number of objects to produce or consume.
+    itl::size_t seed; ///< Seed of the size generator.
+    volatile int* start; ///< Set once every thread is running.
+    LatencyHistogram latency; ///< Latency of the allocations or frees.
+} Worker;
+
+static Output internalOutput;
+
+/**
+ * @brief Advances a xorshift generator.
+ *
+ * @param state The state of the generator, never zero.
+ * @return The next pseudo-random value.
+ */
+static inline itl::uint64_t __internal_random(itl::uint64_t* state)
+{
+    itl::uint64_t value = *state;
+
+    value ^= value << 13;
+    value ^= value >> 7;
+    value ^= value << 17;
+    *state = value;
+
+    return value;
+}
+
+/**
+ * @brief Draws an allocation size from a distribution dominated by small
+ * objects, with a tail reaching the large object tier.
+ */
+static itl::size_t __internal_randomSize(itl::uint64_t* state)
+{
+    itl::uint64_t value = __internal_random(state);
+    itl::uint64_t bucket = value % 100;
+
+    value >>= 8;
+
+    if (bucket < 80)
+        return 8 + value % 249;
+
+    if (bucket < 95)
+        return 257 + value % 7936;
+
+    if (bucket < 99)
+        return 8193 + value % 253952;
+
+    return 262145 + value % (2UL << 20);
+}
+
+/**
+ * @brief Writes one measurement as a JSON line.
+ */
+static void __internal_report(const char* scenario, const char* operation, itl::size_t size, itl::size_t threads,
+    itl::uint64_t operations, itl::uint64_t nanoseconds, const LatencyHistogram* latency)
+{
+    beginRecord(&internalOutput);
+    stringField(&internalOutput, "scenario", scenario);
+    stringField(&internalOutput, "operation", operation);
+    numberField(&internalOutput, "size", size);
+    numberField(&internalOutput, "threads", threads);
+    numberField(&internalOutput, "operations", operations);
+    numberField(&internalOutput, "totalNs", nanoseconds);
+    numberField(&internalOutput, "opsPerSecond", nanoseconds == 0 ? 0 : operations * 1000000000ULL / nanoseconds);
+
+    if (latency != nullptr && latency->count != 0) {
+        numberField(&internalOutput, "p50Ns", cyclesToNanoseconds(percentile(latency, 500)));
+        numberField(&internalOutput, "p90Ns", cyclesToNanoseconds(percentile(latency, 900)));
+        numberField(&internalOutput, "p99Ns", cyclesToNanoseconds(percentile(latency, 990)));
+        numberField(&internalOutput, "p999Ns", cyclesToNanoseconds(percentile(latency, 999)));
+        numberField(&internalOutput, "maxNs", cyclesToNanoseconds(latency->maximum));
+    }
+
+    endRecord(&internalOutput);
+    flushOutput(&internalOutput);
+}
+
+/**
+ * @brief Maps a zeroed histogram, too large for the stack of a thread.
+ */
+static LatencyHistogram* __internal_createHistogram()
+{
+    return (LatencyHistogram*)itl::allocPages(sizeof(LatencyHistogram));
+}
+
+/**
+ * @brief Allocates and frees batches of one size.
+ *
+ * A first pass measures throughput without timing individual calls; a
+ * second pass times every call to build the latency distributions.
+ */
+static void __internal_fixedChurn(const Settings* settings, itl::size_t size)
+{
+    itl::size_t rounds = (size > MAX_SMALL_SIZE ? 8 : 512) / settings->scale + 1;
+    void** pointers = (void**)itl::alloc(CHURN_BATCH * sizeof(void*));
+    LatencyHistogram* allocLatency = __internal_createHistogram();
+    LatencyHistogram* freeLatency = __internal_createHistogram();
+    itl::uint64_t allocCycles = 0;
+    itl::uint64_t freeCycles = 0;
+
+    for (itl::size_t round = 0; round < rounds; ++round) {
+        itl::uint64_t start = readCycles();
+
+        for (itl::size_t index = 0; index < CHURN_BATCH; ++index) {
+            pointers[index] = itl::alloc(size);
+            *(volatile char*)pointers[index] = 1;
+        }
+
+        itl::uint64_t middle = readCycles();
+
+        for (itl::size_t index = 0; index < CHURN_BATCH; ++index)
+            itl::free(pointers[index]);
+
+        allocCycles += middle - start;
+        freeCycles += readCycles() - middle;
+    }
+
+    for (itl::size_t round = 0; round < rounds; ++round) {
+        for (itl::size_t index = 0; index < CHURN_BATCH; ++index) {
+            itl::uint64_t start = readCycles();
+
+            pointers[index] = itl::alloc(size);
+            recordLatency(allocLatency, readCycles() - start);
+            *(volatile char*)pointers[index] = 1;
+        }
+
+        for (itl::size_t index = CHURN_BATCH; index-- > 0;) {
+            itl::uint64_t start = readCycles();
+
+            itl::free(pointers[index]);
+            recordLatency(freeLatency, readCycles() - start);
+        }
+    }
+
+    __internal_report("fixed-churn", "alloc", size, 1, rounds * CHURN_BATCH, cyclesToNanoseconds(allocCycles), allocLatency);
+    __internal_report("fixed-churn", "free", size, 1, rounds * CHURN_BATCH, cyclesToNanoseconds(freeCycles), freeLatency);
+
+    itl::free(pointers);
+    itl::freePages(allocLatency, sizeof(LatencyHistogram));
+    itl::freePages(freeLatency, sizeof(LatencyHistogram));
+}
+
+/**
+ * @brief Runs a random sequence of allocations, frees and reallocations
+ * over a fixed set of slots.
+ */
+static void __internal_randomMix(const Settings* settings)
+{
+    itl::size_t operations = 4000000 / settings->scale;
+    void** slots = (void**)itl::calloc(MIX_SLOTS, sizeof(void*));
+    LatencyHistogram* latency[3];
+    itl::uint64_t cycles[3] = { 0, 0, 0 };
+    itl::uint64_t counts[3] = { 0, 0, 0 };
+    itl::uint64_t state = 0x9e3779b97f4a7c15ULL;
+
+    for (itl::size_t index = 0; index < 3; ++index)
+        latency[index] = __internal_createHistogram();
+
+    for (itl::size_t operation = 0; operation < operations; ++operation) {
+        itl::uint64_t value = __internal_random(&state);
+        itl::size_t slot = value % MIX_SLOTS;
+        itl::size_t kind;
+        itl::uint64_t start = readCycles();
+
+        if (slots[slot] == nullptr) {
+            kind = 0;
+            slots[slot] = itl::alloc(__internal_randomSize(&state));
+        } else if ((value >> 32) % 4 == 0) {
+            kind = 2;
+            slots[slot] = itl::realloc(slots[slot], __internal_randomSize(&state));
+        } else {
+            kind = 1;
+            itl::free(slots[slot]);
+            slots[slot] = nullptr;
+        }
+
+        itl::uint64_t elapsed = readCycles() - start;
+
+        recordLatency(latency[kind], elapsed);
+        cycles[kind] += elapsed;
+        counts[kind]++;
+
+        if (slots[slot] != nullptr)
+            *(volatile char*)slots[slot] = 1;
+    }
+
+    for (itl::size_t slot = 0; slot < MIX_SLOTS; ++slot)
+        itl::free(slots[slot]);
+
+    __internal_report("random-mix", "alloc", 0, 1, counts[0], cyclesToNanoseconds(cycles[0]), latency[0]);
+    __internal_report("random-mix", "free", 0, 1, counts[1], cyclesToNanoseconds(cycles[1]), latency[1]);
+    __internal_report("random-mix", "realloc", 0, 1, counts[2], cyclesToNanoseconds(cycles[2]), latency[2]);
+
+    itl::free(slots);
+
+    for (itl::size_t index = 0; index < 3; ++index)
+        itl::freePages(latency[index], sizeof(LatencyHistogram));
+}
+
+/**
+ * @brief Grows buffers from a few bytes to REALLOC_LIMIT by half of their
+ * size at a time, through the in-place and mremap paths of realloc.
+ */
+static void __internal_reallocGrowth(const Settings* settings)
+{
+    itl::size_t rounds = 64 / settings->scale + 1;
+    LatencyHistogram* latency = __internal_createHistogram();
+    itl::uint64_t cycles = 0;
+    itl::uint64_t count = 0;
+
+    for (itl::size_t round = 0; round < rounds; ++round) {
+        itl::size_t size = 64;
+        char* buffer = (char*)itl::alloc(size);
+
+        while (size < REALLOC_LIMIT) {
+            size += size / 2;
+
+            itl::uint64_t start = readCycles();
+
+            buffer = (char*)itl::realloc(buffer, size);
+
+            itl::uint64_t elapsed = readCycles() - start;
+
+            recordLatency(latency, elapsed);
+            cycles += elapsed;
+            count++;
+            buffer[size - 1] = 1;
+        }
+
+        itl::free(buffer);
+    }
+
+    __internal_report("realloc-growth", "realloc", REALLOC_LIMIT, 1, count, cyclesToNanoseconds(cycles), latency);
+    itl::freePages(latency, sizeof(LatencyHistogram));
+}
+
+/**
+ * @brief Allocates objects and hands them to the consumer thread.
+ */
+static void __internal_producer(void* argument)
+{
+    Worker* worker = (Worker*)argument;
+    Ring* ring = worker->ring;
+    itl::uint64_t state = worker->seed;
+
+    while (*worker->start == 0)
+        __builtin_ia32_pause();
+
+    for (itl::size_t index = 0; index < worker->operations; ++index) {
+        itl::size_t size = 8 + __internal_random(&state) % 1017;
+        itl::uint64_t start = readCycles();
+        void* object = itl::alloc(size);
+
+        recordLatency(&worker->latency, readCycles() - start);
+        *(volatile char*)object = 1;
+
+        while (ring->head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) == RING_CAPACITY)
+            __builtin_ia32_pause();
+
+        ring->slots[ring->head % RING_CAPACITY] = object;
+        __atomic_store_n(&ring->head, ring->head + 1, __ATOMIC_RELEASE);
+    }
+}
+
+/**
+ * @brief Frees the objects received from the producer thread.
+ */
+static void __internal_consumer(void* argument)
+{
+    Worker* worker = (Worker*)argument;
+    Ring* ring = worker->ring;
+
+    while (*worker->start == 0)
+        __builtin_ia32_pause();
+
+    for (itl::size_t index = 0; index < worker->operations; ++index) {
+        while (__atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) == ring->tail)
+            __builtin_ia32_pause();
+
+        void* object = ring->slots[ring->tail % RING_CAPACITY];
+
+        __atomic_store_n(&ring->tail, ring->tail + 1, __ATOMIC_RELEASE);
+
+        itl::uint64_t start = readCycles();
+
+        itl::free(object);
+        recordLatency(&worker->latency, readCycles() - start);
+    }
+}
+
+/**
+ * @brief Runs pairs of threads where every object is allocated by one
+ * thread and freed by another.
+ */
+static void __internal_producerConsumer(const Settings* settings)
+{
+    itl::size_t pairs = settings->threads / 2 == 0 ? 1 : settings->threads / 2;
+    itl::size_t operations = 2000000 / settings->scale;
+    itl::size_t workersSize = 2 * pairs * sizeof(Worker);
+    itl::size_t ringsSize = pairs * sizeof(Ring);
+    Worker* workers = (Worker*)itl::allocPages(workersSize);
+    Ring* rings = (Ring*)itl::allocPages(ringsSize);
+    Thread* threads = (Thread*)itl::allocPages(2 * pairs * sizeof(Thread));
+    LatencyHistogram* allocLatency = __internal_createHistogram();
+    LatencyHistogram* freeLatency = __internal_createHistogram();
+    volatile int start = 0;
+    itl::size_t started = 0;
+
+    for (itl::size_t index = 0; index < 2 * pairs; ++index) {
+        workers[index].ring = &rings[index / 2];
+        workers[index].operations = operations;
+        workers[index].seed = 0x2545f4914f6cdd1dULL + index;
+        workers[index].start = &start;
+
+        if (createThread(&threads[index], index % 2 == 0 ? __internal_producer : __internal_consumer, &workers[index], 0) < 0)
+            break;
+
+        started++;
+    }
+
+    if (started == 2 * pairs) {
+        itl::uint64_t begin = monotonicNanoseconds();
+
+        start = 1;
+
+        for (itl::size_t index = 0; index < started; ++index)
+            joinThread(&threads[index]);
+
+        itl::uint64_t elapsed = monotonicNanoseconds() - begin;
+
+        for (itl::size_t index = 0; index < started; ++index)
+            mergeHistogram(index % 2 == 0 ? allocLatency : freeLatency, &workers[index].latency);
+
+        __internal_report("producer-consumer", "alloc", 0, 2 * pairs, pairs * operations, elapsed, allocLatency);
+        __internal_report("producer-consumer", "free", 0, 2 * pairs, pairs * operations, elapsed, freeLatency);
+    } else {
+        // The started threads wait for a peer that will never come.
+        writeAll(2, "producer-consumer: cannot start threads\n", 40);
+        exitProcess(1);
+    }
+
+    itl::freePages(workers, workersSize);
+    itl::freePages(rings, ringsSize);
+    itl::freePages(threads, 2 * pairs * sizeof(Thread));
+    itl::freePages(allocLatency, sizeof(LatencyHistogram));
+    itl::freePages(freeLatency, sizeof(LatencyHistogram));
+}
+
+/**
+ * @brief Parses a decimal number.
+ *
+ * @param text The text to parse, advanced past the number and the blanks
+ * that precede it.
+ * @return The parsed value.
+ */
+static itl::size_t __internal_parseNumber(const char** text)
+{
+    const char* cursor = *text;
+    itl::size_t value = 0;
+
+    while (*cursor == ' ' || *cursor == '\t')
+        ++cursor;
+
+    while (*cursor >= '0' && *cursor <= '9')
+        value = value * 10 + (itl::size_t)(*cursor++ - '0');
+
+    *text = cursor;
+
+    return value;
+}
+
+/**
+ * @brief Reads a trace file made of lines "a SLOT SIZE", "f SLOT" and
+ * "r SLOT SIZE". Lines starting with any other character are ignored.
+ *
+ * @param path The path of the trace file.
+ * @param count Receives the number of events.
+ * @return The events, allocated with itl::alloc, or nullptr on failure.
+ */
+static TraceEvent* __internal_readTrace(const char* path, itl::size_t* count)
+{
+    int fileDescriptor = itl::linux::syscall::openat(AT_FDCWD, path, O_RDONLY, 0);
+
+    if (fileDescriptor < 0)
+        return nullptr;
+
+    itl::size_t capacity = 1 << 16;
+    itl::size_t length = 0;
+    char* text = (char*)itl::alloc(capacity + 1);
+
+    while (true) {
+        if (length == capacity) {
+            capacity *= 2;
+            text = (char*)itl::realloc(text, capacity + 1);
+        }
+
+        itl::ssize_t received = itl::linux::syscall::read(fileDescriptor, text + length, capacity - length);
+
+        if (received <= 0)
+            break;
+
+        length += received;
+    }
+
+    itl::linux::syscall::close(fileDescriptor);
+    text[length] = '\0';
+
+    itl::size_t events = 0;
+    itl::size_t eventCapacity = 1024;
+    TraceEvent* trace = (TraceEvent*)itl::alloc(eventCapacity * sizeof(TraceEvent));
+
+    for (const char* line = text; *line != '\0';) {
+        char kind = *line++;
+
+        if (kind == 'a' || kind == 'f' || kind == 'r') {
+            if (events == eventCapacity) {
+                eventCapacity *= 2;
+                trace = (TraceEvent*)itl::realloc(trace, eventCapacity * sizeof(TraceEvent));
+            }
+
+            trace[events].operation = kind == 'a' ? TRACE_ALLOC : kind == 'f' ? TRACE_FREE : TRACE_REALLOC;
+            trace[events].slot = (itl::uint32_t)__internal_parseNumber(&line);
+            trace[events].size = kind == 'f' ? 0 : __internal_parseNumber(&line);
+            events++;
+        }
+
+        while (*line != '\0' && *line++ != '\n')
+            ;
+    }
+
+    itl::free(text);
+    *count = events;
+
+    return trace;
+}
+
+/**
+ * @brief Generates a trace mimicking a request-processing workload:
+ * short-lived buffers, strings built by appending, and a slowly renewed
+ * population of long-lived objects.
+ *
+ * @param length The number of events to generate.
+ * @return The events, allocated with itl::alloc.
+ */
+static TraceEvent* __internal_syntheticTrace(itl::size_t length)
+{
+    TraceEvent* trace = (TraceEvent*)itl::alloc(length * sizeof(TraceEvent));
+    itl::size_t* sizes = (itl::size_t*)itl::calloc(MIX_SLOTS, sizeof(itl::size_t));
+    itl::uint64_t state = 0x5851f42d4c957f2dULL;
+    itl::size_t events = 0;
+
+    while (events < length) {
+        itl::uint64_t value = __internal_random(&state);
+        itl::uint32_t slot = (itl::uint32_t)(value % MIX_SLOTS);
+        itl::size_t pattern = (value >> 32) % 10;
+
+        if (sizes[slot] == 0) {
+            sizes[slot] = pattern < 7 ? 16 + (value >> 40) % 240 : 1024 + (value >> 40) % 65536;
+            trace[events++] = (TraceEvent) { .operation = TRACE_ALLOC, .slot = slot, .size = sizes[slot] };
+        } else if (pattern < 3 && sizes[slot] < (1UL << 20)) {
+            sizes[slot] += sizes[slot] / 2 + 1;
+            trace[events++] = (TraceEvent) { .operation = TRACE_REALLOC, .slot = slot, .size = sizes[slot] };
+        } else {
+            sizes[slot] = 0;
+            trace[events++] = (TraceEvent) { .operation = TRACE_FREE, .slot = slot, .size = 0 };
+        }
+    }
+
+    itl::free(sizes);
+
+    return trace;
+}
+
+/**
+ * @brief Replays an allocation trace and reports one measurement per
+ * operation type.
+ */
+static void __internal_traceReplay(const Settings* settings)
+{
+    itl::size_t count = 0;
+    TraceEvent* trace = settings->trace != nullptr
+        ? __internal_readTrace(settings->trace, &count)
+        : (count = 2000000 / settings->scale, __internal_syntheticTrace(count));
+
+    if (trace == nullptr) {
+        writeAll(2, "trace: cannot read the trace file\n", 34);
+        return;
+    }
+
+    itl::size_t slotCount = MIX_SLOTS;
+
+    for (itl::size_t index = 0; index < count; ++index) {
+        if (trace[index].slot >= slotCount)
+            slotCount = trace[index].slot + 1;
+    }
+
+    void** slots = (void**)itl::calloc(slotCount, sizeof(void*));
+    LatencyHistogram* latency[3];
+    itl::uint64_t cycles[3] = { 0, 0, 0 };
+    itl::uint64_t counts[3] = { 0, 0, 0 };
+
+    for (itl::size_t index = 0; index < 3; ++index)
+        latency[index] = __internal_createHistogram();
+
+    for (itl::size_t index = 0; index < count; ++index) {
+        TraceEvent* event = &trace[index];
+        void** slot = &slots[event->slot];
+        itl::uint64_t start = readCycles();
+
+        switch (event->operation) {
+        case TRACE_ALLOC:
+            // A slot reused without a free in a truncated trace is leaked on purpose.
+            *slot = itl::alloc(event->size);
+            break;
+        case TRACE_FREE:
+            itl::free(*slot);
+            *slot = nullptr;
+            break;
+        case TRACE_REALLOC:
+            *slot = itl::realloc(*slot, event->size);
+            break;
+        }
+
+        itl::uint64_t elapsed = readCycles() - start;
+
+        recordLatency(latency[event->operation], elapsed);
+        cycles[event->operation] += elapsed;
+        counts[event->operation]++;
+    }
+
+    for (itl::size_t index = 0; index < slotCount; ++index)
+        itl::free(slots[index]);
+
+    const char* scenario = settings->trace != nullptr ? "trace-file" : "trace-synthetic";
+
+    __internal_report(scenario, "alloc", 0, 1, counts[TRACE_ALLOC], cyclesToNanoseconds(cycles[TRACE_ALLOC]), latency[TRACE_ALLOC]);
+    __internal_report(scenario, "free", 0, 1, counts[TRACE_FREE], cyclesToNanoseconds(cycles[TRACE_FREE]), latency[TRACE_FREE]);
+    __internal_report(scenario, "realloc", 0, 1, counts[TRACE_REALLOC], cyclesToNanoseconds(cycles[TRACE_REALLOC]), latency[TRACE_REALLOC]);
+
+    itl::free(slots);
+    itl::free(trace);
+
+    for (itl::size_t index = 0; index < 3; ++index)
+        itl::freePages(latency[index], sizeof(LatencyHistogram));
+}
+
+/**
+ * @brief Compares two null-terminated strings.
+ */
+static bool __internal_equals(const char* first, const char* second)
+{
+    while (*first != '\0' && *first == *second) {
+        ++first;
+        ++second;
+    }
+
+    return *first == *second;
+}
+
+namespace itl {
+namespace benchmark {
+    int benchmarkMain(int argumentCount, char** arguments)
+    {
+        Settings settings = {
+            .scale = 1,
+            .threads = 4,
+            .trace = nullptr
+        };
+
+        for (int index = 1; index < argumentCount; ++index) {
+            const char* argument = arguments[index];
+
+            if (__internal_equals(argument, "--quick")) {
+                settings.scale = 10;
+            } else if (__internal_equals(argument, "--threads") && index + 1 < argumentCount) {
+                const char* value = arguments[++index];
+
+                settings.threads = __internal_parseNumber(&value);
+
+                if (settings.threads < 2 || settings.threads > MAX_THREADS)
+                    settings.threads = 4;
+            } else if (__internal_equals(argument, "--trace") && index + 1 < argumentCount) {
+                settings.trace = arguments[++index];
+            } else {
+                writeAll(2, "usage: itl-bench [--quick] [--threads N] [--trace FILE]\n", 57);
+                return 2;
+            }
+        }
+
+        static const itl::size_t churnSizes[] = { 16, 64, 256, 1024, 4096, 65536, 524288, 4194304 };
+
+        for (itl::size_t index = 0; index < sizeof(churnSizes) / sizeof(churnSizes[0]); ++index)
+            __internal_fixedChurn(&settings, churnSizes[index]);
+
+        __internal_randomMix(&settings);
+        __internal_reallocGrowth(&settings);
+        __internal_producerConsumer(&settings);
+        __internal_traceReplay(&settings);
+
+        return 0;
+    }
+}; // namespace benchmark
+} // namespace itl
@@ -0,0 +1,197 @@
+/**
+ * @file benchmarks/runtime.cpp
+ * @brief Implements the freestanding runtime of the ITL benchmarks.
+ * @category Benchmarks
+ *
+ * This file contains the process entry point, timing and output helpers
+ * used by the benchmark programs.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#include "runtime.hpp"
+#include "system/auxv.hpp"
+#include "system/simd.hpp"
+#include "system/syscalls.hpp"
+#include "system/thread.hpp"
+#include "system/time.hpp"
+#include "typing/ctypes.hpp"
+
+#define CALIBRATION_NANOSECONDS 20000000 ///< Duration of the cycle calibration.
+
+extern "C" void __internal_start(long* stack) __attribute__((used, noreturn));
+
+__asm__(
+    ".section .text\n"
+    ".global _start\n"
+    "_start:\n"
+    "    xor %ebp, %ebp\n" // mark the outermost frame
+    "    mov %rsp, %rdi\n" // argument count, arguments, environment, auxiliary vector
+    "    and $-16, %rsp\n" // align the stack for the call
+    "    call __internal_start\n"
+    "    hlt\n");
+
+extern "C" void __internal_start(long* stack)
+{
+    int argumentCount = (int)stack[0];
+    char** arguments = (char**)(stack + 1);
+
+    itl::linux::auxv::initialize(arguments + argumentCount + 1);
+    itl::simd::initialize();
+
+    if (itl::thread::initialize() < 0)
+        itl::benchmark::exitProcess(127);
+
+    itl::time::initialize();
+    itl::time::calibrateCycles(CALIBRATION_NANOSECONDS);
+
+    itl::benchmark::exitProcess(itl::benchmark::benchmarkMain(argumentCount, arguments));
+}
+
+namespace itl {
+namespace benchmark {
+    void writeAll(int fileDescriptor, const char* buffer, itl::size_t size)
+    {
+        while (size > 0) {
+            itl::ssize_t written = itl::linux::syscall::write(fileDescriptor, buffer, size);
+
+            if (written <= 0)
+                return;
+
+            buffer += written;
+            size -= written;
+        }
+    }
+
+    void exitProcess(int status)
+    {
+        itl::linux::syscall::syscall1(SYS_EXIT_GROUP, status);
+        __builtin_unreachable();
+    }
+
+    void resetHistogram(LatencyHistogram* histogram)
+    {
+        for (itl::size_t index = 0; index < LATENCY_BUCKETS; ++index)
+            histogram->buckets[index] = 0;
+
+        histogram->count = 0;
+        histogram->maximum = 0;
+    }
+
+    void mergeHistogram(LatencyHistogram* destination, const LatencyHistogram* source)
+    {
+        for (itl::size_t index = 0; index < LATENCY_BUCKETS; ++index)
+            destination->buckets[index] += source->buckets[index];
+
+        destination->count += source->count;
+
+        if (source->maximum > destination->maximum)
+            destination->maximum = source->maximum;
+    }
+
+    itl::uint64_t percentile(const LatencyHistogram* histogram, unsigned perMille)
+    {
+        itl::uint64_t target = (histogram->count * perMille + 999) / 1000;
+        itl::uint64_t seen = 0;
+
+        if (target == 0)
+            return 0;
+
+        for (itl::size_t index = 0; index < LATENCY_BUCKETS; ++index) {
+            seen += histogram->buckets[index];
+
+            if (seen < target)
+                continue;
+
+            if (index < LATENCY_SUB_BUCKETS)
+                return index;
+
+            unsigned shift = index / LATENCY_SUB_BUCKETS - 1;
+            itl::uint64_t upper = (((itl::uint64_t)(LATENCY_SUB_BUCKETS + index % LATENCY_SUB_BUCKETS + 1)) << shift) - 1;
+
+            return upper < histogram->maximum ? upper : histogram->maximum;
+        }
+
+        return histogram->maximum;
+    }
+
+    /**
+     * @brief Appends raw bytes to the output, flushing it when full.
+     */
+    static void __internal_append(Output* output, const char* text, itl::size_t size)
+    {
+        for (itl::size_t index = 0; index < size; ++index) {
+            if (output->length == OUTPUT_BUFFER_SIZE)
+                flushOutput(output);
+
+            output->buffer[output->length++] = text[index];
+        }
+    }
+
+    /**
+     * @brief Appends a null-terminated string to the output.
+     */
+    static void __internal_appendString(Output* output, const char* text)
+    {
+        itl::size_t size = 0;
+
+        while (text[size] != '\0')
+            ++size;
+
+        __internal_append(output, text, size);
+    }
+
+    /**
+     * @brief Starts a field of the current record with its quoted name.
+     */
+    static void __internal_fieldName(Output* output, const char* name)
+    {
+        if (!output->firstField)
+            __internal_append(output, ",", 1);
+
+        output->firstField = false;
+        __internal_append(output, "\"", 1);
+        __internal_appendString(output, name);
+        __internal_append(output, "\":", 2);
+    }
+
+    void beginRecord(Output* output)
+    {
+        __internal_append(output, "{", 1);
+        output->firstField = true;
+    }
+
+    void stringField(Output* output, const char* name, const char* value)
+    {
+        __internal_fieldName(output, name);
+        __internal_append(output, "\"", 1);
+        __internal_appendString(output, value);
+        __internal_append(output, "\"", 1);
+    }
+
+    void numberField(Output* output, const char* name, itl::uint64_t value)
+    {
+        char digits[20];
+        itl::size_t position = sizeof(digits);
+
+        do {
+            digits[--position] = (char)('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+
+        __internal_fieldName(output, name);
+        __internal_append(output, digits + position, sizeof(digits) - position);
+    }
+
+    void endRecord(Output* output)
+    {
+        __internal_append(output, "}\n", 2);
+    }
+
+    void flushOutput(Output* output)
+    {
+        writeAll(1, output->buffer, output->length);
+        output->length = 0;
+    }
+}; // namespace benchmark
+} // namespace itl
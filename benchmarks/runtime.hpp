@@ -0,0 +1,179 @@
+/**
+ * @file benchmarks/runtime.hpp
+ * @brief Provides the freestanding runtime of the ITL benchmarks.
+ * @category Benchmarks
+ *
+ * The benchmarks link against the ITL alone, without any C library, so
+ * this header supplies the little they need from an operating system on
+ * top of the ITL system call wrappers: a process entry point, latency
+ * histograms and buffered output. Threads come from itl::thread, whose
+ * thread-local storage the entry point installs, and timing relies on
+ * itl::time, calibrated by the entry point.
+ *
+ * @note The runtime is only available on Linux systems on x86_64
+ * architecture.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#ifndef _ITL_BENCHMARKS_RUNTIME_HPP
+#define _ITL_BENCHMARKS_RUNTIME_HPP
+
+#include "typing/ctypes.hpp"
+
+#ifndef __x86_64__
+#error "The ITL benchmarks require Linux on x86_64."
+#endif
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace benchmark {
+#define LATENCY_SUB_BUCKETS 16 ///< Linear buckets per power of two of a latency histogram.
+#define LATENCY_BUCKETS (64 * LATENCY_SUB_BUCKETS) ///< Buckets of a latency histogram.
+#define OUTPUT_BUFFER_SIZE 16384 ///< Bytes buffered before the output is written.
+
+    /**
+     * @brief Writes a whole buffer to a file descriptor.
+     *
+     * @param fileDescriptor The file descriptor to write to.
+     * @param buffer The bytes to write.
+     * @param size The number of bytes to write.
+     */
+    void writeAll(int fileDescriptor, const char* buffer, itl::size_t size);
+
+    /**
+     * @brief Terminates the process.
+     *
+     * @param status The exit status.
+     */
+    [[noreturn]] void exitProcess(int status);
+
+    /**
+     * @struct LatencyHistogram
+     * @brief Log-linear histogram of latencies, in cycles.
+     *
+     * Each power of two is split in LATENCY_SUB_BUCKETS linear buckets, so
+     * every recorded value is reported with less than 7% error while the
+     * histogram keeps a fixed size and records in constant time.
+     */
+    typedef struct {
+        itl::uint64_t buckets[LATENCY_BUCKETS]; ///< Number of samples per bucket.
+        itl::uint64_t count; ///< Number of samples.
+        itl::uint64_t maximum; ///< Largest sample.
+    } LatencyHistogram;
+
+    /**
+     * @brief Empties a histogram.
+     *
+     * @param histogram The histogram to reset.
+     */
+    void resetHistogram(LatencyHistogram* histogram);
+
+    /**
+     * @brief Records one latency sample.
+     *
+     * @param histogram The histogram to update.
+     * @param cycles The latency, in cycles.
+     */
+    inline void recordLatency(LatencyHistogram* histogram, itl::uint64_t cycles)
+    {
+        itl::size_t index;
+
+        if (cycles < LATENCY_SUB_BUCKETS) {
+            index = cycles;
+        } else {
+            unsigned exponent = 63 - __builtin_clzll(cycles);
+            unsigned shift = exponent - 4;
+
+            index = (exponent - 3) * LATENCY_SUB_BUCKETS + ((cycles >> shift) & (LATENCY_SUB_BUCKETS - 1));
+        }
+
+        histogram->buckets[index]++;
+        histogram->count++;
+
+        if (cycles > histogram->maximum)
+            histogram->maximum = cycles;
+    }
+
+    /**
+     * @brief Adds the samples of a histogram to another one.
+     *
+     * @param destination The histogram receiving the samples.
+     * @param source The histogram whose samples are added.
+     */
+    void mergeHistogram(LatencyHistogram* destination, const LatencyHistogram* source);
+
+    /**
+     * @brief Computes a percentile of a histogram.
+     *
+     * @param histogram The histogram to read.
+     * @param perMille The percentile, in thousandths (500 for the median).
+     * @return The upper bound of the bucket holding the percentile, in cycles.
+     */
+    itl::uint64_t percentile(const LatencyHistogram* histogram, unsigned perMille);
+
+    /**
+     * @struct Output
+     * @brief Buffered writer of JSON lines to the standard output.
+     */
+    typedef struct {
+        char buffer[OUTPUT_BUFFER_SIZE]; ///< Pending bytes.
+        itl::size_t length; ///< Number of pending bytes.
+        bool firstField; ///< Whether the current record has no field yet.
+    } Output;
+
+    /**
+     * @brief Starts a JSON record.
+     *
+     * @param output The output to write to.
+     */
+    void beginRecord(Output* output);
+
+    /**
+     * @brief Adds a string field to the current record.
+     *
+     * @param output The output to write to.
+     * @param name The name of the field.
+     * @param value The value of the field, without characters to escape.
+     */
+    void stringField(Output* output, const char* name, const char* value);
+
+    /**
+     * @brief Adds an integer field to the current record.
+     *
+     * @param output The output to write to.
+     * @param name The name of the field.
+     * @param value The value of the field.
+     */
+    void numberField(Output* output, const char* name, itl::uint64_t value);
+
+    /**
+     * @brief Ends the current record with a newline.
+     *
+     * @param output The output to write to.
+     */
+    void endRecord(Output* output);
+
+    /**
+     * @brief Writes the pending bytes to the standard output.
+     *
+     * @param output The output to flush.
+     */
+    void flushOutput(Output* output);
+
+    /**
+     * @brief Entry point of a benchmark program, called by the runtime.
+     *
+     * @param argumentCount The number of command-line arguments.
+     * @param arguments The command-line arguments.
+     * @return The exit status of the process.
+     */
+    int benchmarkMain(int argumentCount, char** arguments);
+}; // namespace benchmark
+} // namespace itl
+
+#endif // _ITL_BENCHMARKS_RUNTIME_HPP
@@ -0,0 +1,916 @@
+/**
+ * @file include/containers/map.hpp
+ * @brief Provides open-addressing hash maps for the ITL library.
+ * @category Containers
+ *
+ * This header defines a flat unordered map in the style of SwissTable.
+ * Entries live directly in one array next to an array of control bytes,
+ * one per slot, holding seven bits of the hash of the key or a marker for
+ * empty and deleted slots. A lookup compares a whole group of control
+ * bytes at once with SSE2 or AVX2, so it usually reads one line of control
+ * bytes and the one entry that matches, and inserting never allocates a
+ * node. Keys can be looked up with any type the hasher and the equality
+ * accept, and storage comes from the ITL allocator or from an arena.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#ifndef _ITL_CONTAINERS_MAP_HPP
+#define _ITL_CONTAINERS_MAP_HPP
+
+#include "memory/allocator.hpp"
+#include "memory/arena.hpp"
+#include "memory/placement.hpp"
+#include "system/simd.hpp"
+#include "system/sync.hpp"
+#include "typing/ctypes.hpp"
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace map {
+#if defined(__AVX2__)
+#define MAP_GROUP_WIDTH 32 ///< Control bytes compared at once, with AVX2.
+#elif defined(__SSE2__)
+#define MAP_GROUP_WIDTH 16 ///< Control bytes compared at once, with SSE2.
+#else
+#define MAP_GROUP_WIDTH 8 ///< Control bytes compared at once, in a 64-bit word.
+#endif // #if defined(__AVX2__)
+
+#define MAP_CONTROL_EMPTY ((signed char)-128) ///< The slot has never held an entry since the last rehash.
+#define MAP_CONTROL_DELETED ((signed char)-2) ///< The slot held an entry that was erased.
+#define MAP_CONTROL_SENTINEL ((signed char)-1) ///< Pads the control bytes of tables smaller than a group.
+#define MAP_MIN_CAPACITY 4 ///< Smallest number of slots of a table.
+
+    /**
+     * @class GroupMask
+     * @brief The slots of a group that matched a test, as a bit mask.
+     *
+     * With SSE2 and AVX2 each slot is one bit; in the portable group each
+     * slot is the top bit of its byte.
+     */
+    class GroupMask {
+    public:
+#if defined(__SSE2__)
+        typedef itl::uint32_t Word; ///< Mask of a vector group.
+        static constexpr unsigned SHIFT = 0; ///< log2 of the bits per slot.
+#else
+        typedef itl::uint64_t Word; ///< Mask of a portable group.
+        static constexpr unsigned SHIFT = 3; ///< log2 of the bits per slot.
+#endif // #if defined(__SSE2__)
+
+        explicit GroupMask(Word value)
+            : bits(value)
+        {
+        }
+
+        /**
+         * @brief Reports whether any slot matched.
+         */
+        bool any() const { return bits != 0; }
+
+        /**
+         * @brief Returns the first slot that matched. The mask must not be
+         * empty.
+         */
+        unsigned lowest() const
+        {
+#if defined(__SSE2__)
+            return __builtin_ctz(bits);
+#else
+            itl::uint32_t low = (itl::uint32_t)bits;
+
+            // Without SSE2 this is x86, which counts 64-bit words in halves.
+            return (low != 0 ? __builtin_ctz(low) : 32 + __builtin_ctz((itl::uint32_t)(bits >> 32))) >> SHIFT;
+#endif // #if defined(__SSE2__)
+        }
+
+        /**
+         * @brief Forgets the first slot that matched.
+         */
+        void clearLowest() { bits &= bits - 1; }
+
+        /**
+         * @brief Counts the slots before the first one that matched.
+         */
+        unsigned trailingZeros() const { return bits == 0 ? MAP_GROUP_WIDTH : lowest(); }
+
+        /**
+         * @brief Counts the slots after the last one that matched.
+         */
+        unsigned leadingZeros() const
+        {
+            if (bits == 0)
+                return MAP_GROUP_WIDTH;
+
+#if defined(__SSE2__)
+            return __builtin_clz(bits) - (32 - MAP_GROUP_WIDTH);
+#else
+            itl::uint32_t high = (itl::uint32_t)(bits >> 32);
+
+            return (high != 0 ? __builtin_clz(high) : 32 + __builtin_clz((itl::uint32_t)bits)) >> SHIFT;
+#endif // #if defined(__SSE2__)
+        }
+
+    private:
+        Word bits; ///< One bit, or one byte, per slot of the group.
+    };
+
+    /**
+     * @class Group
+     * @brief MAP_GROUP_WIDTH consecutive control bytes, loaded together.
+     *
+     * Full slots store the seven low bits of the hash of their key, so
+     * their control byte is never negative, while the markers all have the
+     * top bit set.
+     */
+    class Group {
+    public:
+#if defined(__AVX2__)
+        typedef char Vector __attribute__((vector_size(32), aligned(1), may_alias)); ///< Unaligned control bytes.
+#elif defined(__SSE2__)
+        typedef char Vector __attribute__((vector_size(16), aligned(1), may_alias)); ///< Unaligned control bytes.
+#else
+        typedef itl::uint64_t Vector __attribute__((aligned(1), may_alias)); ///< Unaligned control bytes.
+#endif // #if defined(__AVX2__)
+
+        explicit Group(const signed char* control)
+            : bytes(*(const Vector*)control)
+        {
+        }
+
+        /**
+         * @brief Returns the slots whose control byte is a given hash
+         * fragment.
+         *
+         * The portable version may report a false match next to a real
+         * one, which the comparison of the keys filters out.
+         */
+        itl::map::GroupMask match(itl::uint8_t fragment) const
+        {
+#if defined(__SSE2__)
+            return GroupMask(moveMask(bytes == (char)fragment));
+#else
+            itl::uint64_t value = bytes ^ (LOW_BITS * fragment);
+
+            return GroupMask((value - LOW_BITS) & ~value & HIGH_BITS);
+#endif // #if defined(__SSE2__)
+        }
+
+        /**
+         * @brief Returns the empty slots.
+         */
+        itl::map::GroupMask matchEmpty() const
+        {
+#if defined(__SSE2__)
+            return GroupMask(moveMask(bytes == (char)MAP_CONTROL_EMPTY));
+#else
+            return GroupMask(bytes & ~(bytes << 6) & HIGH_BITS);
+#endif // #if defined(__SSE2__)
+        }
+
+        /**
+         * @brief Returns the empty and deleted slots.
+         */
+        itl::map::GroupMask matchEmptyOrDeleted() const
+        {
+#if defined(__SSE2__)
+            return GroupMask(moveMask(bytes < (char)MAP_CONTROL_SENTINEL));
+#else
+            return GroupMask(bytes & ~(bytes << 7) & HIGH_BITS);
+#endif // #if defined(__SSE2__)
+        }
+
+    private:
+#if defined(__SSE2__)
+        /**
+         * @brief Gathers the top bit of every byte of a comparison.
+         */
+        template <typename Comparison>
+        static GroupMask::Word moveMask(Comparison comparison)
+        {
+#if defined(__AVX2__)
+            typedef char Bytes __attribute__((vector_size(32)));
+
+            return (GroupMask::Word)__builtin_ia32_pmovmskb256((Bytes)comparison);
+#else
+            typedef char Bytes __attribute__((vector_size(16)));
+
+            return (GroupMask::Word)__builtin_ia32_pmovmskb128((Bytes)comparison);
+#endif // #if defined(__AVX2__)
+        }
+#else
+        static constexpr itl::uint64_t LOW_BITS = 0x0101010101010101ULL; ///< The lowest bit of every byte.
+        static constexpr itl::uint64_t HIGH_BITS = 0x8080808080808080ULL; ///< The highest bit of every byte.
+#endif // #if defined(__SSE2__)
+
+        Vector bytes; ///< The control bytes of the group.
+    };
+
+    /**
+     * @brief Finalizes a 64-bit hash so that every input bit affects every
+     * output bit.
+     */
+    inline itl::uint64_t mixHash(itl::uint64_t value)
+    {
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdULL;
+        value ^= value >> 33;
+        value *= 0xc4ceb9fe1a85ec53ULL;
+        value ^= value >> 33;
+
+        return value;
+    }
+
+    /**
+     * @brief Hashes a sequence of bytes.
+     *
+     * @param data The bytes to hash.
+     * @param length The number of bytes.
+     * @return The hash of the bytes.
+     */
+    inline itl::size_t hashBytes(const void* data, itl::size_t length)
+    {
+        typedef itl::uint64_t Word __attribute__((aligned(1), may_alias));
+
+        const unsigned char* bytes = (const unsigned char*)data;
+        itl::uint64_t hash = 0x9e3779b97f4a7c15ULL ^ length;
+
+        for (; length >= 8; bytes += 8, length -= 8)
+            hash = (hash ^ mixHash(*(const Word*)bytes)) * 0x9fb21c651e98df25ULL;
+
+        itl::uint64_t tail = 0;
+
+        for (itl::size_t index = 0; index < length; ++index)
+            tail |= (itl::uint64_t)bytes[index] << (index * 8);
+
+        return (itl::size_t)mixHash(hash ^ tail);
+    }
+
+    /**
+     * @brief Hashes an integer key.
+     */
+    template <typename T>
+    struct IntegerHash {
+        itl::size_t operator()(T key) const { return (itl::size_t)mixHash((itl::uint64_t)key); }
+    };
+
+    /**
+     * @brief Hashes keys of type T. Specialize it, or pass another hasher
+     * to HashMap, for other key types.
+     */
+    template <typename T>
+    struct Hash;
+
+    template <> struct Hash<char> : IntegerHash<char> { };
+    template <> struct Hash<signed char> : IntegerHash<signed char> { };
+    template <> struct Hash<unsigned char> : IntegerHash<unsigned char> { };
+    template <> struct Hash<short> : IntegerHash<short> { };
+    template <> struct Hash<unsigned short> : IntegerHash<unsigned short> { };
+    template <> struct Hash<int> : IntegerHash<int> { };
+    template <> struct Hash<unsigned int> : IntegerHash<unsigned int> { };
+    template <> struct Hash<long> : IntegerHash<long> { };
+    template <> struct Hash<unsigned long> : IntegerHash<unsigned long> { };
+    template <> struct Hash<long long> : IntegerHash<long long> { };
+    template <> struct Hash<unsigned long long> : IntegerHash<unsigned long long> { };
+
+    /**
+     * @brief Hashes pointers by address.
+     */
+    template <typename T>
+    struct Hash<T*> {
+        itl::size_t operator()(const T* key) const { return (itl::size_t)mixHash((itl::uintptr_t)key); }
+    };
+
+    /**
+     * @brief Compares keys of any two types with ==.
+     */
+    struct Equal {
+        template <typename A, typename B>
+        bool operator()(const A& first, const B& second) const { return first == second; }
+    };
+
+    /**
+     * @struct StringKey
+     * @brief A string key that does not own its characters, which usually
+     * live in an arena next to the map.
+     */
+    typedef struct {
+        const char* data; ///< The characters, not necessarily terminated.
+        itl::size_t length; ///< The number of characters.
+    } StringKey;
+
+    /**
+     * @brief Returns the length of a null-terminated string.
+     */
+    inline itl::size_t stringLength(const char* string)
+    {
+        return itl::simd::stringLength(string);
+    }
+
+    /**
+     * @brief Hashes StringKey keys, and null-terminated strings the same
+     * way, so a map keyed by StringKey can be searched with a literal.
+     */
+    struct StringHash {
+        itl::size_t operator()(const itl::map::StringKey& key) const { return hashBytes(key.data, key.length); }
+        itl::size_t operator()(const char* key) const { return hashBytes(key, stringLength(key)); }
+    };
+
+    /**
+     * @brief Compares StringKey keys with each other and with
+     * null-terminated strings.
+     */
+    struct StringEqual {
+        bool operator()(const itl::map::StringKey& first, const itl::map::StringKey& second) const
+        {
+            return first.length == second.length && itl::simd::compare(first.data, second.data, first.length) == 0;
+        }
+
+        bool operator()(const itl::map::StringKey& first, const char* second) const
+        {
+            return stringLength(second) == first.length && itl::simd::compare(first.data, second, first.length) == 0;
+        }
+    };
+
+    /**
+     * @struct Entry
+     * @brief A key and its value, as stored in a slot.
+     */
+    template <typename K, typename V>
+    struct Entry {
+        K key; ///< The key, which must not be modified in place.
+        V value; ///< The value.
+    };
+
+    /**
+     * @class HashMap
+     * @brief An unordered map from K to V with open addressing.
+     *
+     * A table of capacity slots, a power of two, is a single allocation:
+     * capacity + MAP_GROUP_WIDTH control bytes followed by the entries.
+     * The hash of a key is split in H1, which picks the group where the
+     * probe starts, and H2, its seven low bits, which is stored in the
+     * control byte. Probing visits groups with growing strides, which
+     * reaches every group once. The first MAP_GROUP_WIDTH - 1 control bytes
+     * are copied after the last one, so a group starting near the end of
+     * the table reads across the wrap without a branch.
+     *
+     * Tables smaller than a group always probe the single group at slot 0,
+     * padded with sentinels, and grow when one slot is left; larger tables
+     * grow at 7/8 full. Either way a probe always meets an empty slot.
+     *
+     * Pointers to entries stay valid until the next insertion that grows
+     * the table, or until the entry is erased.
+     *
+     * @tparam K The type of the keys.
+     * @tparam V The type of the values.
+     * @tparam H The hasher. Lookups accept any type it can hash.
+     * @tparam E The equality of keys. Lookups accept any type it can
+     * compare with K.
+     */
+    template <typename K, typename V, typename H = itl::map::Hash<K>, typename E = itl::map::Equal>
+    class HashMap {
+    public:
+        typedef itl::map::Entry<K, V> EntryType; ///< The entries of the map.
+
+        /**
+         * @class Iterator
+         * @brief Walks over the entries of a map in slot order.
+         */
+        class Iterator {
+        public:
+            Iterator(const HashMap* owner, itl::size_t slot)
+                : map(owner)
+                , index(slot)
+            {
+                skipFree();
+            }
+
+            EntryType& operator*() const { return map->slots[index]; }
+            EntryType* operator->() const { return &map->slots[index]; }
+
+            Iterator& operator++()
+            {
+                ++index;
+                skipFree();
+
+                return *this;
+            }
+
+            bool operator!=(const Iterator& other) const { return index != other.index; }
+
+        private:
+            /**
+             * @brief Moves to the next full slot, or to the end.
+             */
+            void skipFree()
+            {
+                while (index < map->slotCount && map->control[index] < 0)
+                    ++index;
+            }
+
+            const HashMap* map; ///< The map being walked.
+            itl::size_t index; ///< The current slot.
+        };
+
+        /**
+         * @brief Creates an empty map whose tables come from the ITL
+         * allocator. Nothing is allocated until the first insertion.
+         */
+        HashMap()
+            : control(nullptr)
+            , slots(nullptr)
+            , slotCount(0)
+            , entryCount(0)
+            , growthLeft(0)
+            , arena(nullptr)
+        {
+        }
+
+        /**
+         * @brief Creates an empty map whose tables come from an arena.
+         *
+         * Tables replaced by a rehash are left to the arena.
+         *
+         * @param storage The arena, which must outlive the map.
+         */
+        explicit HashMap(itl::arena::Arena* storage)
+            : HashMap()
+        {
+            arena = storage;
+        }
+
+        /**
+         * @brief Destroys every entry and releases the table.
+         */
+        ~HashMap()
+        {
+            destroyEntries();
+            releaseTable(control);
+        }
+
+        HashMap(const HashMap&) = delete;
+        HashMap& operator=(const HashMap&) = delete;
+
+        /**
+         * @brief Finds the value of a key.
+         *
+         * @param key The key, of any type the hasher and equality accept.
+         * @return The value, or nullptr if the key is absent.
+         */
+        template <typename Q>
+        V* find(const Q& key) const
+        {
+            EntryType* entry = findEntry(key, hasher(key));
+
+            return entry == nullptr ? nullptr : &entry->value;
+        }
+
+        /**
+         * @brief Reports whether a key is present.
+         */
+        template <typename Q>
+        bool contains(const Q& key) const { return findEntry(key, hasher(key)) != nullptr; }
+
+        /**
+         * @brief Inserts a key with a value constructed in place, unless the
+         * key is already present.
+         *
+         * The key and the arguments may refer to entries of the map itself.
+         *
+         * @param key The key.
+         * @param arguments The arguments forwarded to the constructor of V.
+         * @return The value of the key, new or existing, or nullptr if the
+         * table could not grow.
+         */
+        template <typename... Arguments>
+        V* emplace(const K& key, Arguments&&... arguments)
+        {
+            itl::size_t hash = hasher(key);
+            EntryType* entry = findEntry(key, hash);
+
+            if (entry != nullptr)
+                return &entry->value;
+
+            if (__builtin_expect(growthLeft == 0, 0))
+                return growAndEmplace(hash, key, static_cast<Arguments&&>(arguments)...);
+
+            entry = prepareInsert(hash);
+
+            if (entry == nullptr)
+                return nullptr;
+
+            new (&entry->key) K(key);
+            new (&entry->value) V(static_cast<Arguments&&>(arguments)...);
+
+            return &entry->value;
+        }
+
+        /**
+         * @brief Inserts a copy of a value unless the key is already
+         * present. The value may be one of the map itself.
+         *
+         * @return The value of the key, new or existing, or nullptr if the
+         * table could not grow.
+         */
+        V* insert(const K& key, const V& value) { return emplace(key, value); }
+
+        /**
+         * @brief Inserts a key or replaces its value.
+         *
+         * @return The value of the key, or nullptr if the table could not
+         * grow.
+         */
+        V* assign(const K& key, const V& value)
+        {
+            itl::size_t hash = hasher(key);
+            EntryType* entry = findEntry(key, hash);
+
+            if (entry != nullptr) {
+                entry->value = value;
+                return &entry->value;
+            }
+
+            if (__builtin_expect(growthLeft == 0, 0))
+                return growAndEmplace(hash, key, value);
+
+            entry = prepareInsert(hash);
+
+            if (entry == nullptr)
+                return nullptr;
+
+            new (&entry->key) K(key);
+            new (&entry->value) V(value);
+
+            return &entry->value;
+        }
+
+        /**
+         * @brief Removes a key and destroys its entry.
+         *
+         * @return false if the key was absent.
+         */
+        template <typename Q>
+        bool erase(const Q& key)
+        {
+            EntryType* entry = findEntry(key, hasher(key));
+
+            if (entry == nullptr)
+                return false;
+
+            itl::size_t index = entry - slots;
+
+            entry->key.~K();
+            entry->value.~V();
+            --entryCount;
+
+            // A slot can be emptied outright when no probe ever went past it,
+            // that is when every group holding it also holds an empty slot.
+            if (slotCount >= MAP_GROUP_WIDTH) {
+                GroupMask before = Group(control + ((index - MAP_GROUP_WIDTH) & (slotCount - 1))).matchEmpty();
+                GroupMask after = Group(control + index).matchEmpty();
+
+                if (before.leadingZeros() + after.trailingZeros() >= MAP_GROUP_WIDTH) {
+                    setControl(index, MAP_CONTROL_DELETED);
+                    return true;
+                }
+            }
+
+            setControl(index, MAP_CONTROL_EMPTY);
+            ++growthLeft;
+
+            return true;
+        }
+
+        /**
+         * @brief Destroys every entry but keeps the table.
+         */
+        void clear()
+        {
+            if (control == nullptr)
+                return;
+
+            destroyEntries();
+            resetControl(control, slotCount);
+            entryCount = 0;
+            growthLeft = maxLoad(slotCount);
+        }
+
+        /**
+         * @brief Grows the table so that count entries fit without another
+         * rehash.
+         *
+         * @return false if the table could not be allocated.
+         */
+        bool reserve(itl::size_t count)
+        {
+            if (count <= entryCount + growthLeft)
+                return true;
+
+            return resize(capacityFor(count));
+        }
+
+        /**
+         * @brief Rebuilds the table with room for at least count entries,
+         * and never fewer than the current ones, dropping every deleted
+         * marker. rehash(0) shrinks the table to fit.
+         *
+         * @return false if the table could not be allocated.
+         */
+        bool rehash(itl::size_t count)
+        {
+            if (count < entryCount)
+                count = entryCount;
+
+            if (count == 0) {
+                releaseTable(control);
+                control = nullptr;
+                slots = nullptr;
+                slotCount = 0;
+                growthLeft = 0;
+
+                return true;
+            }
+
+            return resize(capacityFor(count));
+        }
+
+        /**
+         * @brief Returns the number of entries.
+         */
+        itl::size_t size() const { return entryCount; }
+
+        /**
+         * @brief Reports whether the map has no entries.
+         */
+        bool isEmpty() const { return entryCount == 0; }
+
+        /**
+         * @brief Returns the number of slots of the table.
+         */
+        itl::size_t capacity() const { return slotCount; }
+
+        Iterator begin() const { return Iterator(this, 0); }
+        Iterator end() const { return Iterator(this, slotCount); }
+
+    private:
+        /**
+         * @brief Returns the number of entries a table holds before it grows.
+         */
+        static constexpr itl::size_t maxLoad(itl::size_t capacity)
+        {
+            return capacity < MAP_GROUP_WIDTH ? capacity - 1 : capacity - capacity / 8;
+        }
+
+        /**
+         * @brief Returns the smallest capacity holding count entries.
+         */
+        static itl::size_t capacityFor(itl::size_t count)
+        {
+            itl::size_t capacity = MAP_MIN_CAPACITY;
+
+            while (maxLoad(capacity) < count)
+                capacity <<= 1;
+
+            return capacity;
+        }
+
+        /**
+         * @brief Returns the size of the control bytes of a table, rounded
+         * so the entries that follow them are aligned.
+         */
+        static constexpr itl::size_t controlSize(itl::size_t capacity)
+        {
+            return (capacity + MAP_GROUP_WIDTH + alignof(EntryType) - 1) & ~(alignof(EntryType) - 1);
+        }
+
+        /**
+         * @brief Marks every slot of a table empty and pads it.
+         */
+        static void resetControl(signed char* bytes, itl::size_t capacity)
+        {
+            signed char padding = capacity < MAP_GROUP_WIDTH ? MAP_CONTROL_SENTINEL : MAP_CONTROL_EMPTY;
+
+            for (itl::size_t index = 0; index < capacity; ++index)
+                bytes[index] = MAP_CONTROL_EMPTY;
+
+            for (itl::size_t index = capacity; index < capacity + MAP_GROUP_WIDTH; ++index)
+                bytes[index] = padding;
+        }
+
+        /**
+         * @brief Sets the control byte of a slot and its copy past the end.
+         */
+        void setControl(itl::size_t index, signed char value)
+        {
+            control[index] = value;
+
+            if (slotCount >= MAP_GROUP_WIDTH && index < MAP_GROUP_WIDTH - 1)
+                control[slotCount + index] = value;
+        }
+
+        /**
+         * @brief Returns the group where the probe for a hash starts.
+         */
+        itl::size_t probeStart(itl::size_t hash) const
+        {
+            return slotCount < MAP_GROUP_WIDTH ? 0 : (hash >> 7) & (slotCount - 1);
+        }
+
+        /**
+         * @brief Finds the entry of a key.
+         */
+        template <typename Q>
+        EntryType* findEntry(const Q& key, itl::size_t hash) const
+        {
+            if (control == nullptr)
+                return nullptr;
+
+            itl::size_t mask = slotCount - 1;
+            itl::size_t offset = probeStart(hash);
+
+            for (itl::size_t stride = 0; stride < slotCount;) {
+                Group group(control + offset);
+
+                for (GroupMask candidates = group.match(hash & 0x7f); candidates.any(); candidates.clearLowest()) {
+                    EntryType* entry = &slots[(offset + candidates.lowest()) & mask];
+
+                    if (equal(entry->key, key))
+                        return entry;
+                }
+
+                if (group.matchEmpty().any())
+                    return nullptr;
+
+                stride += MAP_GROUP_WIDTH;
+                offset = (offset + stride) & mask;
+            }
+
+            return nullptr;
+        }
+
+        /**
+         * @brief Finds the first empty or deleted slot on the probe of a
+         * hash. The table must have one.
+         */
+        itl::size_t findFreeSlot(itl::size_t hash) const
+        {
+            itl::size_t mask = slotCount - 1;
+            itl::size_t offset = probeStart(hash);
+
+            for (itl::size_t stride = 0;; stride += MAP_GROUP_WIDTH, offset = (offset + stride) & mask) {
+                GroupMask free = Group(control + offset).matchEmptyOrDeleted();
+
+                if (free.any())
+                    return (offset + free.lowest()) & mask;
+            }
+        }
+
+        /**
+         * @brief Claims a slot for a new key, growing the table when it is
+         * out of room.
+         *
+         * @return The uninitialized entry, or nullptr on failure.
+         */
+        EntryType* prepareInsert(itl::size_t hash)
+        {
+            if (control == nullptr && !resize(MAP_MIN_CAPACITY))
+                return nullptr;
+
+            itl::size_t index = findFreeSlot(hash);
+
+            if (growthLeft == 0 && control[index] != MAP_CONTROL_DELETED) {
+                // Deleted markers alone may have used up the room, in which
+                // case rebuilding at the same size is enough.
+                itl::size_t capacity = entryCount <= maxLoad(slotCount) * 25 / 32 ? slotCount : slotCount * 2;
+
+                if (!resize(capacity))
+                    return nullptr;
+
+                index = findFreeSlot(hash);
+            }
+
+            if (control[index] == MAP_CONTROL_EMPTY)
+                --growthLeft;
+
+            setControl(index, (signed char)(hash & 0x7f));
+            ++entryCount;
+
+            return &slots[index];
+        }
+
+        /**
+         * @brief Inserts a new key when the table may have to grow first.
+         *
+         * The entry is built aside first, since the key and the arguments
+         * may refer to entries that a rehash moves or frees, and moved into
+         * its slot after.
+         *
+         * @return The value of the key, or nullptr on failure.
+         */
+        template <typename... Arguments>
+        V* growAndEmplace(itl::size_t hash, const K& key, Arguments&&... arguments)
+        {
+            alignas(EntryType) unsigned char pending[sizeof(EntryType)];
+            EntryType* aside = (EntryType*)pending;
+
+            new (&aside->key) K(key);
+            new (&aside->value) V(static_cast<Arguments&&>(arguments)...);
+
+            EntryType* entry = prepareInsert(hash);
+
+            if (entry != nullptr) {
+                new (&entry->key) K(static_cast<K&&>(aside->key));
+                new (&entry->value) V(static_cast<V&&>(aside->value));
+            }
+
+            aside->key.~K();
+            aside->value.~V();
+
+            return entry == nullptr ? nullptr : &entry->value;
+        }
+
+        /**
+         * @brief Moves every entry to a new table of the given capacity.
+         *
+         * @return false if the table could not be allocated, in which case
+         * the map is unchanged.
+         */
+        bool resize(itl::size_t capacity)
+        {
+            itl::size_t alignment = alignof(EntryType) > CACHE_LINE_SIZE ? alignof(EntryType) : CACHE_LINE_SIZE;
+            itl::size_t bytes = controlSize(capacity) + capacity * sizeof(EntryType);
+            signed char* newControl = (signed char*)(arena == nullptr ? itl::allocAligned(bytes, alignment)
+                                                                      : itl::arena::alloc(arena, bytes, alignment));
+
+            if (newControl == nullptr)
+                return false;
+
+            signed char* oldControl = control;
+            EntryType* oldSlots = slots;
+            itl::size_t oldCount = slotCount;
+
+            resetControl(newControl, capacity);
+            control = newControl;
+            slots = (EntryType*)(newControl + controlSize(capacity));
+            slotCount = capacity;
+            growthLeft = maxLoad(capacity) - entryCount;
+
+            for (itl::size_t index = 0; index < oldCount; ++index) {
+                if (oldControl[index] < 0)
+                    continue;
+
+                EntryType* source = &oldSlots[index];
+                itl::size_t target = findFreeSlot(hasher(source->key));
+
+                setControl(target, oldControl[index]);
+                new (&slots[target].key) K(static_cast<K&&>(source->key));
+                new (&slots[target].value) V(static_cast<V&&>(source->value));
+                source->key.~K();
+                source->value.~V();
+            }
+
+            releaseTable(oldControl);
+
+            return true;
+        }
+
+        /**
+         * @brief Destroys the entries of every full slot.
+         */
+        void destroyEntries()
+        {
+            for (itl::size_t index = 0; index < slotCount; ++index) {
+                if (control[index] >= 0) {
+                    slots[index].key.~K();
+                    slots[index].value.~V();
+                }
+            }
+        }
+
+        /**
+         * @brief Releases a table allocated by resize().
+         */
+        void releaseTable(signed char* table)
+        {
+            if (table != nullptr && arena == nullptr)
+                itl::free(table);
+        }
+
+        signed char* control; ///< Control bytes of the table, followed by the entries.
+        EntryType* slots; ///< Entries of the table.
+        itl::size_t slotCount; ///< Number of slots, a power of two, or 0 before the first insertion.
+        itl::size_t entryCount; ///< Number of entries.
+        itl::size_t growthLeft; ///< Empty slots that may still be filled before the table grows.
+        itl::arena::Arena* arena; ///< Arena of the tables, or nullptr for the ITL allocator.
+        [[no_unique_address]] H hasher; ///< Hashes keys.
+        [[no_unique_address]] E equal; ///< Compares keys.
+    };
+}; // namespace map
+} // namespace itl
+
+#endif // _ITL_CONTAINERS_MAP_HPP
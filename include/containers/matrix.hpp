@@ -0,0 +1,350 @@
+/**
+ * @file include/containers/matrix.hpp
+ * @brief Provides dense matrices and their kernels for the ITL library.
+ * @category Containers
+ *
+ * This header defines a dense matrix stored row by row or column by
+ * column in aligned memory from the ITL allocator, and views that address
+ * any matrix, block of a matrix or transposed matrix through two strides,
+ * so that transposing is free until the data is actually read. The
+ * multiplication packs panels of its operands into cache-sized blocks and
+ * runs register-tiled micro-kernels compiled for every instruction set of
+ * itl::simd, optionally spread over a thread pool.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#ifndef _ITL_CONTAINERS_MATRIX_HPP
+#define _ITL_CONTAINERS_MATRIX_HPP
+
+#include "memory/allocator.hpp"
+#include "system/simd.hpp"
+#include "system/threadPool.hpp"
+#include "typing/ctypes.hpp"
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace matrix {
+#define MATRIX_ALIGNMENT 64 ///< Alignment of the storage, and of every row or column of a matrix.
+#define MATRIX_BLOCK_M 144 ///< Rows of the left operand packed together, a multiple of every micro-tile height.
+#define MATRIX_BLOCK_K 256 ///< Depth of the panels packed by the multiplication.
+#define MATRIX_BLOCK_N 2048 ///< Columns of the right operand packed together.
+#define MATRIX_PARALLEL_COLUMNS 256 ///< Columns of one parallel task of the multiplication.
+#define MATRIX_TRANSPOSE_TILE 32 ///< Side of the tiles a transposing copy walks to stay in cache.
+
+    /**
+     * @enum MatrixLayout
+     * @brief Selects how the elements of a matrix are laid out.
+     */
+    typedef enum {
+        MATRIX_ROW_MAJOR, ///< Rows are contiguous.
+        MATRIX_COLUMN_MAJOR ///< Columns are contiguous.
+    } MatrixLayout;
+
+    /**
+     * @struct View
+     * @brief Addresses the elements of a matrix without owning them.
+     *
+     * Element (row, column) is at data[row * rowStride + column *
+     * columnStride], so one view type covers both layouts, blocks of a
+     * larger matrix and transposed matrices.
+     *
+     * @tparam T The type of the elements.
+     */
+    template <typename T>
+    struct View {
+        T* data; ///< Element (0, 0).
+        itl::size_t rows; ///< Number of rows.
+        itl::size_t columns; ///< Number of columns.
+        itl::size_t rowStride; ///< Elements between two consecutive rows.
+        itl::size_t columnStride; ///< Elements between two consecutive columns.
+
+        T& operator()(itl::size_t row, itl::size_t column) const { return data[row * rowStride + column * columnStride]; }
+
+        /**
+         * @brief Returns the transpose of the view, without moving any
+         * element.
+         */
+        View transposed() const { return { data, columns, rows, columnStride, rowStride }; }
+
+        /**
+         * @brief Returns a block of the view.
+         *
+         * @param row The first row of the block.
+         * @param column The first column of the block.
+         * @param rowCount The number of rows of the block.
+         * @param columnCount The number of columns of the block.
+         */
+        View block(itl::size_t row, itl::size_t column, itl::size_t rowCount, itl::size_t columnCount) const
+        {
+            return { &(*this)(row, column), rowCount, columnCount, rowStride, columnStride };
+        }
+
+        /**
+         * @brief Reports whether the elements of each row are contiguous.
+         */
+        bool isRowMajor() const { return columnStride == 1; }
+
+        /**
+         * @brief Reports whether the elements of each column are contiguous.
+         */
+        bool isColumnMajor() const { return rowStride == 1; }
+    };
+
+    /**
+     * @class Matrix
+     * @brief A dense matrix of T.
+     *
+     * The elements live in one allocation aligned to MATRIX_ALIGNMENT, and
+     * every row (or column, in column-major order) is padded to a multiple
+     * of that alignment, so each one starts on a cache line. Matrices are
+     * moved, never copied implicitly; copy() duplicates their content.
+     *
+     * @tparam T The type of the elements, which must be trivially copyable.
+     */
+    template <typename T>
+    class Matrix {
+        static_assert(__is_trivially_copyable(T), "itl::matrix only stores trivially copyable elements");
+
+    public:
+        /**
+         * @brief Creates an empty matrix. Nothing is allocated.
+         */
+        Matrix()
+            : elements(nullptr)
+            , rowCount(0)
+            , columnCount(0)
+            , leading(0)
+            , order(MATRIX_ROW_MAJOR)
+        {
+        }
+
+        /**
+         * @brief Takes the elements of another matrix, leaving it empty.
+         */
+        Matrix(Matrix&& other)
+            : Matrix()
+        {
+            take(other);
+        }
+
+        Matrix& operator=(Matrix&& other)
+        {
+            if (this != &other) {
+                release();
+                take(other);
+            }
+
+            return *this;
+        }
+
+        /**
+         * @brief Releases the elements.
+         */
+        ~Matrix() { release(); }
+
+        Matrix(const Matrix&) = delete;
+        Matrix& operator=(const Matrix&) = delete;
+
+        /**
+         * @brief Replaces the matrix with a zeroed one of another shape.
+         *
+         * @param rows The number of rows.
+         * @param columns The number of columns.
+         * @param layout The order of the elements.
+         * @return false if the storage could not be allocated, leaving the
+         * matrix unchanged.
+         */
+        bool allocate(itl::size_t rows, itl::size_t columns, itl::matrix::MatrixLayout layout = MATRIX_ROW_MAJOR)
+        {
+            itl::size_t major = layout == MATRIX_ROW_MAJOR ? rows : columns;
+            itl::size_t minor = layout == MATRIX_ROW_MAJOR ? columns : rows;
+            itl::size_t bytes;
+
+            if (MATRIX_ALIGNMENT % sizeof(T) == 0)
+                minor = (minor + MATRIX_ALIGNMENT / sizeof(T) - 1) & ~(MATRIX_ALIGNMENT / sizeof(T) - 1);
+
+            if (__builtin_mul_overflow(major, minor, &bytes) || __builtin_mul_overflow(bytes, sizeof(T), &bytes))
+                return false;
+
+            T* buffer = (T*)itl::allocAligned(bytes == 0 ? 1 : bytes, MATRIX_ALIGNMENT);
+
+            if (buffer == nullptr)
+                return false;
+
+            itl::simd::fill(buffer, 0, bytes);
+            release();
+
+            elements = buffer;
+            rowCount = rows;
+            columnCount = columns;
+            leading = minor;
+            order = layout;
+
+            return true;
+        }
+
+        /**
+         * @brief Releases the elements, leaving an empty matrix.
+         */
+        void release()
+        {
+            itl::free(elements);
+
+            elements = nullptr;
+            rowCount = 0;
+            columnCount = 0;
+            leading = 0;
+        }
+
+        T& operator()(itl::size_t row, itl::size_t column) { return elements[offset(row, column)]; }
+        const T& operator()(itl::size_t row, itl::size_t column) const { return elements[offset(row, column)]; }
+
+        /**
+         * @brief Returns a view of the whole matrix.
+         */
+        itl::matrix::View<T> view()
+        {
+            if (order == MATRIX_ROW_MAJOR)
+                return { elements, rowCount, columnCount, leading, 1 };
+
+            return { elements, rowCount, columnCount, 1, leading };
+        }
+
+        /**
+         * @brief Returns a view of the transposed matrix, without moving any
+         * element.
+         */
+        itl::matrix::View<T> transposed() { return view().transposed(); }
+
+        /**
+         * @brief Returns a view of a block of the matrix.
+         */
+        itl::matrix::View<T> block(itl::size_t row, itl::size_t column, itl::size_t rows, itl::size_t columns)
+        {
+            return view().block(row, column, rows, columns);
+        }
+
+        T* data() { return elements; }
+        const T* data() const { return elements; }
+
+        /**
+         * @brief Returns the number of rows.
+         */
+        itl::size_t rows() const { return rowCount; }
+
+        /**
+         * @brief Returns the number of columns.
+         */
+        itl::size_t columns() const { return columnCount; }
+
+        /**
+         * @brief Returns the number of elements between the starts of two
+         * rows, or of two columns in column-major order.
+         */
+        itl::size_t stride() const { return leading; }
+
+        /**
+         * @brief Returns the order of the elements.
+         */
+        itl::matrix::MatrixLayout layout() const { return order; }
+
+    private:
+        /**
+         * @brief Returns the index of an element in the storage.
+         */
+        itl::size_t offset(itl::size_t row, itl::size_t column) const
+        {
+            return order == MATRIX_ROW_MAJOR ? row * leading + column : column * leading + row;
+        }
+
+        /**
+         * @brief Takes the elements of another matrix. This one must be
+         * empty.
+         */
+        void take(Matrix& other)
+        {
+            elements = other.elements;
+            rowCount = other.rowCount;
+            columnCount = other.columnCount;
+            leading = other.leading;
+            order = other.order;
+
+            other.elements = nullptr;
+            other.rowCount = 0;
+            other.columnCount = 0;
+            other.leading = 0;
+        }
+
+        T* elements; ///< The storage, aligned to MATRIX_ALIGNMENT.
+        itl::size_t rowCount; ///< Number of rows.
+        itl::size_t columnCount; ///< Number of columns.
+        itl::size_t leading; ///< Elements between two rows, or two columns in column-major order.
+        itl::matrix::MatrixLayout order; ///< Order of the elements.
+    };
+
+    /**
+     * @brief Computes c = alpha * a * b + beta * c.
+     *
+     * Any layout, block or transposed view is accepted for every operand,
+     * as long as c does not overlap a or b. With beta equal to 0, c is
+     * not read, so it may hold anything.
+     *
+     * @param a The left operand, of c.rows rows.
+     * @param b The right operand, of c.columns columns and a.columns rows.
+     * @param c The result.
+     * @param alpha The factor of the product.
+     * @param beta The factor of the previous content of c.
+     * @param pool A thread pool to spread the blocks of c over, or nullptr
+     * to run on the calling thread.
+     * @return 0 on success, -EINVAL if the shapes do not match, or -ENOMEM
+     * if the packing buffers could not be allocated.
+     */
+    int multiply(const itl::matrix::View<float>& a, const itl::matrix::View<float>& b, const itl::matrix::View<float>& c,
+        float alpha = 1, float beta = 0, itl::thread::ThreadPool* pool = nullptr);
+
+    /**
+     * @brief Computes c = alpha * a * b + beta * c in double precision.
+     */
+    int multiply(const itl::matrix::View<double>& a, const itl::matrix::View<double>& b, const itl::matrix::View<double>& c,
+        double alpha = 1, double beta = 0, itl::thread::ThreadPool* pool = nullptr);
+
+    /**
+     * @brief Copies the elements of a view into another of the same shape.
+     *
+     * Views with the same layout are copied row by row with itl::simd.
+     * Between a row-major and a column-major view, the elements are
+     * transposed in registers, one square of vectors at a time, within
+     * tiles that stay in cache. The views must not overlap.
+     *
+     * @return 0 on success, or -EINVAL if the shapes do not match.
+     */
+    int copy(const itl::matrix::View<float>& source, const itl::matrix::View<float>& destination);
+
+    /**
+     * @brief Copies the elements of a view of doubles into another.
+     */
+    int copy(const itl::matrix::View<double>& source, const itl::matrix::View<double>& destination);
+
+    /**
+     * @brief Stores the transpose of source into destination, which has as
+     * many rows as source has columns.
+     *
+     * To use a transposed matrix without storing it, use a transposed view
+     * instead.
+     *
+     * @return 0 on success, or -EINVAL if the shapes do not match.
+     */
+    template <typename T>
+    inline int transpose(const itl::matrix::View<T>& source, const itl::matrix::View<T>& destination)
+    {
+        return itl::matrix::copy(source.transposed(), destination);
+    }
+}; // namespace matrix
+} // namespace itl
+
+#endif // _ITL_CONTAINERS_MATRIX_HPP
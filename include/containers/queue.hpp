@@ -0,0 +1,630 @@
+/**
+ * @file include/containers/queue.hpp
+ * @brief Provides bounded lock-free queues for the ITL library.
+ * @category Containers
+ *
+ * This header defines two ring queues for passing messages between
+ * threads: a single-producer single-consumer queue, whose two ends only
+ * meet when it is empty or full, and a multi-producer multi-consumer queue
+ * after Dmitry Vyukov, where every slot carries a sequence number. Both
+ * have a fixed capacity, allocate only when they are initialized, and
+ * move elements in batches as well as one at a time. Their rings come
+ * from the ITL allocator or from huge pages.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#ifndef _ITL_CONTAINERS_QUEUE_HPP
+#define _ITL_CONTAINERS_QUEUE_HPP
+
+#include "memory/allocator.hpp"
+#include "memory/placement.hpp"
+#include "system/sync.hpp"
+#include "typing/ctypes.hpp"
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace queue {
+#define QUEUE_MIN_CAPACITY 2 ///< Smallest capacity of a queue.
+
+    /**
+     * @enum QueueStorage
+     * @brief Selects where the ring of a queue is allocated.
+     */
+    typedef enum {
+        QUEUE_STORAGE_ALLOCATOR, ///< From the ITL allocator, aligned to a cache line.
+        QUEUE_STORAGE_HUGE_PAGES ///< From hugetlb pages, falling back to transparent huge pages.
+    } QueueStorage;
+
+    /**
+     * @brief Allocates the ring of a queue.
+     *
+     * Huge-page rings are rounded to whole huge pages and populated up
+     * front, so the first lap around the ring takes no page faults.
+     *
+     * @param size The size of the ring, in bytes.
+     * @param storage Where to allocate the ring.
+     * @param backing Receives the pages that back the ring.
+     * @return The ring, aligned to a cache line, or nullptr on failure.
+     */
+    void* allocateRing(itl::size_t size, itl::queue::QueueStorage storage, itl::MemoryBacking* backing);
+
+    /**
+     * @brief Releases a ring obtained from allocateRing().
+     *
+     * @param ring The ring, or nullptr.
+     * @param size The size passed to allocateRing().
+     * @param storage The storage passed to allocateRing().
+     * @param backing The backing allocateRing() reported.
+     */
+    void freeRing(void* ring, itl::size_t size, itl::queue::QueueStorage storage, itl::MemoryBacking backing);
+
+    /**
+     * @brief Rounds a capacity up to a power of two.
+     */
+    inline itl::size_t roundCapacity(itl::size_t capacity)
+    {
+        itl::size_t rounded = QUEUE_MIN_CAPACITY;
+
+        while (rounded < capacity && rounded != 0)
+            rounded <<= 1;
+
+        return rounded;
+    }
+
+    /**
+     * @class SpscQueue
+     * @brief A bounded queue for one producer thread and one consumer
+     * thread.
+     *
+     * Each end owns a cache line holding its index and a copy of the index
+     * of the other end. The copy is only refreshed when the ring looks full
+     * to the producer or empty to the consumer, so as long as the queue is
+     * neither, both threads work on their own line and the only traffic
+     * between them is the slots themselves.
+     *
+     * @tparam T The type of the elements.
+     */
+    template <typename T>
+    class SpscQueue {
+    public:
+        /**
+         * @brief Creates a queue without a ring. Call initialize() before
+         * using it.
+         */
+        SpscQueue()
+            : head(0)
+            , cachedTail(0)
+            , tail(0)
+            , cachedHead(0)
+            , slots(nullptr)
+            , mask(0)
+            , storage(QUEUE_STORAGE_ALLOCATOR)
+            , backing(BACKING_REGULAR)
+        {
+        }
+
+        /**
+         * @brief Destroys the remaining elements and releases the ring.
+         */
+        ~SpscQueue() { destroy(); }
+
+        SpscQueue(const SpscQueue&) = delete;
+        SpscQueue& operator=(const SpscQueue&) = delete;
+
+        /**
+         * @brief Allocates the ring of the queue.
+         *
+         * @param capacity The number of elements the queue holds, rounded up
+         * to a power of two.
+         * @param ringStorage Where to allocate the ring.
+         * @return false if the ring could not be allocated.
+         */
+        bool initialize(itl::size_t capacity, itl::queue::QueueStorage ringStorage = QUEUE_STORAGE_ALLOCATOR)
+        {
+            destroy();
+            capacity = roundCapacity(capacity);
+
+            if (capacity == 0 || capacity > (itl::size_t)-1 / sizeof(T))
+                return false;
+
+            slots = (T*)allocateRing(capacity * sizeof(T), ringStorage, &backing);
+
+            if (slots == nullptr)
+                return false;
+
+            mask = capacity - 1;
+            storage = ringStorage;
+            head = cachedTail = 0;
+            tail = cachedHead = 0;
+
+            return true;
+        }
+
+        /**
+         * @brief Destroys the remaining elements and releases the ring.
+         *
+         * Neither end may be in use.
+         */
+        void destroy()
+        {
+            if (slots == nullptr)
+                return;
+
+            for (itl::size_t index = head; index != tail; ++index)
+                slots[index & mask].~T();
+
+            freeRing(slots, (mask + 1) * sizeof(T), storage, backing);
+            slots = nullptr;
+            mask = 0;
+        }
+
+        /**
+         * @brief Constructs an element at the tail of the queue. Producer
+         * only.
+         *
+         * @param arguments The arguments forwarded to the constructor of T.
+         * @return false if the queue is full.
+         */
+        template <typename... Arguments>
+        bool emplace(Arguments&&... arguments)
+        {
+            itl::size_t position = __atomic_load_n(&tail, __ATOMIC_RELAXED);
+
+            if (position - cachedHead > mask) {
+                cachedHead = __atomic_load_n(&head, __ATOMIC_ACQUIRE);
+
+                if (position - cachedHead > mask)
+                    return false;
+            }
+
+            new (&slots[position & mask]) T(static_cast<Arguments&&>(arguments)...);
+            __atomic_store_n(&tail, position + 1, __ATOMIC_RELEASE);
+
+            return true;
+        }
+
+        /**
+         * @brief Copies an element to the tail of the queue. Producer only.
+         *
+         * @return false if the queue is full.
+         */
+        bool push(const T& value) { return emplace(value); }
+
+        /**
+         * @brief Moves the element at the head of the queue out. Consumer
+         * only.
+         *
+         * @param value Receives the element.
+         * @return false if the queue is empty.
+         */
+        bool pop(T* value)
+        {
+            itl::size_t position = __atomic_load_n(&head, __ATOMIC_RELAXED);
+
+            if (position == cachedTail) {
+                cachedTail = __atomic_load_n(&tail, __ATOMIC_ACQUIRE);
+
+                if (position == cachedTail)
+                    return false;
+            }
+
+            T* slot = &slots[position & mask];
+
+            *value = static_cast<T&&>(*slot);
+            slot->~T();
+            __atomic_store_n(&head, position + 1, __ATOMIC_RELEASE);
+
+            return true;
+        }
+
+        /**
+         * @brief Copies several elements to the tail of the queue and
+         * publishes them at once. Producer only.
+         *
+         * @param values The elements to copy.
+         * @param count The number of elements.
+         * @return The number of elements copied, fewer than count when the
+         * queue fills up.
+         */
+        itl::size_t pushBatch(const T* values, itl::size_t count)
+        {
+            itl::size_t position = __atomic_load_n(&tail, __ATOMIC_RELAXED);
+            itl::size_t available = mask + 1 - (position - cachedHead);
+
+            if (available < count) {
+                cachedHead = __atomic_load_n(&head, __ATOMIC_ACQUIRE);
+                available = mask + 1 - (position - cachedHead);
+            }
+
+            if (count > available)
+                count = available;
+
+            for (itl::size_t index = 0; index < count; ++index)
+                new (&slots[(position + index) & mask]) T(values[index]);
+
+            if (count != 0)
+                __atomic_store_n(&tail, position + count, __ATOMIC_RELEASE);
+
+            return count;
+        }
+
+        /**
+         * @brief Moves several elements out of the head of the queue and
+         * releases their slots at once. Consumer only.
+         *
+         * @param values Receives the elements.
+         * @param count The largest number of elements to take.
+         * @return The number of elements taken.
+         */
+        itl::size_t popBatch(T* values, itl::size_t count)
+        {
+            itl::size_t position = __atomic_load_n(&head, __ATOMIC_RELAXED);
+            itl::size_t available = cachedTail - position;
+
+            if (available < count) {
+                cachedTail = __atomic_load_n(&tail, __ATOMIC_ACQUIRE);
+                available = cachedTail - position;
+            }
+
+            if (count > available)
+                count = available;
+
+            for (itl::size_t index = 0; index < count; ++index) {
+                T* slot = &slots[(position + index) & mask];
+
+                values[index] = static_cast<T&&>(*slot);
+                slot->~T();
+            }
+
+            if (count != 0)
+                __atomic_store_n(&head, position + count, __ATOMIC_RELEASE);
+
+            return count;
+        }
+
+        /**
+         * @brief Returns the number of elements the queue holds at most.
+         */
+        itl::size_t capacity() const { return slots == nullptr ? 0 : mask + 1; }
+
+        /**
+         * @brief Returns the number of elements in the queue, which may
+         * already have changed when it returns.
+         */
+        itl::size_t size() const
+        {
+            return __atomic_load_n(&tail, __ATOMIC_ACQUIRE) - __atomic_load_n(&head, __ATOMIC_ACQUIRE);
+        }
+
+        /**
+         * @brief Returns the pages backing the ring.
+         */
+        itl::MemoryBacking getBacking() const { return backing; }
+
+    private:
+        itl::size_t head __attribute__((aligned(CACHE_LINE_SIZE))); ///< Next slot to read, written by the consumer.
+        itl::size_t cachedTail; ///< Tail as last seen by the consumer.
+        itl::size_t tail __attribute__((aligned(CACHE_LINE_SIZE))); ///< Next slot to write, written by the producer.
+        itl::size_t cachedHead; ///< Head as last seen by the producer.
+        T* slots __attribute__((aligned(CACHE_LINE_SIZE))); ///< Ring of elements.
+        itl::size_t mask; ///< Capacity minus one.
+        itl::queue::QueueStorage storage; ///< Where the ring was allocated.
+        itl::MemoryBacking backing; ///< Pages backing the ring.
+    };
+
+    /**
+     * @class MpmcQueue
+     * @brief A bounded queue for any number of producer and consumer
+     * threads.
+     *
+     * Every cell holds a sequence number next to its element. A producer
+     * holding ticket p may write cell p when its sequence is p and then
+     * sets it to p + 1; a consumer holding ticket p may read it when its
+     * sequence is p + 1 and then sets it to p + capacity, which is the
+     * ticket of the next lap. Tickets are taken with a compare-and-swap on
+     * the enqueue or dequeue position, each on its own cache line, so
+     * producers and consumers only meet on the cells themselves.
+     *
+     * @tparam T The type of the elements.
+     */
+    template <typename T>
+    class MpmcQueue {
+    public:
+        /**
+         * @brief Creates a queue without a ring. Call initialize() before
+         * using it.
+         */
+        MpmcQueue()
+            : enqueuePosition(0)
+            , dequeuePosition(0)
+            , cells(nullptr)
+            , mask(0)
+            , storage(QUEUE_STORAGE_ALLOCATOR)
+            , backing(BACKING_REGULAR)
+        {
+        }
+
+        /**
+         * @brief Destroys the remaining elements and releases the ring.
+         */
+        ~MpmcQueue() { destroy(); }
+
+        MpmcQueue(const MpmcQueue&) = delete;
+        MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+        /**
+         * @brief Allocates the ring of the queue.
+         *
+         * @param capacity The number of elements the queue holds, rounded up
+         * to a power of two.
+         * @param ringStorage Where to allocate the ring.
+         * @return false if the ring could not be allocated.
+         */
+        bool initialize(itl::size_t capacity, itl::queue::QueueStorage ringStorage = QUEUE_STORAGE_ALLOCATOR)
+        {
+            destroy();
+            capacity = roundCapacity(capacity);
+
+            if (capacity == 0 || capacity > (itl::size_t)-1 / sizeof(Cell))
+                return false;
+
+            cells = (Cell*)allocateRing(capacity * sizeof(Cell), ringStorage, &backing);
+
+            if (cells == nullptr)
+                return false;
+
+            for (itl::size_t index = 0; index < capacity; ++index)
+                cells[index].sequence = index;
+
+            mask = capacity - 1;
+            storage = ringStorage;
+            enqueuePosition = 0;
+            dequeuePosition = 0;
+
+            return true;
+        }
+
+        /**
+         * @brief Destroys the remaining elements and releases the ring.
+         *
+         * No thread may be using the queue.
+         */
+        void destroy()
+        {
+            if (cells == nullptr)
+                return;
+
+            for (itl::size_t index = dequeuePosition; index != enqueuePosition; ++index)
+                valueOf(&cells[index & mask])->~T();
+
+            freeRing(cells, (mask + 1) * sizeof(Cell), storage, backing);
+            cells = nullptr;
+            mask = 0;
+        }
+
+        /**
+         * @brief Constructs an element at the tail of the queue.
+         *
+         * @param arguments The arguments forwarded to the constructor of T.
+         * @return false if the queue is full.
+         */
+        template <typename... Arguments>
+        bool emplace(Arguments&&... arguments)
+        {
+            itl::size_t position = __atomic_load_n(&enqueuePosition, __ATOMIC_RELAXED);
+            Cell* cell;
+
+            while (true) {
+                cell = &cells[position & mask];
+
+                itl::size_t sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+                itl::ssize_t difference = (itl::ssize_t)(sequence - position);
+
+                if (difference == 0) {
+                    if (__atomic_compare_exchange_n(&enqueuePosition, &position, position + 1, true,
+                            __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                        break;
+                } else if (difference < 0) {
+                    return false;
+                } else {
+                    position = __atomic_load_n(&enqueuePosition, __ATOMIC_RELAXED);
+                }
+            }
+
+            new (cell->value) T(static_cast<Arguments&&>(arguments)...);
+            __atomic_store_n(&cell->sequence, position + 1, __ATOMIC_RELEASE);
+
+            return true;
+        }
+
+        /**
+         * @brief Copies an element to the tail of the queue.
+         *
+         * @return false if the queue is full.
+         */
+        bool push(const T& value) { return emplace(value); }
+
+        /**
+         * @brief Moves the element at the head of the queue out.
+         *
+         * @param value Receives the element.
+         * @return false if the queue is empty.
+         */
+        bool pop(T* value)
+        {
+            itl::size_t position = __atomic_load_n(&dequeuePosition, __ATOMIC_RELAXED);
+            Cell* cell;
+
+            while (true) {
+                cell = &cells[position & mask];
+
+                itl::size_t sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+                itl::ssize_t difference = (itl::ssize_t)(sequence - (position + 1));
+
+                if (difference == 0) {
+                    if (__atomic_compare_exchange_n(&dequeuePosition, &position, position + 1, true,
+                            __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                        break;
+                } else if (difference < 0) {
+                    return false;
+                } else {
+                    position = __atomic_load_n(&dequeuePosition, __ATOMIC_RELAXED);
+                }
+            }
+
+            T* slot = valueOf(cell);
+
+            *value = static_cast<T&&>(*slot);
+            slot->~T();
+            __atomic_store_n(&cell->sequence, position + mask + 1, __ATOMIC_RELEASE);
+
+            return true;
+        }
+
+        /**
+         * @brief Copies several elements to the tail of the queue, taking
+         * their tickets with one compare-and-swap.
+         *
+         * @param values The elements to copy.
+         * @param count The number of elements.
+         * @return The number of elements copied, fewer than count when the
+         * queue fills up.
+         */
+        itl::size_t pushBatch(const T* values, itl::size_t count)
+        {
+            itl::size_t position = __atomic_load_n(&enqueuePosition, __ATOMIC_RELAXED);
+            itl::size_t taken = claim(&enqueuePosition, &position, count, 0);
+
+            for (itl::size_t index = 0; index < taken; ++index) {
+                Cell* cell = &cells[(position + index) & mask];
+
+                new (cell->value) T(values[index]);
+                __atomic_store_n(&cell->sequence, position + index + 1, __ATOMIC_RELEASE);
+            }
+
+            return taken;
+        }
+
+        /**
+         * @brief Moves several elements out of the head of the queue,
+         * taking their tickets with one compare-and-swap.
+         *
+         * @param values Receives the elements.
+         * @param count The largest number of elements to take.
+         * @return The number of elements taken.
+         */
+        itl::size_t popBatch(T* values, itl::size_t count)
+        {
+            itl::size_t position = __atomic_load_n(&dequeuePosition, __ATOMIC_RELAXED);
+            itl::size_t taken = claim(&dequeuePosition, &position, count, 1);
+
+            for (itl::size_t index = 0; index < taken; ++index) {
+                Cell* cell = &cells[(position + index) & mask];
+                T* slot = valueOf(cell);
+
+                values[index] = static_cast<T&&>(*slot);
+                slot->~T();
+                __atomic_store_n(&cell->sequence, position + index + mask + 1, __ATOMIC_RELEASE);
+            }
+
+            return taken;
+        }
+
+        /**
+         * @brief Returns the number of elements the queue holds at most.
+         */
+        itl::size_t capacity() const { return cells == nullptr ? 0 : mask + 1; }
+
+        /**
+         * @brief Returns the number of elements in the queue, which may
+         * already have changed when it returns.
+         */
+        itl::size_t size() const
+        {
+            itl::size_t dequeued = __atomic_load_n(&dequeuePosition, __ATOMIC_ACQUIRE);
+            itl::size_t enqueued = __atomic_load_n(&enqueuePosition, __ATOMIC_ACQUIRE);
+
+            return (itl::ssize_t)(enqueued - dequeued) > 0 ? enqueued - dequeued : 0;
+        }
+
+        /**
+         * @brief Returns the pages backing the ring.
+         */
+        itl::MemoryBacking getBacking() const { return backing; }
+
+    private:
+        /**
+         * @struct Cell
+         * @brief A slot of the ring and its sequence number.
+         */
+        struct Cell {
+            itl::size_t sequence; ///< Ticket that may use the cell next, plus the offset of its side.
+            alignas(T) unsigned char value[sizeof(T)]; ///< Storage of the element.
+        };
+
+        /**
+         * @brief Returns the element stored in a cell.
+         */
+        static T* valueOf(Cell* cell) { return (T*)cell->value; }
+
+        /**
+         * @brief Takes up to count consecutive tickets whose cells are ready.
+         *
+         * The cells are checked before the position moves: only the thread
+         * that moves the position past a cell may use it, so cells that were
+         * ready stay ready until the compare-and-swap.
+         *
+         * @param counter The enqueue or dequeue position.
+         * @param position The position last read, updated with the first
+         * ticket taken.
+         * @param count The largest number of tickets to take.
+         * @param offset 0 for producers, 1 for consumers.
+         * @return The number of tickets taken.
+         */
+        itl::size_t claim(itl::size_t* counter, itl::size_t* position, itl::size_t count, itl::size_t offset)
+        {
+            while (count != 0) {
+                itl::size_t ready = 0;
+
+                while (ready < count) {
+                    itl::size_t sequence = __atomic_load_n(&cells[(*position + ready) & mask].sequence, __ATOMIC_ACQUIRE);
+
+                    if (sequence != *position + ready + offset)
+                        break;
+
+                    ++ready;
+                }
+
+                if (ready == 0) {
+                    itl::size_t sequence = __atomic_load_n(&cells[*position & mask].sequence, __ATOMIC_ACQUIRE);
+
+                    if ((itl::ssize_t)(sequence - (*position + offset)) < 0)
+                        return 0;
+
+                    *position = __atomic_load_n(counter, __ATOMIC_RELAXED);
+                    continue;
+                }
+
+                if (__atomic_compare_exchange_n(counter, position, *position + ready, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                    return ready;
+            }
+
+            return 0;
+        }
+
+        itl::size_t enqueuePosition __attribute__((aligned(CACHE_LINE_SIZE))); ///< Next ticket of the producers.
+        itl::size_t dequeuePosition __attribute__((aligned(CACHE_LINE_SIZE))); ///< Next ticket of the consumers.
+        Cell* cells __attribute__((aligned(CACHE_LINE_SIZE))); ///< Ring of cells.
+        itl::size_t mask; ///< Capacity minus one.
+        itl::queue::QueueStorage storage; ///< Where the ring was allocated.
+        itl::MemoryBacking backing; ///< Pages backing the ring.
+    };
+}; // namespace queue
+} // namespace itl
+
+#endif // _ITL_CONTAINERS_QUEUE_HPP
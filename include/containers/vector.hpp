@@ -0,0 +1,772 @@
+/**
+ * @file include/containers/vector.hpp
+ * @brief Provides growable arrays for the ITL library.
+ * @category Containers
+ *
+ * This header defines a dynamic array with an optional inline buffer for
+ * short sequences, and a growable circular buffer. Elements that can be
+ * moved bitwise grow through itl::realloc(), which resizes small blocks in
+ * place within their size class and large ones with mremap, so a vector
+ * that keeps growing is not copied over and over; every capacity is also
+ * widened to the usable size of its allocation.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#ifndef _ITL_CONTAINERS_VECTOR_HPP
+#define _ITL_CONTAINERS_VECTOR_HPP
+
+#include "memory/allocator.hpp"
+#include "memory/placement.hpp"
+#include "system/simd.hpp"
+#include "typing/ctypes.hpp"
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace vector {
+#define VECTOR_MIN_CAPACITY 4 ///< Capacity of the first allocation of a vector.
+#define VECTOR_REALLOC_ALIGNMENT 16 ///< Largest element alignment that itl::realloc() preserves.
+
+    /**
+     * @brief Tells whether moving a T is the same as copying its bytes and
+     * forgetting the source.
+     *
+     * This holds for trivially copyable types, and for most types that own
+     * memory through a pointer, since they do not point into themselves.
+     * Specialize it to true for such types so vectors grow them with
+     * realloc() instead of moving them one by one.
+     */
+    template <typename T>
+    struct IsTriviallyRelocatable {
+        static constexpr bool value = __is_trivially_copyable(T); ///< Whether T can be moved bitwise.
+    };
+
+    /**
+     * @brief Moves bytes between two regions that may overlap.
+     *
+     * @param destination The region to move to.
+     * @param source The region to move from.
+     * @param size The number of bytes.
+     */
+    inline void moveBytes(void* destination, const void* source, itl::size_t size)
+    {
+        if (destination != source && size != 0)
+            itl::simd::copy(destination, source, size);
+    }
+
+    /**
+     * @brief Moves count elements to uninitialized memory and destroys the
+     * sources. The regions must not overlap.
+     */
+    template <typename T>
+    inline void relocate(T* destination, T* source, itl::size_t count)
+    {
+        if constexpr (IsTriviallyRelocatable<T>::value) {
+            moveBytes(destination, source, count * sizeof(T));
+        } else {
+            for (itl::size_t index = 0; index < count; ++index) {
+                new (&destination[index]) T(static_cast<T&&>(source[index]));
+                source[index].~T();
+            }
+        }
+    }
+
+    /**
+     * @struct InlineStorage
+     * @brief Room for N elements inside a vector.
+     */
+    template <typename T, itl::size_t N>
+    struct InlineStorage {
+        alignas(T) unsigned char bytes[N * sizeof(T)]; ///< Uninitialized elements.
+
+        T* data() const { return (T*)bytes; }
+    };
+
+    template <typename T>
+    struct InlineStorage<T, 0> {
+        T* data() const { return nullptr; }
+    };
+
+    /**
+     * @class Vector
+     * @brief A growable array of T.
+     *
+     * The first N elements are stored inside the vector itself, so short
+     * sequences never allocate; Vector<T> has no inline buffer and is the
+     * size of three pointers. Past that, elements live in one allocation
+     * from the ITL allocator that doubles when it fills up. Capacities are
+     * widened to the usable size of the allocation, so the slack of its
+     * size class is used before the vector grows again.
+     *
+     * When T is trivially relocatable and not over-aligned, growing goes
+     * through itl::realloc(): within a size class nothing moves, and large
+     * buffers are remapped rather than copied. Other types are moved into
+     * a new allocation one element at a time.
+     *
+     * Functions that may allocate report failure by returning false or
+     * nullptr and leave the vector unchanged.
+     *
+     * @tparam T The type of the elements.
+     * @tparam N The number of elements stored inline.
+     */
+    template <typename T, itl::size_t N = 0>
+    class Vector {
+    public:
+        /**
+         * @brief Creates an empty vector. Nothing is allocated until it
+         * outgrows its inline buffer.
+         */
+        Vector()
+            : elements(nullptr)
+            , count(0)
+            , slots(N)
+        {
+            elements = storage.data();
+        }
+
+        /**
+         * @brief Takes the elements of another vector, leaving it empty.
+         *
+         * Heap buffers change owner; inline elements are relocated.
+         */
+        Vector(Vector&& other)
+            : Vector()
+        {
+            take(other);
+        }
+
+        Vector& operator=(Vector&& other)
+        {
+            if (this != &other) {
+                release();
+                take(other);
+            }
+
+            return *this;
+        }
+
+        /**
+         * @brief Destroys the elements and releases the buffer.
+         */
+        ~Vector() { release(); }
+
+        Vector(const Vector&) = delete;
+        Vector& operator=(const Vector&) = delete;
+
+        /**
+         * @brief Makes room for at least capacity elements.
+         *
+         * @return false if the buffer could not grow.
+         */
+        bool reserve(itl::size_t capacity) { return capacity <= slots || reallocate(capacity); }
+
+        /**
+         * @brief Constructs an element at the end.
+         *
+         * The arguments may refer to elements of the vector itself.
+         *
+         * @param arguments The arguments forwarded to the constructor of T.
+         * @return The new element, or nullptr if the buffer could not grow.
+         */
+        template <typename... Arguments>
+        T* emplaceBack(Arguments&&... arguments)
+        {
+            if (__builtin_expect(count == slots, 0))
+                return growAndEmplace(static_cast<Arguments&&>(arguments)...);
+
+            T* element = new (&elements[count]) T(static_cast<Arguments&&>(arguments)...);
+
+            ++count;
+
+            return element;
+        }
+
+        /**
+         * @brief Copies an element to the end.
+         *
+         * @return false if the buffer could not grow.
+         */
+        bool pushBack(const T& value) { return emplaceBack(value) != nullptr; }
+
+        /**
+         * @brief Copies several elements to the end, growing at most once.
+         *
+         * The values may be elements of the vector itself.
+         *
+         * @return false if the buffer could not grow.
+         */
+        bool append(const T* values, itl::size_t number)
+        {
+            if (number > slots - count) {
+                // Growing moves the elements, so values inside the buffer
+                // are found again at the same index.
+                itl::uintptr_t offset = (itl::uintptr_t)values - (itl::uintptr_t)elements;
+                bool inside = offset < count * sizeof(T);
+
+                if (!grow(count + number))
+                    return false;
+
+                if (inside)
+                    values = (const T*)((itl::uintptr_t)elements + offset);
+            }
+
+            for (itl::size_t index = 0; index < number; ++index)
+                new (&elements[count + index]) T(values[index]);
+
+            count += number;
+
+            return true;
+        }
+
+        /**
+         * @brief Destroys the last element. The vector must not be empty.
+         */
+        void popBack() { elements[--count].~T(); }
+
+        /**
+         * @brief Copies an element before position index, shifting the
+         * following ones.
+         *
+         * The value is copied before anything moves, so it may be an
+         * element of the vector itself.
+         *
+         * @return false if the buffer could not grow.
+         */
+        bool insert(itl::size_t index, const T& value)
+        {
+            InlineStorage<T, 1> pending;
+            T* copy = new (pending.data()) T(value);
+
+            if (count == slots && !grow(count + 1)) {
+                copy->~T();
+                return false;
+            }
+
+            if constexpr (IsTriviallyRelocatable<T>::value) {
+                moveBytes(&elements[index + 1], &elements[index], (count - index) * sizeof(T));
+            } else {
+                for (itl::size_t position = count; position > index; --position) {
+                    new (&elements[position]) T(static_cast<T&&>(elements[position - 1]));
+                    elements[position - 1].~T();
+                }
+            }
+
+            relocate(&elements[index], copy, 1);
+            ++count;
+
+            return true;
+        }
+
+        /**
+         * @brief Destroys the element at index and shifts the following ones.
+         */
+        void erase(itl::size_t index)
+        {
+            elements[index].~T();
+
+            if constexpr (IsTriviallyRelocatable<T>::value) {
+                moveBytes(&elements[index], &elements[index + 1], (count - index - 1) * sizeof(T));
+            } else {
+                for (itl::size_t position = index + 1; position < count; ++position) {
+                    new (&elements[position - 1]) T(static_cast<T&&>(elements[position]));
+                    elements[position].~T();
+                }
+            }
+
+            --count;
+        }
+
+        /**
+         * @brief Grows or shrinks the vector to size elements, value
+         * initializing new ones.
+         *
+         * @return false if the buffer could not grow.
+         */
+        bool resize(itl::size_t size)
+        {
+            if (size > slots && !reallocate(size))
+                return false;
+
+            while (count > size)
+                elements[--count].~T();
+
+            for (; count < size; ++count)
+                new (&elements[count]) T();
+
+            return true;
+        }
+
+        /**
+         * @brief Destroys every element but keeps the buffer.
+         */
+        void clear()
+        {
+            while (count > 0)
+                elements[--count].~T();
+        }
+
+        /**
+         * @brief Releases the unused capacity, moving the elements back
+         * inline when they fit.
+         *
+         * @return false if the buffer could not be reallocated.
+         */
+        bool shrinkToFit()
+        {
+            if (!onHeap() || count == slots)
+                return true;
+
+            if (count <= N) {
+                T* buffer = elements;
+
+                relocate(storage.data(), buffer, count);
+                itl::free(buffer);
+                elements = storage.data();
+                slots = N;
+
+                return true;
+            }
+
+            return reallocate(count);
+        }
+
+        T& operator[](itl::size_t index) { return elements[index]; }
+        const T& operator[](itl::size_t index) const { return elements[index]; }
+
+        T& front() { return elements[0]; }
+        T& back() { return elements[count - 1]; }
+
+        T* data() { return elements; }
+        const T* data() const { return elements; }
+
+        T* begin() { return elements; }
+        T* end() { return elements + count; }
+        const T* begin() const { return elements; }
+        const T* end() const { return elements + count; }
+
+        /**
+         * @brief Returns the number of elements.
+         */
+        itl::size_t size() const { return count; }
+
+        /**
+         * @brief Returns the number of elements that fit without growing.
+         */
+        itl::size_t capacity() const { return slots; }
+
+        /**
+         * @brief Reports whether the vector has no elements.
+         */
+        bool isEmpty() const { return count == 0; }
+
+    private:
+        /**
+         * @brief Whether the buffer can be grown with itl::realloc().
+         */
+        static constexpr bool REALLOCATES = IsTriviallyRelocatable<T>::value && alignof(T) <= VECTOR_REALLOC_ALIGNMENT;
+
+        /**
+         * @brief Reports whether the elements live in an allocation.
+         */
+        bool onHeap() const { return elements != storage.data(); }
+
+        /**
+         * @brief Grows the buffer geometrically to at least minimum slots.
+         */
+        bool grow(itl::size_t minimum)
+        {
+            itl::size_t capacity = slots * 2 < VECTOR_MIN_CAPACITY ? VECTOR_MIN_CAPACITY : slots * 2;
+
+            return reallocate(capacity < minimum || capacity < slots ? minimum : capacity);
+        }
+
+        /**
+         * @brief Grows the buffer and constructs an element at the end.
+         *
+         * The element is built aside first, since the arguments may refer
+         * to elements that growing moves or frees, and relocated in after.
+         */
+        template <typename... Arguments>
+        T* growAndEmplace(Arguments&&... arguments)
+        {
+            InlineStorage<T, 1> pending;
+            T* element = new (pending.data()) T(static_cast<Arguments&&>(arguments)...);
+
+            if (!grow(count + 1)) {
+                element->~T();
+                return nullptr;
+            }
+
+            relocate(&elements[count], element, 1);
+
+            return &elements[count++];
+        }
+
+        /**
+         * @brief Moves the elements to an allocation of at least capacity
+         * slots, which must hold them all.
+         */
+        bool reallocate(itl::size_t capacity)
+        {
+            itl::size_t bytes;
+
+            if (__builtin_mul_overflow(capacity, sizeof(T), &bytes))
+                return false;
+
+            T* buffer;
+
+            if (REALLOCATES && onHeap()) {
+                buffer = (T*)itl::realloc(elements, bytes);
+
+                if (buffer == nullptr)
+                    return false;
+            } else {
+                buffer = (T*)(alignof(T) <= VECTOR_REALLOC_ALIGNMENT ? itl::alloc(bytes) : itl::allocAligned(bytes, alignof(T)));
+
+                if (buffer == nullptr)
+                    return false;
+
+                relocate(buffer, elements, count);
+
+                if (onHeap())
+                    itl::free(elements);
+            }
+
+            elements = buffer;
+            slots = itl::usableSize(buffer) / sizeof(T);
+
+            return true;
+        }
+
+        /**
+         * @brief Takes the elements of another vector. This one must be empty
+         * and inline.
+         */
+        void take(Vector& other)
+        {
+            if (other.onHeap()) {
+                elements = other.elements;
+                slots = other.slots;
+            } else {
+                relocate(elements, other.elements, other.count);
+            }
+
+            count = other.count;
+            other.elements = other.storage.data();
+            other.count = 0;
+            other.slots = N;
+        }
+
+        /**
+         * @brief Destroys the elements and releases the buffer, leaving the
+         * vector empty and inline.
+         */
+        void release()
+        {
+            clear();
+
+            if (onHeap())
+                itl::free(elements);
+
+            elements = storage.data();
+            slots = N;
+        }
+
+        T* elements; ///< First element, inline or in the allocation.
+        itl::size_t count; ///< Number of elements.
+        itl::size_t slots; ///< Number of elements that fit in the buffer.
+        [[no_unique_address]] InlineStorage<T, N> storage; ///< Inline elements.
+    };
+
+    /**
+     * @brief A vector without inline buffer only points to its elements, so
+     * it can itself be moved bitwise.
+     */
+    template <typename T>
+    struct IsTriviallyRelocatable<itl::vector::Vector<T, 0>> {
+        static constexpr bool value = true; ///< Whether the vector can be moved bitwise.
+    };
+
+    /**
+     * @brief A vector storing up to N elements inline.
+     */
+    template <typename T, itl::size_t N>
+    using SmallVector = itl::vector::Vector<T, N>;
+
+    /**
+     * @class CircularVector
+     * @brief A growable circular buffer of T, with constant-time insertion
+     * and removal at both ends.
+     *
+     * Elements occupy a power-of-two ring starting at head and wrapping
+     * around its end. When the ring fills up it doubles: trivially
+     * relocatable elements go through itl::realloc(), after which only the
+     * wrapped part is moved past the old end, and the rest stay in place
+     * even when the pages were remapped.
+     *
+     * @tparam T The type of the elements.
+     */
+    template <typename T>
+    class CircularVector {
+    public:
+        /**
+         * @brief Creates an empty buffer. Nothing is allocated until the
+         * first insertion.
+         */
+        CircularVector()
+            : elements(nullptr)
+            , head(0)
+            , count(0)
+            , mask(0)
+        {
+        }
+
+        /**
+         * @brief Destroys the elements and releases the ring.
+         */
+        ~CircularVector()
+        {
+            clear();
+            itl::free(elements);
+        }
+
+        CircularVector(const CircularVector&) = delete;
+        CircularVector& operator=(const CircularVector&) = delete;
+
+        /**
+         * @brief Makes room for at least capacity elements.
+         *
+         * @return false if the ring could not grow.
+         */
+        bool reserve(itl::size_t capacity)
+        {
+            if (elements != nullptr && capacity <= mask + 1)
+                return true;
+
+            itl::size_t size = elements == nullptr ? VECTOR_MIN_CAPACITY : (mask + 1) * 2;
+
+            while (size < capacity) {
+                if ((size <<= 1) == 0)
+                    return false;
+            }
+
+            return reallocate(size);
+        }
+
+        /**
+         * @brief Copies an element to the back.
+         *
+         * The value may be an element of the buffer itself.
+         *
+         * @return false if the ring could not grow.
+         */
+        bool pushBack(const T& value)
+        {
+            if (__builtin_expect(isFull(), 0))
+                return growAndPush(value, false);
+
+            new (&elements[(head + count) & mask]) T(value);
+            ++count;
+
+            return true;
+        }
+
+        /**
+         * @brief Copies an element to the front.
+         *
+         * The value may be an element of the buffer itself.
+         *
+         * @return false if the ring could not grow.
+         */
+        bool pushFront(const T& value)
+        {
+            if (__builtin_expect(isFull(), 0))
+                return growAndPush(value, true);
+
+            head = (head - 1) & mask;
+            new (&elements[head]) T(value);
+            ++count;
+
+            return true;
+        }
+
+        /**
+         * @brief Moves the first element out.
+         *
+         * @param value Receives the element.
+         * @return false if the buffer is empty.
+         */
+        bool popFront(T* value)
+        {
+            if (count == 0)
+                return false;
+
+            *value = static_cast<T&&>(elements[head]);
+            elements[head].~T();
+            head = (head + 1) & mask;
+            --count;
+
+            return true;
+        }
+
+        /**
+         * @brief Moves the last element out.
+         *
+         * @param value Receives the element.
+         * @return false if the buffer is empty.
+         */
+        bool popBack(T* value)
+        {
+            if (count == 0)
+                return false;
+
+            T* element = &elements[(head + count - 1) & mask];
+
+            *value = static_cast<T&&>(*element);
+            element->~T();
+            --count;
+
+            return true;
+        }
+
+        /**
+         * @brief Destroys every element but keeps the ring.
+         */
+        void clear()
+        {
+            for (; count > 0; --count, head = (head + 1) & mask)
+                elements[head].~T();
+
+            head = 0;
+        }
+
+        /**
+         * @brief Returns the element at a position counted from the front.
+         */
+        T& operator[](itl::size_t index) { return elements[(head + index) & mask]; }
+        const T& operator[](itl::size_t index) const { return elements[(head + index) & mask]; }
+
+        T& front() { return elements[head]; }
+        T& back() { return elements[(head + count - 1) & mask]; }
+
+        /**
+         * @brief Returns the number of elements.
+         */
+        itl::size_t size() const { return count; }
+
+        /**
+         * @brief Returns the number of elements that fit without growing.
+         */
+        itl::size_t capacity() const { return elements == nullptr ? 0 : mask + 1; }
+
+        /**
+         * @brief Reports whether the buffer has no elements.
+         */
+        bool isEmpty() const { return count == 0; }
+
+    private:
+        /**
+         * @brief Whether the ring can be grown with itl::realloc().
+         */
+        static constexpr bool REALLOCATES = IsTriviallyRelocatable<T>::value && alignof(T) <= VECTOR_REALLOC_ALIGNMENT;
+
+        /**
+         * @brief Reports whether the next insertion needs a larger ring.
+         */
+        bool isFull() const { return elements == nullptr || count == mask + 1; }
+
+        /**
+         * @brief Grows the ring and copies an element to one end.
+         *
+         * The value is copied aside first, since it may be an element that
+         * growing moves or frees, and relocated in after.
+         */
+        bool growAndPush(const T& value, bool front)
+        {
+            InlineStorage<T, 1> pending;
+            T* copy = new (pending.data()) T(value);
+
+            if (!reserve(count + 1)) {
+                copy->~T();
+                return false;
+            }
+
+            if (front)
+                head = (head - 1) & mask;
+
+            relocate(&elements[front ? head : (head + count) & mask], copy, 1);
+            ++count;
+
+            return true;
+        }
+
+        /**
+         * @brief Moves the elements to a ring of size slots, a power of two
+         * that holds them all.
+         */
+        bool reallocate(itl::size_t size)
+        {
+            itl::size_t bytes;
+
+            if (__builtin_mul_overflow(size, sizeof(T), &bytes))
+                return false;
+
+            if (REALLOCATES && elements != nullptr) {
+                itl::size_t oldSize = mask + 1;
+                T* ring = (T*)itl::realloc(elements, bytes);
+
+                if (ring == nullptr)
+                    return false;
+
+                // The part that wrapped around the old end follows it now.
+                if (head + count > oldSize)
+                    moveBytes(&ring[oldSize], ring, (head + count - oldSize) * sizeof(T));
+
+                elements = ring;
+                mask = size - 1;
+
+                return true;
+            }
+
+            T* ring = (T*)(alignof(T) <= VECTOR_REALLOC_ALIGNMENT ? itl::alloc(bytes) : itl::allocAligned(bytes, alignof(T)));
+
+            if (ring == nullptr)
+                return false;
+
+            if (elements != nullptr) {
+                itl::size_t first = count < mask + 1 - head ? count : mask + 1 - head;
+
+                relocate(ring, &elements[head], first);
+                relocate(&ring[first], elements, count - first);
+                itl::free(elements);
+            }
+
+            elements = ring;
+            head = 0;
+            mask = size - 1;
+
+            return true;
+        }
+
+        T* elements; ///< Ring of elements.
+        itl::size_t head; ///< Slot of the first element.
+        itl::size_t count; ///< Number of elements.
+        itl::size_t mask; ///< Number of slots minus one.
+    };
+
+    /**
+     * @brief A circular buffer only points to its elements, so it can
+     * itself be moved bitwise.
+     */
+    template <typename T>
+    struct IsTriviallyRelocatable<itl::vector::CircularVector<T>> {
+        static constexpr bool value = true; ///< Whether the buffer can be moved bitwise.
+    };
+}; // namespace vector
+} // namespace itl
+
+#endif // _ITL_CONTAINERS_VECTOR_HPP
@@ -0,0 +1,194 @@
+/**
+ * @file include/io/mapping.hpp
+ * @brief Provides read-only memory-mapped views of files.
+ * @category Input/Output
+ *
+ * This header defines a mapped file, a read-only window of a file mapped
+ * into memory, which lets a file be parsed in place without copying it
+ * into a buffer. Files that fit in the address-space budget are mapped
+ * whole; larger files are mapped one window at a time, and the window
+ * slides over the file on request. Access pattern hints are passed to the
+ * kernel so it can tune readahead to the way the file is read.
+ *
+ * @note These functions are only available on Linux systems on x86 and
+ * x86_64 architectures.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#ifndef _ITL_IO_MAPPING_HPP
+#define _ITL_IO_MAPPING_HPP
+
+#include "typing/ctypes.hpp"
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace file {
+// Mapping flags
+#define MAPPING_POPULATE (1U << 0) ///< Prefault every window when it is mapped.
+#define MAPPING_KEEP_DESCRIPTOR (1U << 1) ///< Leave the descriptor open when the file is unmapped.
+
+#ifdef __x86_64__
+#define MAPPING_DEFAULT_BUDGET (1ULL << 30) ///< Default address-space budget of a mapped file (1 GiB).
+#elif __i386__
+#define MAPPING_DEFAULT_BUDGET (64UL << 20) ///< Default address-space budget of a mapped file (64 MiB).
+#endif // #ifdef __x86_64__
+
+    /**
+     * @struct View
+     * @brief A read-only span of bytes of a mapped file.
+     */
+    typedef struct {
+        const unsigned char* data; ///< First byte of the span, or nullptr when it is empty.
+        itl::size_t size; ///< Number of bytes in the span.
+        itl::uint64_t offset; ///< Offset of the first byte in the file.
+    } View;
+
+    /**
+     * @struct MappedFile
+     * @brief A file mapped into memory, whole or through a sliding window.
+     */
+    typedef struct {
+        int fileDescriptor; ///< Descriptor of the mapped file.
+        unsigned flags; ///< MAPPING_* flags.
+        int advice; ///< MADV_* hint applied to every window.
+        itl::uint64_t fileSize; ///< Size of the file, in bytes.
+        itl::size_t budget; ///< Largest window, in bytes, a multiple of the page size.
+        void* mapping; ///< Current mapping, starting at a page boundary.
+        itl::size_t mappingSize; ///< Size of the current mapping, in bytes.
+        itl::uint64_t mappingOffset; ///< Offset in the file of the current mapping.
+    } MappedFile;
+
+    /**
+     * @brief Opens a file read-only and maps its first window.
+     *
+     * @param file The mapped file to initialize.
+     * @param path The path of the file.
+     * @param budget The largest window, in bytes, or 0 for
+     * MAPPING_DEFAULT_BUDGET. Files that fit are mapped whole.
+     * @param flags MAPPING_* flags.
+     * @return 0 on success, or a negated errno value on failure.
+     */
+    int mapFile(itl::file::MappedFile* file, const char* path, itl::size_t budget, unsigned flags);
+
+    /**
+     * @brief Maps the first window of a file that is already open.
+     *
+     * The mapped file takes ownership of the descriptor and closes it in
+     * unmapFile(), unless MAPPING_KEEP_DESCRIPTOR is given.
+     *
+     * @param file The mapped file to initialize.
+     * @param fileDescriptor A descriptor of the file, open for reading.
+     * @param budget The largest window, in bytes, or 0 for
+     * MAPPING_DEFAULT_BUDGET.
+     * @param flags MAPPING_* flags.
+     * @return 0 on success, or a negated errno value on failure.
+     */
+    int mapDescriptor(itl::file::MappedFile* file, int fileDescriptor, itl::size_t budget, unsigned flags);
+
+    /**
+     * @brief Unmaps the current window and closes the file.
+     *
+     * @param file The mapped file.
+     */
+    void unmapFile(itl::file::MappedFile* file);
+
+    /**
+     * @brief Maps the window that starts at an offset of the file.
+     *
+     * The window starts at the page that contains the offset and spans up
+     * to the budget or to the end of the file.
+     *
+     * @param file The mapped file.
+     * @param offset The offset in the file, below its size.
+     * @return 0 on success, or a negated errno value on failure.
+     */
+    int mapWindow(itl::file::MappedFile* file, itl::uint64_t offset);
+
+    /**
+     * @brief Slides the window to the bytes that follow it.
+     *
+     * @param file The mapped file.
+     * @return true if a new window was mapped, false at the end of the file
+     * or on failure.
+     */
+    bool nextWindow(itl::file::MappedFile* file);
+
+    /**
+     * @brief Applies an access pattern hint to the file.
+     *
+     * The hint applies to the current window and to every window mapped
+     * afterwards. MADV_SEQUENTIAL makes the kernel read ahead aggressively
+     * and drop pages soon after they are read, MADV_RANDOM disables
+     * readahead, and MADV_WILLNEED starts reading the window in the
+     * background.
+     *
+     * @param file The mapped file.
+     * @param advice The hint (MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM or
+     * MADV_WILLNEED).
+     * @return 0 on success, or a negated errno value on failure.
+     */
+    int adviseMapping(itl::file::MappedFile* file, int advice);
+
+    /**
+     * @brief Starts reading part of the current window in the background.
+     *
+     * @param file The mapped file.
+     * @param offset The offset in the file of the first byte.
+     * @param length The number of bytes, clipped to the window.
+     * @return 0 on success, or a negated errno value on failure.
+     */
+    int prefetch(itl::file::MappedFile* file, itl::uint64_t offset, itl::size_t length);
+
+    /**
+     * @brief Returns the bytes of the current window.
+     *
+     * @param file The mapped file.
+     * @return The window, empty when nothing is mapped.
+     */
+    inline itl::file::View getView(const itl::file::MappedFile* file)
+    {
+        if (file->mapping == nullptr)
+            return { nullptr, 0, file->mappingOffset };
+
+        return { (const unsigned char*)file->mapping, file->mappingSize, file->mappingOffset };
+    }
+
+    /**
+     * @brief Returns a range of bytes of the file, sliding the window to it
+     * when it is not mapped.
+     *
+     * Ranges inside the current window are returned without a system call.
+     *
+     * @param file The mapped file.
+     * @param offset The offset in the file of the first byte.
+     * @param length The number of bytes, at most the budget.
+     * @return A pointer to the bytes, valid until the window moves, or
+     * nullptr if the range is out of the file or cannot be mapped.
+     */
+    inline const unsigned char* viewAt(itl::file::MappedFile* file, itl::uint64_t offset, itl::size_t length)
+    {
+        if (offset > file->fileSize || length > file->fileSize - offset)
+            return nullptr;
+
+        if (file->mapping == nullptr || offset < file->mappingOffset
+            || offset - file->mappingOffset + length > file->mappingSize) {
+            if (mapWindow(file, offset) != 0 || file->mapping == nullptr)
+                return nullptr;
+
+            // The window starts at a page boundary, so a range close to the
+            // budget may still end past it.
+            if (offset - file->mappingOffset + length > file->mappingSize)
+                return nullptr;
+        }
+
+        return (const unsigned char*)file->mapping + (offset - file->mappingOffset);
+    }
+}; // namespace file
+} // namespace itl
+
+#endif // _ITL_IO_MAPPING_HPP
@@ -0,0 +1,495 @@
+/**
+ * @file include/io/print.hpp
+ * @brief Provides buffered formatted output for the ITL library.
+ * @category Input/Output
+ *
+ * This header defines print functions that format integers, floats and
+ * strings into a buffer owned by the calling thread and write it out with
+ * a single system call, either when enough output accumulated or when
+ * flushed explicitly. Format strings use {} placeholders and are checked
+ * at compile time against the types of the arguments, so a mismatched
+ * placeholder or a missing argument fails the build instead of the
+ * program. Formatting never allocates memory.
+ *
+ * @note These functions are only available on Linux systems on x86 and
+ * x86_64 architectures.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#ifndef _ITL_IO_PRINT_HPP
+#define _ITL_IO_PRINT_HPP
+
+#include "typing/ctypes.hpp"
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace io {
+#define IO_BUFFER_SIZE 4096 ///< Size of the buffer of a writer.
+#define IO_FLUSH_THRESHOLD 3072 ///< Buffered bytes after which the standard output is flushed.
+#define IO_MAX_WIDTH 255 ///< Largest field width of a placeholder.
+#define IO_MAX_FLOAT_PRECISION 9 ///< Largest number of decimals of a float.
+#define IO_DEFAULT_FLOAT_PRECISION 6 ///< Decimals of a float without an explicit precision.
+
+    /**
+     * @enum ArgumentType
+     * @brief Describes how a formatted argument is stored and printed.
+     */
+    typedef enum {
+        ARGUMENT_NONE, ///< A type that cannot be formatted.
+        ARGUMENT_BOOLEAN, ///< Printed as true or false.
+        ARGUMENT_CHARACTER, ///< Printed as a single character.
+        ARGUMENT_SIGNED, ///< A signed integer.
+        ARGUMENT_UNSIGNED, ///< An unsigned integer.
+        ARGUMENT_FLOAT, ///< A float or a double.
+        ARGUMENT_STRING, ///< A null-terminated or sized string.
+        ARGUMENT_POINTER ///< An address, printed in hexadecimal.
+    } ArgumentType;
+
+    /**
+     * @struct StringView
+     * @brief A string of known length, not necessarily null-terminated.
+     */
+    typedef struct {
+        const char* data; ///< First character.
+        itl::size_t length; ///< Number of characters.
+    } StringView;
+
+    /**
+     * @struct Argument
+     * @brief A formatted argument, with its type erased.
+     */
+    typedef struct {
+        ArgumentType type; ///< Kind of the stored value.
+        union {
+            itl::int64_t signedValue; ///< Value of ARGUMENT_SIGNED, ARGUMENT_BOOLEAN and ARGUMENT_CHARACTER.
+            itl::uint64_t unsignedValue; ///< Value of ARGUMENT_UNSIGNED.
+            double floatValue; ///< Value of ARGUMENT_FLOAT.
+            const void* pointer; ///< Value of ARGUMENT_POINTER.
+            itl::io::StringView string; ///< Value of ARGUMENT_STRING; a length of -1 means null-terminated.
+        };
+    } Argument;
+
+    /**
+     * @struct FormatSpec
+     * @brief The options of a placeholder, written as {[<][0][width][.precision][type]}.
+     */
+    typedef struct {
+        unsigned width; ///< Minimum number of characters, padded with spaces or zeros.
+        int precision; ///< Decimals of a float or maximum length of a string, or -1.
+        char type; ///< x, X or b for integers, f or e for floats, s for strings, or 0.
+        bool zeroPad; ///< Pad numbers with zeros after the sign.
+        bool leftAlign; ///< Pad on the right instead of the left.
+    } FormatSpec;
+
+    /**
+     * @struct Writer
+     * @brief A buffer of formatted output bound to a file descriptor.
+     */
+    typedef struct {
+        int fileDescriptor; ///< Destination of the output.
+        bool ready; ///< Whether the writer was initialized.
+        itl::size_t length; ///< Number of buffered bytes.
+        itl::size_t threshold; ///< Buffered bytes after which a print flushes, 0 to flush every print.
+        char buffer[IO_BUFFER_SIZE]; ///< Buffered output.
+    } Writer;
+
+    /**
+     * @brief Wraps a type so that it is not deduced from an argument.
+     */
+    template <typename T>
+    struct TypeIdentity {
+        typedef T Type;
+    };
+
+    /**
+     * @brief Maps the type of an argument to the way it is formatted.
+     */
+    template <typename T>
+    struct ArgumentTraits {
+        static constexpr ArgumentType type = ARGUMENT_NONE;
+    };
+
+    template <typename T>
+    struct ArgumentTraits<T*> {
+        static constexpr ArgumentType type = ARGUMENT_POINTER;
+    };
+
+#define IO_ARGUMENT_TRAITS(T, kind)                   \
+    template <>                                       \
+    struct ArgumentTraits<T> {                        \
+        static constexpr ArgumentType type = kind;    \
+    };
+
+    IO_ARGUMENT_TRAITS(bool, ARGUMENT_BOOLEAN)
+    IO_ARGUMENT_TRAITS(char, ARGUMENT_CHARACTER)
+    IO_ARGUMENT_TRAITS(signed char, ARGUMENT_SIGNED)
+    IO_ARGUMENT_TRAITS(short, ARGUMENT_SIGNED)
+    IO_ARGUMENT_TRAITS(int, ARGUMENT_SIGNED)
+    IO_ARGUMENT_TRAITS(long, ARGUMENT_SIGNED)
+    IO_ARGUMENT_TRAITS(long long, ARGUMENT_SIGNED)
+    IO_ARGUMENT_TRAITS(unsigned char, ARGUMENT_UNSIGNED)
+    IO_ARGUMENT_TRAITS(unsigned short, ARGUMENT_UNSIGNED)
+    IO_ARGUMENT_TRAITS(unsigned int, ARGUMENT_UNSIGNED)
+    IO_ARGUMENT_TRAITS(unsigned long, ARGUMENT_UNSIGNED)
+    IO_ARGUMENT_TRAITS(unsigned long long, ARGUMENT_UNSIGNED)
+    IO_ARGUMENT_TRAITS(float, ARGUMENT_FLOAT)
+    IO_ARGUMENT_TRAITS(double, ARGUMENT_FLOAT)
+    IO_ARGUMENT_TRAITS(char*, ARGUMENT_STRING)
+    IO_ARGUMENT_TRAITS(const char*, ARGUMENT_STRING)
+    IO_ARGUMENT_TRAITS(itl::io::StringView, ARGUMENT_STRING)
+#undef IO_ARGUMENT_TRAITS
+
+    /**
+     * @brief Parses the options of a placeholder.
+     *
+     * The same parser validates format strings at compile time and reads
+     * them at run time, so both always agree on the grammar.
+     *
+     * @param text The format string.
+     * @param length The length of the format string.
+     * @param position The index right after the opening brace, advanced
+     * past the closing brace.
+     * @param spec Receives the options.
+     * @return true if the placeholder is well formed.
+     */
+    constexpr bool parseSpec(const char* text, itl::size_t length, itl::size_t* position, itl::io::FormatSpec* spec)
+    {
+        itl::size_t index = *position;
+
+        spec->width = 0;
+        spec->precision = -1;
+        spec->type = 0;
+        spec->zeroPad = false;
+        spec->leftAlign = false;
+
+        if (index < length && text[index] == '<') {
+            spec->leftAlign = true;
+            ++index;
+        }
+
+        if (index < length && text[index] == '0') {
+            spec->zeroPad = true;
+            ++index;
+        }
+
+        while (index < length && text[index] >= '0' && text[index] <= '9') {
+            spec->width = spec->width * 10 + (unsigned)(text[index++] - '0');
+
+            if (spec->width > IO_MAX_WIDTH)
+                return false;
+        }
+
+        if (index < length && text[index] == '.') {
+            ++index;
+
+            if (index >= length || text[index] < '0' || text[index] > '9')
+                return false;
+
+            spec->precision = 0;
+
+            while (index < length && text[index] >= '0' && text[index] <= '9') {
+                spec->precision = spec->precision * 10 + (text[index++] - '0');
+
+                if (spec->precision > IO_MAX_WIDTH)
+                    return false;
+            }
+        }
+
+        if (index < length && text[index] != '}') {
+            char type = text[index++];
+
+            if (type != 'x' && type != 'X' && type != 'b' && type != 'f' && type != 'e' && type != 's')
+                return false;
+
+            spec->type = type;
+        }
+
+        if (index >= length || text[index] != '}')
+            return false;
+
+        *position = index + 1;
+        return true;
+    }
+
+    /**
+     * @brief Checks that the options of a placeholder suit an argument.
+     *
+     * @return true if an argument of the given type can be printed with
+     * the options.
+     */
+    constexpr bool isSpecAllowed(itl::io::ArgumentType type, const itl::io::FormatSpec& spec)
+    {
+        bool integer = type == ARGUMENT_SIGNED || type == ARGUMENT_UNSIGNED;
+
+        if (spec.precision >= 0) {
+            if (type == ARGUMENT_FLOAT)
+                return spec.precision <= IO_MAX_FLOAT_PRECISION && (spec.type == 0 || spec.type == 'f' || spec.type == 'e');
+
+            if (type != ARGUMENT_STRING)
+                return false;
+        }
+
+        switch (spec.type) {
+        case 0:
+            return true;
+        case 'x':
+        case 'X':
+        case 'b':
+            return integer || (spec.type == 'x' && type == ARGUMENT_POINTER);
+        case 'f':
+        case 'e':
+            return type == ARGUMENT_FLOAT;
+        case 's':
+            return type == ARGUMENT_STRING;
+        default:
+            return false;
+        }
+    }
+
+    /*
+     * The functions below are declared but never defined. Reaching one of
+     * them while a format string is checked at compile time makes the
+     * constant evaluation fail, and their names tell what is wrong.
+     */
+    void formatStringHasUnmatchedBrace();
+    void formatStringHasInvalidPlaceholder();
+    void formatStringHasTooFewArguments();
+    void formatStringHasTooManyArguments();
+    void formatArgumentTypeIsNotPrintable();
+    void formatPlaceholderDoesNotMatchArgumentType();
+
+    /**
+     * @class FormatString
+     * @brief A format string checked at compile time against the types of
+     * its arguments.
+     *
+     * Every {} consumes the next argument; {{ and }} print a literal brace.
+     * The constructor is consteval, so format strings must be string
+     * literals and every error is reported by the compiler.
+     *
+     * @tparam Arguments The types of the formatted arguments.
+     */
+    template <typename... Arguments>
+    class FormatString {
+    public:
+        /**
+         * @brief Checks a format string literal.
+         *
+         * @param literal The format string.
+         */
+        template <itl::size_t N>
+        consteval FormatString(const char (&literal)[N])
+            : text(literal)
+            , length(N - 1)
+        {
+            constexpr ArgumentType types[sizeof...(Arguments) + 1] = { ArgumentTraits<Arguments>::type..., ARGUMENT_NONE };
+            itl::size_t argument = 0;
+            itl::size_t index = 0;
+
+            for (itl::size_t current = 0; current < sizeof...(Arguments); ++current) {
+                if (types[current] == ARGUMENT_NONE)
+                    formatArgumentTypeIsNotPrintable();
+            }
+
+            while (index < length) {
+                char character = text[index++];
+
+                if (character == '}') {
+                    if (index >= length || text[index] != '}')
+                        formatStringHasUnmatchedBrace();
+
+                    ++index;
+                    continue;
+                }
+
+                if (character != '{')
+                    continue;
+
+                if (index < length && text[index] == '{') {
+                    ++index;
+                    continue;
+                }
+
+                FormatSpec spec;
+
+                if (!parseSpec(text, length, &index, &spec))
+                    formatStringHasInvalidPlaceholder();
+
+                if (argument >= sizeof...(Arguments))
+                    formatStringHasTooFewArguments();
+
+                if (!isSpecAllowed(types[argument], spec))
+                    formatPlaceholderDoesNotMatchArgumentType();
+
+                ++argument;
+            }
+
+            if (argument != sizeof...(Arguments))
+                formatStringHasTooManyArguments();
+        }
+
+        const char* text; ///< The format string.
+        itl::size_t length; ///< The length of the format string.
+    };
+
+    /**
+     * @brief Erases the type of an argument.
+     *
+     * @param value The argument.
+     * @return The argument, tagged with its ArgumentType.
+     */
+    template <typename T>
+    inline itl::io::Argument makeArgument(T value)
+    {
+        constexpr ArgumentType type = ArgumentTraits<T>::type;
+        itl::io::Argument argument;
+
+        static_assert(type != ARGUMENT_NONE, "itl::io cannot format arguments of this type");
+
+        argument.type = type;
+
+        if constexpr (type == ARGUMENT_SIGNED || type == ARGUMENT_BOOLEAN || type == ARGUMENT_CHARACTER)
+            argument.signedValue = (itl::int64_t)value;
+        else if constexpr (type == ARGUMENT_UNSIGNED)
+            argument.unsignedValue = (itl::uint64_t)value;
+        else if constexpr (type == ARGUMENT_FLOAT)
+            argument.floatValue = (double)value;
+        else if constexpr (type == ARGUMENT_POINTER)
+            argument.pointer = (const void*)value;
+        else
+            argument.string = { value, (itl::size_t)-1 };
+
+        return argument;
+    }
+
+    /**
+     * @brief Erases the type of a sized string.
+     */
+    inline itl::io::Argument makeArgument(itl::io::StringView value)
+    {
+        itl::io::Argument argument;
+
+        argument.type = ARGUMENT_STRING;
+        argument.string = value;
+
+        return argument;
+    }
+
+    /**
+     * @brief Binds a writer to a file descriptor.
+     *
+     * @param writer The writer to initialize.
+     * @param fileDescriptor The destination of the output.
+     * @param threshold Buffered bytes after which a print flushes, or 0 to
+     * flush at the end of every print.
+     */
+    void initializeWriter(itl::io::Writer* writer, int fileDescriptor, itl::size_t threshold);
+
+    /**
+     * @brief Returns the standard output writer of the calling thread.
+     *
+     * It flushes once IO_FLUSH_THRESHOLD bytes are buffered. Output still
+     * buffered when a thread exits is lost, so threads call flush() before
+     * they exit.
+     */
+    itl::io::Writer* getOutput();
+
+    /**
+     * @brief Returns the standard error writer of the calling thread,
+     * which flushes at the end of every print.
+     */
+    itl::io::Writer* getErrorOutput();
+
+    /**
+     * @brief Formats type-erased arguments into a writer.
+     *
+     * This is the engine behind every print function; the format string
+     * must already be valid.
+     *
+     * @param writer The writer.
+     * @param format The format string.
+     * @param length The length of the format string.
+     * @param arguments The arguments, in order.
+     * @param newline Whether to end the output with a line feed.
+     */
+    void writeFormatted(itl::io::Writer* writer, const char* format, itl::size_t length, const itl::io::Argument* arguments, bool newline);
+
+    /**
+     * @brief Writes every buffered byte of a writer.
+     *
+     * @param writer The writer.
+     */
+    void flush(itl::io::Writer* writer);
+
+    /**
+     * @brief Flushes the standard output and error writers of the calling
+     * thread.
+     */
+    void flush();
+
+    /**
+     * @brief Formats arguments into a writer.
+     *
+     * @param writer The writer.
+     * @param format The format string, checked at compile time.
+     * @param arguments The arguments.
+     */
+    template <typename... Arguments>
+    inline void printTo(itl::io::Writer* writer, itl::io::FormatString<typename TypeIdentity<Arguments>::Type...> format, Arguments... arguments)
+    {
+        const itl::io::Argument erased[sizeof...(Arguments) + 1] = { makeArgument(arguments)..., itl::io::Argument() };
+
+        writeFormatted(writer, format.text, format.length, erased, false);
+    }
+
+    /**
+     * @brief Formats arguments into a writer, followed by a line feed.
+     */
+    template <typename... Arguments>
+    inline void printlnTo(itl::io::Writer* writer, itl::io::FormatString<typename TypeIdentity<Arguments>::Type...> format, Arguments... arguments)
+    {
+        const itl::io::Argument erased[sizeof...(Arguments) + 1] = { makeArgument(arguments)..., itl::io::Argument() };
+
+        writeFormatted(writer, format.text, format.length, erased, true);
+    }
+
+    /**
+     * @brief Formats arguments to the standard output.
+     *
+     * @param format The format string, checked at compile time.
+     * @param arguments The arguments.
+     */
+    template <typename... Arguments>
+    inline void print(itl::io::FormatString<typename TypeIdentity<Arguments>::Type...> format, Arguments... arguments)
+    {
+        printTo<Arguments...>(getOutput(), format, arguments...);
+    }
+
+    /**
+     * @brief Formats arguments to the standard output, followed by a line
+     * feed.
+     */
+    template <typename... Arguments>
+    inline void println(itl::io::FormatString<typename TypeIdentity<Arguments>::Type...> format, Arguments... arguments)
+    {
+        printlnTo<Arguments...>(getOutput(), format, arguments...);
+    }
+
+    /**
+     * @brief Formats arguments to the standard error, followed by a line
+     * feed.
+     */
+    template <typename... Arguments>
+    inline void eprintln(itl::io::FormatString<typename TypeIdentity<Arguments>::Type...> format, Arguments... arguments)
+    {
+        printlnTo<Arguments...>(getErrorOutput(), format, arguments...);
+    }
+}; // namespace io
+} // namespace itl
+
+#endif // _ITL_IO_PRINT_HPP
@@ -0,0 +1,479 @@
+/**
+ * @file include/io/uring.hpp
+ * @brief Provides an io_uring engine for asynchronous file I/O.
+ * @category Input/Output
+ *
+ * This header defines a thin engine over the io_uring interface of the
+ * kernel. Requests are written into a submission ring shared with the
+ * kernel and published in batches with a single system call, and their
+ * results are read from a completion ring by polling, so thousands of
+ * reads can be in flight without a thread per request. Buffers and files
+ * can be registered once to avoid mapping and reference counting them on
+ * every request.
+ *
+ * @note These functions are only available on Linux 5.1 and later.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#ifndef _ITL_IO_URING_HPP
+#define _ITL_IO_URING_HPP
+
+#include "system/syscalls.hpp"
+#include "typing/ctypes.hpp"
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace file {
+// Setup flags
+#define IORING_SETUP_IOPOLL (1U << 0) ///< Busy-poll for completions of O_DIRECT files.
+#define IORING_SETUP_SQPOLL (1U << 1) ///< A kernel thread polls the submission ring.
+#define IORING_SETUP_SQ_AFF (1U << 2) ///< Pin the polling thread to sqThreadCpu.
+#define IORING_SETUP_CQSIZE (1U << 3) ///< Use completionEntries as the completion ring size.
+#define IORING_SETUP_CLAMP (1U << 4) ///< Clamp ring sizes to the maximum.
+#define IORING_SETUP_COOP_TASKRUN (1U << 8) ///< Run completion work only on kernel transitions.
+#define IORING_SETUP_SINGLE_ISSUER (1U << 12) ///< Only one thread submits requests.
+
+// Features reported by the kernel
+#define IORING_FEAT_SINGLE_MMAP (1U << 0) ///< Both rings share a single mapping.
+#define IORING_FEAT_NODROP (1U << 1) ///< Completions are never dropped.
+
+// Mapping offsets
+#define IORING_OFF_SQ_RING 0ULL ///< Offset of the submission ring.
+#define IORING_OFF_CQ_RING 0x8000000ULL ///< Offset of the completion ring.
+#define IORING_OFF_SQES 0x10000000ULL ///< Offset of the submission entries.
+
+// Operations
+#define IORING_OP_NOP 0 ///< Does nothing, completes immediately.
+#define IORING_OP_READV 1 ///< Reads into a vector of buffers.
+#define IORING_OP_WRITEV 2 ///< Writes from a vector of buffers.
+#define IORING_OP_FSYNC 3 ///< Flushes a file to storage.
+#define IORING_OP_READ_FIXED 4 ///< Reads into a registered buffer.
+#define IORING_OP_WRITE_FIXED 5 ///< Writes from a registered buffer.
+#define IORING_OP_CLOSE 19 ///< Closes a file descriptor.
+#define IORING_OP_READ 22 ///< Reads into a buffer.
+#define IORING_OP_WRITE 23 ///< Writes from a buffer.
+
+// Submission entry flags
+#define IOSQE_FIXED_FILE (1U << 0) ///< The descriptor is an index in the registered files.
+#define IOSQE_IO_DRAIN (1U << 1) ///< Start after every earlier request completed.
+#define IOSQE_IO_LINK (1U << 2) ///< Start the next request after this one completes.
+#define IOSQE_ASYNC (1U << 4) ///< Always run the request asynchronously.
+
+// Submission ring flags
+#define IORING_SQ_NEED_WAKEUP (1U << 0) ///< The polling thread sleeps and needs a wakeup.
+#define IORING_SQ_CQ_OVERFLOW (1U << 1) ///< Completions overflowed the completion ring.
+
+// Enter flags
+#define IORING_ENTER_GETEVENTS (1U << 0) ///< Wait for minimumComplete completions.
+#define IORING_ENTER_SQ_WAKEUP (1U << 1) ///< Wake the polling thread.
+
+// Registration operations
+#define IORING_REGISTER_BUFFERS 0 ///< Registers buffers for fixed reads and writes.
+#define IORING_UNREGISTER_BUFFERS 1 ///< Releases the registered buffers.
+#define IORING_REGISTER_FILES 2 ///< Registers a table of file descriptors.
+#define IORING_UNREGISTER_FILES 3 ///< Releases the registered files.
+#define IORING_REGISTER_FILES_UPDATE 6 ///< Replaces part of the registered files.
+
+#define URING_DEFAULT_ENTRIES 256 ///< Submission entries used when none are requested.
+
+    /**
+     * @struct SubmissionRingOffsets
+     * @brief Offsets of the fields of the submission ring in its mapping.
+     */
+    typedef struct {
+        itl::uint32_t head; ///< Index of the next entry the kernel consumes.
+        itl::uint32_t tail; ///< Index of the next entry the application fills.
+        itl::uint32_t ringMask; ///< Mask turning an index into a slot.
+        itl::uint32_t ringEntries; ///< Number of slots.
+        itl::uint32_t flags; ///< Ring flags (e.g., IORING_SQ_NEED_WAKEUP).
+        itl::uint32_t dropped; ///< Number of invalid entries skipped.
+        itl::uint32_t array; ///< Array mapping slots to submission entries.
+        itl::uint32_t reserved; ///< Reserved.
+        itl::uint64_t userAddress; ///< Reserved for user-provided rings.
+    } SubmissionRingOffsets;
+
+    /**
+     * @struct CompletionRingOffsets
+     * @brief Offsets of the fields of the completion ring in its mapping.
+     */
+    typedef struct {
+        itl::uint32_t head; ///< Index of the next completion the application reads.
+        itl::uint32_t tail; ///< Index of the next completion the kernel posts.
+        itl::uint32_t ringMask; ///< Mask turning an index into a slot.
+        itl::uint32_t ringEntries; ///< Number of slots.
+        itl::uint32_t overflow; ///< Number of completions lost to overflow.
+        itl::uint32_t completions; ///< Array of completion entries.
+        itl::uint32_t flags; ///< Ring flags.
+        itl::uint32_t reserved; ///< Reserved.
+        itl::uint64_t userAddress; ///< Reserved for user-provided rings.
+    } CompletionRingOffsets;
+
+    /**
+     * @struct RingParameters
+     * @brief Parameters exchanged with the io_uring_setup system call.
+     */
+    typedef struct {
+        itl::uint32_t submissionEntries; ///< Number of submission entries.
+        itl::uint32_t completionEntries; ///< Number of completion entries.
+        itl::uint32_t flags; ///< Setup flags (e.g., IORING_SETUP_SQPOLL).
+        itl::uint32_t sqThreadCpu; ///< CPU of the polling thread, with IORING_SETUP_SQ_AFF.
+        itl::uint32_t sqThreadIdle; ///< Idle time before the polling thread sleeps, in milliseconds.
+        itl::uint32_t features; ///< Features supported by the kernel.
+        itl::uint32_t workQueueDescriptor; ///< Ring whose workers are shared.
+        itl::uint32_t reserved[3]; ///< Reserved.
+        itl::file::SubmissionRingOffsets submissionOffsets; ///< Layout of the submission ring.
+        itl::file::CompletionRingOffsets completionOffsets; ///< Layout of the completion ring.
+    } RingParameters;
+
+    /**
+     * @struct SubmissionEntry
+     * @brief A request, as read by the kernel from the submission ring.
+     */
+    typedef struct {
+        itl::uint8_t opcode; ///< Operation (e.g., IORING_OP_READ).
+        itl::uint8_t flags; ///< Entry flags (e.g., IOSQE_FIXED_FILE).
+        itl::uint16_t priority; ///< I/O priority.
+        itl::int32_t fileDescriptor; ///< File descriptor, or index of a registered file.
+        itl::uint64_t offset; ///< Offset in the file.
+        itl::uint64_t address; ///< Address of the buffer or buffer vector.
+        itl::uint32_t length; ///< Length of the buffer, or number of vectors.
+        itl::uint32_t operationFlags; ///< Flags specific to the operation.
+        itl::uint64_t userData; ///< Value copied to the completion.
+        itl::uint16_t bufferIndex; ///< Index of the registered buffer of fixed operations.
+        itl::uint16_t personality; ///< Credentials to use.
+        itl::int32_t spliceDescriptor; ///< Extra descriptor of some operations.
+        itl::uint64_t extra[2]; ///< Extra fields of some operations.
+    } SubmissionEntry;
+
+    /**
+     * @struct CompletionEntry
+     * @brief The result of a request, as posted by the kernel.
+     */
+    typedef struct {
+        itl::uint64_t userData; ///< Value given in the submission entry.
+        itl::int32_t result; ///< Result of the operation, or a negated errno value.
+        itl::uint32_t flags; ///< Completion flags.
+    } CompletionEntry;
+
+    /**
+     * @struct Ring
+     * @brief An io_uring instance and the rings it shares with the kernel.
+     *
+     * A ring is not thread-safe: one thread submits requests and reaps
+     * completions, and other threads use their own rings.
+     */
+    typedef struct {
+        int ringDescriptor; ///< File descriptor of the instance.
+        itl::uint32_t flags; ///< Setup flags.
+        itl::uint32_t features; ///< Features supported by the kernel.
+        itl::uint32_t* submissionHead; ///< Head of the submission ring, advanced by the kernel.
+        itl::uint32_t* submissionTail; ///< Tail of the submission ring, advanced by the application.
+        itl::uint32_t* submissionFlags; ///< Flags of the submission ring.
+        itl::uint32_t submissionMask; ///< Mask of the submission ring.
+        itl::uint32_t submissionEntries; ///< Number of submission entries.
+        itl::uint32_t queuedTail; ///< Tail including the entries not published yet.
+        itl::uint32_t publishedTail; ///< Tail last published to the kernel.
+        itl::file::SubmissionEntry* entries; ///< Submission entries.
+        itl::uint32_t* completionHead; ///< Head of the completion ring, advanced by the application.
+        itl::uint32_t* completionTail; ///< Tail of the completion ring, advanced by the kernel.
+        itl::uint32_t completionMask; ///< Mask of the completion ring.
+        itl::uint32_t completionEntries; ///< Number of completion entries.
+        itl::file::CompletionEntry* completions; ///< Completion entries.
+        void* submissionMapping; ///< Mapping of the submission ring.
+        itl::size_t submissionMappingSize; ///< Size of the submission ring mapping.
+        void* completionMapping; ///< Mapping of the completion ring, or the submission one.
+        itl::size_t completionMappingSize; ///< Size of the completion ring mapping.
+        itl::size_t entriesMappingSize; ///< Size of the submission entries mapping.
+    } Ring;
+
+    /**
+     * @brief Creates an io_uring instance and maps its rings.
+     *
+     * @param ring The ring to initialize.
+     * @param entries The number of submission entries, rounded up to a
+     * power of two by the kernel, or 0 for URING_DEFAULT_ENTRIES.
+     * @param flags Setup flags (e.g., IORING_SETUP_SQPOLL).
+     * @return 0 on success, or a negated errno value on failure.
+     */
+    int createRing(itl::file::Ring* ring, itl::uint32_t entries, itl::uint32_t flags);
+
+    /**
+     * @brief Unmaps the rings and closes the instance.
+     *
+     * Requests still in flight are cancelled by the kernel.
+     *
+     * @param ring The ring to destroy.
+     */
+    void destroyRing(itl::file::Ring* ring);
+
+    /**
+     * @brief Takes the next free submission entry.
+     *
+     * The entry is cleared and queued; it reaches the kernel with the next
+     * submit().
+     *
+     * @param ring The ring to take the entry from.
+     * @return The entry, or nullptr if the submission ring is full.
+     */
+    inline itl::file::SubmissionEntry* getSubmission(itl::file::Ring* ring)
+    {
+        itl::uint32_t head = __atomic_load_n(ring->submissionHead, __ATOMIC_ACQUIRE);
+
+        if (ring->queuedTail - head >= ring->submissionEntries)
+            return nullptr;
+
+        itl::file::SubmissionEntry* entry = &ring->entries[ring->queuedTail & ring->submissionMask];
+        itl::uint64_t* words = (itl::uint64_t*)entry;
+
+        for (itl::size_t index = 0; index < sizeof(itl::file::SubmissionEntry) / sizeof(itl::uint64_t); ++index)
+            words[index] = 0;
+
+        ring->queuedTail++;
+
+        return entry;
+    }
+
+    /**
+     * @brief Fills an entry with an operation on a buffer.
+     *
+     * @param entry The entry to fill.
+     * @param opcode The operation.
+     * @param fileDescriptor The file descriptor, or registered file index.
+     * @param address The buffer, or buffer vector.
+     * @param length The length of the buffer, or number of vectors.
+     * @param offset The offset in the file.
+     * @param userData The value returned with the completion.
+     */
+    inline void prepare(itl::file::SubmissionEntry* entry, itl::uint8_t opcode, int fileDescriptor,
+        const void* address, itl::uint32_t length, itl::uint64_t offset, itl::uint64_t userData)
+    {
+        entry->opcode = opcode;
+        entry->fileDescriptor = fileDescriptor;
+        entry->address = (itl::uint64_t)(itl::uintptr_t)address;
+        entry->length = length;
+        entry->offset = offset;
+        entry->userData = userData;
+    }
+
+    /**
+     * @brief Prepares a read into a buffer.
+     */
+    inline void prepareRead(itl::file::SubmissionEntry* entry, int fileDescriptor, void* buffer,
+        itl::uint32_t length, itl::uint64_t offset, itl::uint64_t userData)
+    {
+        prepare(entry, IORING_OP_READ, fileDescriptor, buffer, length, offset, userData);
+    }
+
+    /**
+     * @brief Prepares a write from a buffer.
+     */
+    inline void prepareWrite(itl::file::SubmissionEntry* entry, int fileDescriptor, const void* buffer,
+        itl::uint32_t length, itl::uint64_t offset, itl::uint64_t userData)
+    {
+        prepare(entry, IORING_OP_WRITE, fileDescriptor, buffer, length, offset, userData);
+    }
+
+    /**
+     * @brief Prepares a read into a registered buffer.
+     *
+     * @param bufferIndex The index of the registered buffer that contains
+     * the destination range.
+     */
+    inline void prepareReadFixed(itl::file::SubmissionEntry* entry, int fileDescriptor, void* buffer,
+        itl::uint32_t length, itl::uint64_t offset, itl::uint16_t bufferIndex, itl::uint64_t userData)
+    {
+        prepare(entry, IORING_OP_READ_FIXED, fileDescriptor, buffer, length, offset, userData);
+        entry->bufferIndex = bufferIndex;
+    }
+
+    /**
+     * @brief Prepares a write from a registered buffer.
+     *
+     * @param bufferIndex The index of the registered buffer that contains
+     * the source range.
+     */
+    inline void prepareWriteFixed(itl::file::SubmissionEntry* entry, int fileDescriptor, const void* buffer,
+        itl::uint32_t length, itl::uint64_t offset, itl::uint16_t bufferIndex, itl::uint64_t userData)
+    {
+        prepare(entry, IORING_OP_WRITE_FIXED, fileDescriptor, buffer, length, offset, userData);
+        entry->bufferIndex = bufferIndex;
+    }
+
+    /**
+     * @brief Prepares a flush of a file to storage.
+     */
+    inline void prepareFsync(itl::file::SubmissionEntry* entry, int fileDescriptor, itl::uint64_t userData)
+    {
+        prepare(entry, IORING_OP_FSYNC, fileDescriptor, nullptr, 0, 0, userData);
+    }
+
+    /**
+     * @brief Prepares a request that completes immediately.
+     */
+    inline void prepareNop(itl::file::SubmissionEntry* entry, itl::uint64_t userData)
+    {
+        prepare(entry, IORING_OP_NOP, -1, nullptr, 0, 0, userData);
+    }
+
+    /**
+     * @brief Makes the descriptor of an entry an index in the registered
+     * files.
+     */
+    inline void useFixedFile(itl::file::SubmissionEntry* entry)
+    {
+        entry->flags |= IOSQE_FIXED_FILE;
+    }
+
+    /**
+     * @brief Publishes the queued entries to the kernel.
+     *
+     * Every queued entry the kernel has not consumed yet, including the
+     * ones left over by a failed or short earlier submission, is handed
+     * over with a single io_uring_enter. With IORING_SETUP_SQPOLL, the
+     * system call is only made to wake the polling thread when it sleeps.
+     *
+     * @param ring The ring to submit.
+     * @return The number of entries submitted, or a negated errno value on
+     * failure.
+     */
+    int submit(itl::file::Ring* ring);
+
+    /**
+     * @brief Publishes the queued entries and waits for completions, in a
+     * single system call.
+     *
+     * @param ring The ring to submit.
+     * @param waitCount The number of completions to wait for.
+     * @return The number of entries submitted, or a negated errno value on
+     * failure.
+     */
+    int submitAndWait(itl::file::Ring* ring, itl::uint32_t waitCount);
+
+    /**
+     * @brief Returns the oldest unread completion without any system call.
+     *
+     * The completion stays in the ring until it is marked as seen with
+     * advanceCompletions().
+     *
+     * @param ring The ring to poll.
+     * @return The completion, or nullptr if none is available.
+     */
+    inline itl::file::CompletionEntry* peekCompletion(itl::file::Ring* ring)
+    {
+        itl::uint32_t head = *ring->completionHead;
+        itl::uint32_t tail = __atomic_load_n(ring->completionTail, __ATOMIC_ACQUIRE);
+
+        if (head == tail)
+            return nullptr;
+
+        return &ring->completions[head & ring->completionMask];
+    }
+
+    /**
+     * @brief Collects up to count unread completions without any system
+     * call.
+     *
+     * @param ring The ring to poll.
+     * @param completions Receives pointers to the completions, oldest first.
+     * @param count The maximum number of completions to collect.
+     * @return The number of completions collected.
+     */
+    inline itl::uint32_t peekCompletions(itl::file::Ring* ring, itl::file::CompletionEntry** completions, itl::uint32_t count)
+    {
+        itl::uint32_t head = *ring->completionHead;
+        itl::uint32_t available = __atomic_load_n(ring->completionTail, __ATOMIC_ACQUIRE) - head;
+
+        if (available > count)
+            available = count;
+
+        for (itl::uint32_t index = 0; index < available; ++index)
+            completions[index] = &ring->completions[(head + index) & ring->completionMask];
+
+        return available;
+    }
+
+    /**
+     * @brief Marks the oldest completions as seen, freeing their slots.
+     *
+     * @param ring The ring whose completions were read.
+     * @param count The number of completions to release.
+     */
+    inline void advanceCompletions(itl::file::Ring* ring, itl::uint32_t count)
+    {
+        __atomic_store_n(ring->completionHead, *ring->completionHead + count, __ATOMIC_RELEASE);
+    }
+
+    /**
+     * @brief Returns the oldest completion, waiting in the kernel if none
+     * is available.
+     *
+     * @param ring The ring to wait on.
+     * @param completion Receives the completion.
+     * @return 0 on success, or a negated errno value on failure.
+     */
+    int waitCompletion(itl::file::Ring* ring, itl::file::CompletionEntry** completion);
+
+    /**
+     * @brief Registers buffers for fixed reads and writes.
+     *
+     * The kernel pins the pages of the buffers once, instead of on every
+     * request. A ring holds a single set of registered buffers.
+     *
+     * @param ring The ring to register the buffers with.
+     * @param buffers The buffers.
+     * @param count The number of buffers.
+     * @return 0 on success, or a negated errno value on failure.
+     */
+    int registerBuffers(itl::file::Ring* ring, const itl::linux::syscall::iovec_struct* buffers, itl::uint32_t count);
+
+    /**
+     * @brief Releases the registered buffers.
+     *
+     * @param ring The ring whose buffers are released.
+     * @return 0 on success, or a negated errno value on failure.
+     */
+    int unregisterBuffers(itl::file::Ring* ring);
+
+    /**
+     * @brief Registers a table of file descriptors.
+     *
+     * Requests flagged with useFixedFile() then name a file by its index in
+     * the table, which saves the kernel from looking up and reference
+     * counting the descriptor on every request. Entries set to -1 are
+     * empty slots that updateFiles() can fill later.
+     *
+     * @param ring The ring to register the files with.
+     * @param fileDescriptors The file descriptors.
+     * @param count The number of file descriptors.
+     * @return 0 on success, or a negated errno value on failure.
+     */
+    int registerFiles(itl::file::Ring* ring, const int* fileDescriptors, itl::uint32_t count);
+
+    /**
+     * @brief Replaces part of the registered files.
+     *
+     * @param ring The ring whose files are updated.
+     * @param offset The index of the first slot to replace.
+     * @param fileDescriptors The new file descriptors, or -1 to empty slots.
+     * @param count The number of slots to replace.
+     * @return The number of slots updated, or a negated errno value on
+     * failure.
+     */
+    int updateFiles(itl::file::Ring* ring, itl::uint32_t offset, const int* fileDescriptors, itl::uint32_t count);
+
+    /**
+     * @brief Releases the registered files.
+     *
+     * @param ring The ring whose files are released.
+     * @return 0 on success, or a negated errno value on failure.
+     */
+    int unregisterFiles(itl::file::Ring* ring);
+}; // namespace file
+} // namespace itl
+
+#endif // _ITL_IO_URING_HPP
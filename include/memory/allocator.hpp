@@ -13,6 +13,7 @@
 #ifndef _ITL_MEMORY_ALLOCATOR_HPP
 #define _ITL_MEMORY_ALLOCATOR_HPP
 
+#include "system/sync.hpp"
 #include "typing/ctypes.hpp"
 
 /**
@@ -21,50 +22,282 @@
  * custom STL components, allocators, types, and utilities.
  */
 namespace itl {
-#define MAX_CHUNKS 4096 ///< Maximum number of chunks per memory block.
 #define MAX_BLOCKS 4096 ///< Maximum number of memory blocks in the memory map.
 #define MIN_PAGE_SIZE 4096 ///< Minimum size of a memory page.
 #define MIN_CHUNK_SIZE 8 ///< Minimum size of a memory chunk.
+#define SIZE_CLASS_COUNT 53 ///< Number of segregated size classes.
+#define MAX_SMALL_SIZE 262144 ///< Largest request served from a size class.
+#define LARGE_CLASS SIZE_CLASS_COUNT ///< Size class index of dedicated large blocks.
+#define BLOCK_SHIFT 21 ///< Number of bits to shift for the block size.
+#define BLOCK_SIZE (1UL << BLOCK_SHIFT) ///< Size and alignment of every memory block.
+#define BLOCK_MASK (~(BLOCK_SIZE - 1)) ///< Mask giving the block header of a pointer.
+#define MAX_CHUNKS (BLOCK_SIZE / MIN_CHUNK_SIZE) ///< Maximum number of chunks per memory block.
+#define BLOCK_HEADER_ALIGNMENT 64 ///< Alignment of the first chunk after the block header.
+#define CACHE_BATCH_BYTES 32768 ///< Bytes moved between a thread cache and the central heap at once.
+#define MAX_CACHE_BATCH 32 ///< Maximum number of chunks moved in one batch.
+#define LARGE_INDEX_MIN_CAPACITY 1024 ///< Entries reserved by the large object index on first use.
+
+#ifndef ITL_ALLOCATOR_STATS
+#define ITL_ALLOCATOR_STATS 1 ///< Define as 0 to compile the allocator statistics out.
+#endif
+
+#ifndef ITL_ALLOCATOR_PROFILING
+#define ITL_ALLOCATOR_PROFILING 1 ///< Define as 0 to compile the heap profiler hooks out.
+#endif
+
+/**
+ * @enum HugePageMode
+ * @brief Selects how the allocator backs its blocks with huge pages.
+ */
+typedef enum {
+    HUGE_PAGES_DISABLED, ///< Blocks use regular pages only.
+    HUGE_PAGES_TRANSPARENT, ///< Blocks are advised with MADV_HUGEPAGE.
+    HUGE_PAGES_EXPLICIT ///< Blocks use MAP_HUGETLB, falling back to transparent huge pages.
+} HugePageMode;
+
+/**
+ * @enum MemoryBacking
+ * @brief Describes the pages that actually back a memory block.
+ */
+typedef enum {
+    BACKING_REGULAR, ///< Regular pages.
+    BACKING_TRANSPARENT, ///< Regular pages advised for transparent huge pages.
+    BACKING_COLLAPSED, ///< Transparent huge pages collapsed with MADV_COLLAPSE.
+    BACKING_HUGETLB ///< Pages taken from the hugetlb pool.
+} MemoryBacking;
+
+/**
+ * @struct HugePageConfig
+ * @brief Runtime tuning of the huge page backing of the allocator.
+ */
+typedef struct {
+    itl::HugePageMode mode; ///< How new blocks are backed.
+    bool collapse; ///< Whether advised blocks are collapsed synchronously with MADV_COLLAPSE.
+    itl::size_t minimumLargeSize; ///< Smallest large allocation that receives huge pages.
+} HugePageConfig;
+
+/**
+ * @struct HugePageStats
+ * @brief Amount of memory currently mapped by the allocator, by backing.
+ *
+ * Hugetlb and collapsed bytes are known to be backed by huge pages.
+ * Transparent bytes were only advised, so the kernel may still back them,
+ * or parts of them, with regular pages.
+ */
+typedef struct {
+    itl::size_t hugetlbBytes; ///< Bytes backed by hugetlb pages.
+    itl::size_t collapsedBytes; ///< Bytes collapsed into transparent huge pages.
+    itl::size_t transparentBytes; ///< Bytes advised for transparent huge pages.
+    itl::size_t hugetlbFallbacks; ///< Hugetlb mappings that failed and fell back.
+} HugePageStats;
 
 /**
- * @struct AllocationMetadata
- * @brief Metadata for a single memory allocation.
+ * @struct PurgeConfig
+ * @brief Runtime tuning of how the allocator returns unused memory.
  *
- * This structure tracks the state of a memory allocation, including
- * whether it is in use, its size, and a pointer to the allocated memory.
+ * Chunks returned to the central heap leave their pages dirty. A purge
+ * hands the pages that only hold free chunks back to the kernel and unmaps
+ * the empty blocks a size class does not need to keep.
  */
 typedef struct {
-    bool used; ///< Indicates whether the allocation is currently in use.
-    itl::size_t startPosition; ///< Start position of the memory page.
-    itl::size_t size; ///< The size of the allocated memory, in bytes.
-    void* pointerToAllocatedMemory; ///< A pointer to the allocated memory.
-} AllocationMetadata;
+    itl::size_t dirtyThreshold; ///< Dirty bytes that trigger a purge, or 0 to disable.
+    itl::size_t decayReturns; ///< Chunk returns after which a purge runs anyway, or 0 to disable.
+    itl::size_t retainedEmptyBlocks; ///< Empty blocks each size class keeps mapped.
+    int advice; ///< Advice used for free pages, MADV_FREE or MADV_DONTNEED.
+} PurgeConfig;
 
 /**
  * @struct MemoryBlock
  * @brief Represents a block of memory managed by the allocator.
  *
- * A memory block contains a base pointer, chunk size, total number of chunks,
- * and an array of allocation metadata for tracking individual allocations.
+ * Every block is mapped at a BLOCK_SIZE boundary and starts with this
+ * header, so the block that owns any pointer it hands out is found by
+ * masking the pointer with BLOCK_MASK. The header is followed by a bitmap
+ * holding one bit per chunk, set while the chunk is in use; the index of a
+ * chunk is derived from its distance to the base address. Chunks of a small
+ * block all belong to the same size class, while a large block holds a
+ * single allocation that may span many multiples of BLOCK_SIZE.
  */
-typedef struct {
-    void* base; ///< Base address of the memory block.
+typedef struct MemoryBlock {
+    void* base; ///< Base address of the first chunk.
     itl::size_t chunkSize; ///< Size of each chunk in the block, in bytes.
     itl::size_t totalChunks; ///< Total number of chunks in the block.
-    itl::AllocationMetadata* chunks[MAX_CHUNKS]; ///< Metadata for each chunk.
+    itl::size_t usedChunks; ///< Number of chunks currently handed out.
+    itl::size_t sizeClass; ///< Size class served by the block, or LARGE_CLASS.
+    itl::size_t mappedSize; ///< Bytes mapped for the block, header included.
+    itl::size_t searchHint; ///< First bitmap word that may hold a free chunk.
+    itl::size_t registryIndex; ///< Position of the block in the memory map.
+    itl::MemoryBacking backing; ///< Pages that back the block.
+    itl::size_t releasedChunks; ///< Chunks returned since the block was last purged.
+    struct MemoryBlock* nextPartial; ///< Next block of the class with free chunks.
+    struct MemoryBlock* previousPartial; ///< Previous block of the class with free chunks.
 } MemoryBlock;
 
+/**
+ * @struct SizeClass
+ * @brief Describes one segregated size class of the allocator.
+ *
+ * Each size class keeps a doubly linked list of the blocks that still have
+ * at least one free chunk, so a chunk can be found without scanning.
+ */
+typedef struct {
+    itl::size_t chunkSize; ///< Size of every chunk of the class, in bytes.
+    itl::size_t chunksPerBlock; ///< Number of chunks placed in a new block.
+    itl::size_t headerSize; ///< Size of the block header and bitmap, in bytes.
+    itl::MemoryBlock* partialBlocks; ///< Blocks of the class with free chunks.
+#if ITL_ALLOCATOR_STATS
+    itl::size_t probes; ///< Bitmap words inspected while searching for free chunks.
+#endif
+} SizeClass;
+
 /**
  * @struct MemoryMap
  * @brief Represents a map of memory blocks managed by the allocator.
  *
- * The memory map tracks multiple memory blocks and their count.
+ * The memory map tracks the small blocks and their count, together with the
+ * segregated size classes. It is the central heap shared by every thread
+ * and is guarded by a mutex; pointer lookups never consult it because the
+ * owning block is found by masking.
  */
 typedef struct {
     itl::MemoryBlock* blocks[MAX_BLOCKS]; ///< Array of pointers to memory blocks.
     itl::size_t blockCount; ///< Number of memory blocks currently in use.
+    itl::SizeClass classes[SIZE_CLASS_COUNT]; ///< Segregated size classes.
+    itl::size_t dirtyBytes; ///< Bytes of chunks returned since the last purge.
+    itl::size_t returnsSincePurge; ///< Chunks returned since the last purge.
+    itl::thread::Mutex lock; ///< Mutex guarding the central heap.
 } MemoryMap;
 
+/**
+ * @struct LargeObjectIndex
+ * @brief Address-ordered index of the blocks of the large object tier.
+ *
+ * Large blocks are aligned to BLOCK_SIZE, so each one is recorded by its
+ * block number, its address shifted right by BLOCK_SHIFT, which fits in 32
+ * bits on both architectures. The sorted entries are binary searched to
+ * find the large block that contains an arbitrary address. The array is
+ * mapped directly and grows with mremap.
+ */
+typedef struct {
+    itl::uint32_t* entries; ///< Block numbers of the large blocks, in ascending order.
+    itl::size_t count; ///< Number of large blocks.
+    itl::size_t capacity; ///< Number of entries the mapped array can hold.
+    itl::size_t mappedBytes; ///< Bytes mapped by the large blocks, headers included.
+    itl::size_t inPlaceResizes; ///< Resizes served by remapping at the same address.
+    itl::size_t movedResizes; ///< Resizes that moved the pages to another address.
+#if ITL_ALLOCATOR_STATS
+    itl::size_t allocations; ///< Large allocations made so far.
+    itl::size_t frees; ///< Large allocations released so far.
+#endif
+    itl::thread::Mutex lock; ///< Mutex guarding the index.
+} LargeObjectIndex;
+
+/**
+ * @struct LargeObjectStats
+ * @brief Snapshot of the large object tier.
+ */
+typedef struct {
+    itl::size_t count; ///< Number of live large allocations.
+    itl::size_t mappedBytes; ///< Bytes mapped for them, headers included.
+    itl::size_t inPlaceResizes; ///< Resizes served by remapping at the same address.
+    itl::size_t movedResizes; ///< Resizes that moved the pages without copying them.
+} LargeObjectStats;
+
+/**
+ * @struct CacheBin
+ * @brief Chunks of a single size class cached by a thread.
+ *
+ * Cached chunks are linked through their first word and remain marked as
+ * used in the bitmap of their block until they are returned to the central
+ * heap.
+ */
+typedef struct {
+    void* head; ///< Head of the intrusive list of cached chunks.
+    itl::size_t count; ///< Number of chunks on the list.
+} CacheBin;
+
+/**
+ * @struct ThreadStats
+ * @brief Counters updated by a single thread on the allocation fast path.
+ *
+ * Only the owning thread writes its counters, so they are plain loads and
+ * stores; readers sum the counters of every thread. A chunk freed by
+ * another thread than the one that allocated it is counted by the freeing
+ * thread, so only the sums are meaningful.
+ */
+typedef struct {
+    itl::size_t allocations[SIZE_CLASS_COUNT]; ///< Chunks handed out, by size class.
+    itl::size_t frees[SIZE_CLASS_COUNT]; ///< Chunks taken back, by size class.
+} ThreadStats;
+
+/**
+ * @struct ThreadCache
+ * @brief Per-thread front end of the allocator.
+ *
+ * Each thread allocates from and frees into its own bins without any
+ * synchronization. Empty bins are refilled from the central heap and
+ * overflowing bins are drained back to it in batches, so the central lock
+ * is taken once per batch rather than once per call. A chunk freed by a
+ * thread other than the one that allocated it simply joins the cache of
+ * the freeing thread and eventually flows back to the central heap.
+ *
+ * With statistics enabled, the cache joins a registry of live caches the
+ * first time its thread allocates or frees, so that its counters can be
+ * aggregated by getAllocatorStats().
+ */
+typedef struct ThreadCache {
+    itl::CacheBin bins[SIZE_CLASS_COUNT]; ///< Cached chunks of each size class.
+#if ITL_ALLOCATOR_STATS
+    itl::ThreadStats stats; ///< Counters of the owning thread.
+    struct ThreadCache* nextCache; ///< Next registered cache.
+    struct ThreadCache* previousCache; ///< Previous registered cache.
+    bool registered; ///< Whether the cache is in the registry.
+#endif
+#if ITL_ALLOCATOR_PROFILING
+    itl::size_t sampledBytes; ///< Bytes allocated since the last sample, wrapped into the sampling interval.
+#endif
+} ThreadCache;
+
+/**
+ * @struct SizeClassStats
+ * @brief Snapshot of the activity and footprint of one size class.
+ */
+typedef struct {
+    itl::size_t chunkSize; ///< Chunk size of the class, or 0 for the large object tier.
+    itl::size_t allocations; ///< Allocations served so far.
+    itl::size_t frees; ///< Allocations released so far.
+    itl::size_t bytesInUse; ///< Bytes of chunks currently held by the application.
+    itl::size_t bytesMapped; ///< Bytes mapped for the blocks of the class.
+    itl::size_t blocks; ///< Blocks currently mapped for the class.
+    itl::size_t probes; ///< Bitmap words inspected while searching for free chunks.
+    double fragmentation; ///< Share of the mapped bytes not in use, between 0 and 1.
+} SizeClassStats;
+
+/**
+ * @struct SystemCallStats
+ * @brief Number of memory management system calls issued by the allocator.
+ */
+typedef struct {
+    itl::size_t mmapCalls; ///< Calls to mmap.
+    itl::size_t munmapCalls; ///< Calls to munmap.
+    itl::size_t mremapCalls; ///< Calls to mremap.
+    itl::size_t madviseCalls; ///< Calls to madvise.
+} SystemCallStats;
+
+/**
+ * @struct AllocatorStats
+ * @brief Snapshot of the allocator statistics.
+ */
+typedef struct {
+    itl::SizeClassStats classes[SIZE_CLASS_COUNT]; ///< Statistics of each size class.
+    itl::SizeClassStats large; ///< Statistics of the large object tier.
+    itl::SystemCallStats systemCalls; ///< System calls issued so far.
+    itl::size_t bytesInUse; ///< Bytes currently held by the application.
+    itl::size_t bytesMapped; ///< Bytes currently mapped by the allocator.
+    double fragmentation; ///< Share of the mapped bytes not in use, between 0 and 1.
+    itl::size_t threads; ///< Threads whose caches are registered.
+} AllocatorStats;
+
 /**
  * @struct AllocationSearch
  * @brief Represents the result of a memory allocation search.
@@ -74,19 +307,39 @@ typedef struct {
  */
 typedef struct {
     itl::MemoryBlock* block; ///< Pointer to the memory block where the allocation was found.
-    itl::size_t index; ///< Index in the list of chunks of the block.
+    itl::size_t index; ///< Index of the free chunk in the bitmap of the block.
     bool found; ///< Indicates whether a suitable allocation was found.
 } AllocationSearch;
 
 /**
  * @brief Allocates a block of memory of the specified size.
  *
+ * Requests up to MAX_SMALL_SIZE bytes are served in constant time from the
+ * matching size class; larger requests form the large object tier and
+ * receive a dedicated mapping, recorded in the large object index.
+ *
  * @param size The size of the memory block to allocate, in bytes.
  * @return A pointer to the allocated memory block, or nullptr if
- * the allocation fails.
+ * the allocation fails or size is zero.
  */
 void* alloc(itl::size_t size);
 
+/**
+ * @brief Allocates a block of memory aligned to a power-of-two boundary.
+ *
+ * Alignments up to MIN_PAGE_SIZE are served from the first size class
+ * whose chunks are naturally aligned to them, so aligned requests keep the
+ * constant-time path of alloc(). Larger alignments, or sizes above
+ * MAX_SMALL_SIZE, receive a dedicated block.
+ *
+ * @param size The size of the memory block to allocate, in bytes.
+ * @param alignment The alignment of the block, a power of two smaller
+ * than BLOCK_SIZE.
+ * @return A pointer to the aligned memory block, or nullptr if the
+ * allocation fails, size is zero or the alignment is not supported.
+ */
+void* allocAligned(itl::size_t size, itl::size_t alignment);
+
 /**
  * @brief Allocates memory for an array and initializes it to zero.
  *
@@ -100,6 +353,10 @@ void* calloc(itl::size_t number, itl::size_t size);
 /**
  * @brief Reallocates a previously allocated memory block to a new size.
  *
+ * The block is resized in place as long as the new size falls in the same
+ * size class. Large blocks grow and shrink by remapping their pages with
+ * mremap, in place when possible, so their content is never copied.
+ *
  * @param pointerToMemory A pointer to the memory block to reallocate.
  * @param newSize The new size of the memory block, in bytes.
  * @return A pointer to the reallocated memory block, or nullptr
@@ -107,6 +364,18 @@ void* calloc(itl::size_t number, itl::size_t size);
  */
 void* realloc(void* pointerToMemory, itl::size_t newSize);
 
+/**
+ * @brief Returns the number of bytes usable in an allocation.
+ *
+ * This is the size of the chunk for small allocations and the rest of the
+ * mapping for large ones, so it is at least the requested size. Growing
+ * the allocation with realloc() up to this size never moves it.
+ *
+ * @param pointerToMemory A pointer returned by the allocator, or nullptr.
+ * @return The usable size, in bytes, or 0 for nullptr.
+ */
+itl::size_t usableSize(const void* pointerToMemory);
+
 /**
  * @brief Frees a previously allocated memory block.
  *
@@ -114,6 +383,132 @@ void* realloc(void* pointerToMemory, itl::size_t newSize);
  * If the pointer is nullptr, no operation is performed.
  */
 void free(void* pointerToMemory);
+
+/**
+ * @brief Frees a memory block whose size is known to the caller.
+ *
+ * The size class is derived from the size, so the header of the owning
+ * block is not read. The size must be the one last passed to alloc(),
+ * calloc() (as the product of its arguments) or realloc() for this block;
+ * memory obtained from allocAligned() must be released with free().
+ *
+ * @param pointerToMemory A pointer to the memory block to free.
+ * If the pointer is nullptr, no operation is performed.
+ * @param size The size that was requested for the block, in bytes.
+ */
+void freeSized(void* pointerToMemory, itl::size_t size);
+
+/**
+ * @brief Maps zero-filled pages directly from the system.
+ *
+ * The pages bypass the size classes and are meant as backing storage for
+ * other memory managers, such as arenas and pools.
+ *
+ * @param size The size of the mapping, in bytes, rounded up to the page size.
+ * @return A pointer to the page-aligned mapping, or nullptr on failure.
+ */
+void* allocPages(itl::size_t size);
+
+/**
+ * @brief Returns pages obtained from allocPages to the system.
+ *
+ * @param pointerToMemory The start of the mapping.
+ * @param size The size that was passed to allocPages, in bytes.
+ */
+void freePages(void* pointerToMemory, itl::size_t size);
+
+/**
+ * @brief Finds the large allocation that contains an address.
+ *
+ * The address may point anywhere inside the allocation. Only allocations
+ * above MAX_SMALL_SIZE, or with a dedicated block from allocAligned(), are
+ * tracked by the large object index.
+ *
+ * @param address The address to look up.
+ * @return The start of the large allocation containing the address, or
+ * nullptr if there is none.
+ */
+void* findLargeAllocation(const void* address);
+
+/**
+ * @brief Reads the state of the large object tier.
+ *
+ * @param stats Receives the statistics.
+ */
+void getLargeObjectStats(itl::LargeObjectStats* stats);
+
+/**
+ * @brief Takes a snapshot of the allocator statistics.
+ *
+ * Per-thread counters are summed with the counters of the threads that
+ * already released their cache. The snapshot is not atomic with respect
+ * to concurrent allocations, but every counter is read consistently.
+ * Chunks held in thread caches count as mapped but not in use. When the
+ * library is built with ITL_ALLOCATOR_STATS set to 0, every field is zero.
+ *
+ * @param stats Receives the statistics.
+ */
+void getAllocatorStats(itl::AllocatorStats* stats);
+
+/**
+ * @brief Returns every chunk cached by the calling thread to the central heap.
+ *
+ * Threads must call this function before they exit, otherwise the chunks
+ * held in their cache can no longer be reused by other threads. With
+ * statistics enabled, it also folds the counters of the thread into the
+ * global totals and removes its cache from the registry.
+ */
+void releaseThreadCache();
+
+/**
+ * @brief Returns unused memory of the central heap to the kernel.
+ *
+ * Pages that only hold free chunks are released with the configured advice
+ * and empty blocks beyond PurgeConfig::retainedEmptyBlocks are unmapped.
+ * Chunks held in thread caches are still in use and are not affected, so
+ * call releaseThreadCache() first to include those of the calling thread.
+ *
+ * @return The number of bytes returned to the kernel.
+ */
+itl::size_t purge();
+
+/**
+ * @brief Changes when the allocator purges unused memory on its own.
+ *
+ * @param config The new configuration.
+ */
+void setPurgeConfig(const itl::PurgeConfig* config);
+
+/**
+ * @brief Reads the current purge configuration.
+ *
+ * @param config Receives the configuration.
+ */
+void getPurgeConfig(itl::PurgeConfig* config);
+
+/**
+ * @brief Changes how new blocks are backed with huge pages.
+ *
+ * Blocks that are already mapped keep their backing; the configuration
+ * applies to every block mapped afterwards.
+ *
+ * @param config The new configuration.
+ */
+void setHugePageConfig(const itl::HugePageConfig* config);
+
+/**
+ * @brief Reads the current huge page configuration.
+ *
+ * @param config Receives the configuration.
+ */
+void getHugePageConfig(itl::HugePageConfig* config);
+
+/**
+ * @brief Reads how much memory is currently backed by huge pages.
+ *
+ * @param stats Receives the statistics.
+ */
+void getHugePageStats(itl::HugePageStats* stats);
 } // namespace itl
 
 #endif // _ITL_MEMORY_ALLOCATOR_HPP
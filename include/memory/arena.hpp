@@ -0,0 +1,192 @@
+/**
+ * @file include/memory/arena.hpp
+ * @brief Provides bump-pointer memory arenas for the ITL library.
+ * @category Memory Management
+ *
+ * This header defines an arena allocator for short-lived objects. Memory is
+ * handed out by bumping a pointer through page-backed chunks, and is only
+ * given back all at once, either by rewinding to a checkpoint or by
+ * releasing the whole arena.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#ifndef _ITL_MEMORY_ARENA_HPP
+#define _ITL_MEMORY_ARENA_HPP
+
+#include "typing/ctypes.hpp"
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace arena {
+#define ARENA_DEFAULT_CHUNK_SIZE 65536 ///< Default size of an arena chunk.
+#define ARENA_DEFAULT_ALIGNMENT 16 ///< Alignment used when none is requested.
+
+    /**
+     * @struct ArenaChunk
+     * @brief Header placed at the start of every chunk of an arena.
+     *
+     * Chunks form a list from the newest to the oldest one, and the usable
+     * memory of a chunk starts right after its header.
+     */
+    typedef struct ArenaChunk {
+        struct ArenaChunk* previous; ///< Chunk that was current before this one.
+        itl::size_t size; ///< Size of the chunk mapping, header included.
+    } ArenaChunk;
+
+    /**
+     * @struct Arena
+     * @brief A bump-pointer arena.
+     *
+     * Allocation only moves position forward inside the current chunk; a
+     * new chunk is mapped when the current one is exhausted. The most
+     * recently released chunk is kept as a spare, so code that repeatedly
+     * rewinds across a chunk boundary does not map and unmap on every turn.
+     */
+    typedef struct {
+        itl::arena::ArenaChunk* current; ///< Chunk allocations are served from.
+        itl::arena::ArenaChunk* spare; ///< Released chunk kept for reuse.
+        unsigned char* position; ///< Next free byte of the current chunk.
+        unsigned char* end; ///< End of the current chunk.
+        itl::size_t chunkSize; ///< Size of the chunks mapped by the arena.
+    } Arena;
+
+    /**
+     * @struct Checkpoint
+     * @brief A saved allocation state of an arena.
+     *
+     * Rewinding to a checkpoint releases everything allocated after it.
+     * Checkpoints can be nested, but an arena must be rewound to them in
+     * the reverse order they were taken.
+     */
+    typedef struct {
+        itl::arena::ArenaChunk* chunk; ///< Chunk that was current.
+        unsigned char* position; ///< Position in that chunk.
+    } Checkpoint;
+
+    /**
+     * @brief Initializes an empty arena. No memory is mapped until the
+     * first allocation.
+     *
+     * @param arena The arena to initialize.
+     * @param chunkSize The size of the chunks the arena maps, or 0 for
+     * ARENA_DEFAULT_CHUNK_SIZE.
+     */
+    void create(itl::arena::Arena* arena, itl::size_t chunkSize);
+
+    /**
+     * @brief Allocates memory when the current chunk cannot serve a request.
+     *
+     * This is the slow path of alloc() and should not be called directly.
+     *
+     * @param arena The arena to allocate from.
+     * @param size The size of the allocation, in bytes.
+     * @param alignment The alignment of the allocation, a power of two.
+     * @return A pointer to the allocated memory, or nullptr on failure.
+     */
+    void* allocFromNewChunk(itl::arena::Arena* arena, itl::size_t size, itl::size_t alignment);
+
+    /**
+     * @brief Allocates memory from an arena.
+     *
+     * The memory is not initialized and cannot be freed on its own.
+     *
+     * @param arena The arena to allocate from.
+     * @param size The size of the allocation, in bytes.
+     * @param alignment The alignment of the allocation, a power of two.
+     * @return A pointer to the allocated memory, or nullptr on failure.
+     */
+    inline void* alloc(itl::arena::Arena* arena, itl::size_t size, itl::size_t alignment = ARENA_DEFAULT_ALIGNMENT)
+    {
+        itl::uintptr_t aligned = ((itl::uintptr_t)arena->position + alignment - 1) & ~(itl::uintptr_t)(alignment - 1);
+
+        if (arena->position == nullptr || aligned > (itl::uintptr_t)arena->end || size > (itl::uintptr_t)arena->end - aligned)
+            return allocFromNewChunk(arena, size, alignment);
+
+        arena->position = (unsigned char*)aligned + size;
+
+        return (void*)aligned;
+    }
+
+    /**
+     * @brief Saves the current allocation state of an arena.
+     *
+     * @param arena The arena to save.
+     * @return A checkpoint that can later be passed to rewind().
+     */
+    inline itl::arena::Checkpoint checkpoint(const itl::arena::Arena* arena)
+    {
+        return (itl::arena::Checkpoint) {
+            .chunk = arena->current,
+            .position = arena->position
+        };
+    }
+
+    /**
+     * @brief Releases everything allocated since a checkpoint.
+     *
+     * Chunks mapped after the checkpoint are unmapped, except for one that
+     * is kept as a spare.
+     *
+     * @param arena The arena to rewind.
+     * @param checkpoint A checkpoint taken on the same arena.
+     */
+    void rewind(itl::arena::Arena* arena, itl::arena::Checkpoint checkpoint);
+
+    /**
+     * @brief Releases every allocation of an arena but keeps one chunk
+     * mapped for the allocations that follow.
+     *
+     * @param arena The arena to reset.
+     */
+    void reset(itl::arena::Arena* arena);
+
+    /**
+     * @brief Releases every allocation and unmaps all the chunks of an arena.
+     *
+     * The arena is left empty and can be used again.
+     *
+     * @param arena The arena to release.
+     */
+    void release(itl::arena::Arena* arena);
+
+    /**
+     * @class Scope
+     * @brief Rewinds an arena to the state it had when the scope was entered.
+     *
+     * Scopes nest naturally, so request handlers can allocate freely and
+     * have everything released when they return.
+     */
+    class Scope {
+    public:
+        /**
+         * @brief Takes a checkpoint of an arena.
+         *
+         * @param arena The arena to rewind when the scope ends.
+         */
+        explicit Scope(itl::arena::Arena* arena)
+            : arena(arena)
+            , saved(itl::arena::checkpoint(arena))
+        {
+        }
+
+        /**
+         * @brief Rewinds the arena to the checkpoint taken on construction.
+         */
+        ~Scope() { itl::arena::rewind(arena, saved); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        itl::arena::Arena* arena; ///< Arena rewound by the scope.
+        itl::arena::Checkpoint saved; ///< State restored by the scope.
+    };
+}; // namespace arena
+} // namespace itl
+
+#endif // _ITL_MEMORY_ARENA_HPP
@@ -0,0 +1,56 @@
+/**
+ * @file include/memory/placement.hpp
+ * @brief Provides placement new for the ITL library.
+ * @category Memory Management
+ *
+ * The ITL is built without the C++ standard library, so the placement forms
+ * of operator new and operator delete, normally declared by <new>, are
+ * provided here. They let generic code construct objects in memory obtained
+ * from the ITL allocators.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#ifndef _ITL_MEMORY_PLACEMENT_HPP
+#define _ITL_MEMORY_PLACEMENT_HPP
+
+// Skip the definitions when a standard <new> was already included.
+#if !defined(_NEW) && !defined(_LIBCPP_NEW)
+/**
+ * @brief Constructs an object in already allocated memory.
+ *
+ * @param size The size of the object, in bytes.
+ * @param pointerToMemory The memory to construct the object in.
+ * @return pointerToMemory.
+ */
+inline void* operator new(decltype(sizeof(0)) size, void* pointerToMemory) noexcept
+{
+    (void)size;
+    return pointerToMemory;
+}
+
+/**
+ * @brief Constructs an array in already allocated memory.
+ *
+ * @param size The size of the array, in bytes.
+ * @param pointerToMemory The memory to construct the array in.
+ * @return pointerToMemory.
+ */
+inline void* operator new[](decltype(sizeof(0)) size, void* pointerToMemory) noexcept
+{
+    (void)size;
+    return pointerToMemory;
+}
+
+/**
+ * @brief Matching deallocation function of placement new. Does nothing.
+ */
+inline void operator delete(void*, void*) noexcept { }
+
+/**
+ * @brief Matching deallocation function of placement new[]. Does nothing.
+ */
+inline void operator delete[](void*, void*) noexcept { }
+#endif // !_NEW && !_LIBCPP_NEW
+
+#endif // _ITL_MEMORY_PLACEMENT_HPP
@@ -0,0 +1,407 @@
+/**
+ * @file include/memory/pool.hpp
+ * @brief Provides typed object pools for the ITL library.
+ * @category Memory Management
+ *
+ * This header defines a fixed-size object pool. Objects are carved from
+ * page-backed slabs and recycled through a lock-free free list, so threads
+ * can acquire and release objects concurrently without taking any lock.
+ * Optional per-thread magazines batch the traffic to the shared list.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#ifndef _ITL_MEMORY_POOL_HPP
+#define _ITL_MEMORY_POOL_HPP
+
+#include "memory/allocator.hpp"
+#include "memory/placement.hpp"
+#include "typing/ctypes.hpp"
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace pool {
+#define POOL_SLAB_SIZE 65536 ///< Minimum size of a pool slab.
+#define POOL_MIN_SLAB_SLOTS 8 ///< Minimum number of slots per slab.
+#define POOL_MAGAZINE_SIZE 64 ///< Number of slots a magazine can hold.
+
+    /**
+     * @class Pool
+     * @brief A pool of fixed-size slots for objects of type T.
+     *
+     * Free slots form a Treiber stack whose head packs the address of the
+     * top slot with a tag that is incremented by every successful update.
+     * A thread that read a stale head fails to install it again, even if
+     * the same slot was popped and pushed back in the meantime, as long as
+     * fewer updates than the range of the tag happened in between. The tag
+     * uses the 16 bits above the 48-bit user address space on x86_64, so
+     * it wraps after 65536 updates, and the upper 32 bits of the 64-bit
+     * head on x86. A thread stalled between its read and its
+     * compare-and-swap for exactly a multiple of that many updates, with
+     * the same slot on top again, would still hit the ABA problem.
+     *
+     * Slabs are never unmapped while the pool lives, so reading the link of
+     * a slot that another thread just took is always safe; the tag then
+     * makes the compare-and-swap fail.
+     *
+     * @tparam T The type of the pooled objects.
+     */
+    template <typename T>
+    class Pool {
+    public:
+        class Magazine;
+
+        /**
+         * @brief Creates an empty pool. No memory is mapped until the first
+         * acquisition.
+         */
+        Pool()
+            : head(0)
+            , slabs(nullptr)
+            , growing(0)
+        {
+        }
+
+        /**
+         * @brief Unmaps every slab of the pool.
+         *
+         * Objects that are still acquired are not destroyed.
+         */
+        ~Pool()
+        {
+            while (slabs != nullptr) {
+                Slab* slab = slabs;
+
+                slabs = slab->next;
+                itl::freePages(slab, slab->size);
+            }
+        }
+
+        Pool(const Pool&) = delete;
+        Pool& operator=(const Pool&) = delete;
+
+        /**
+         * @brief Takes an uninitialized slot from the pool.
+         *
+         * @return A pointer to a slot able to hold a T, or nullptr if no
+         * memory is left.
+         */
+        void* allocate()
+        {
+            while (true) {
+                itl::uint64_t current = __atomic_load_n(&head, __ATOMIC_ACQUIRE);
+                FreeSlot* slot = pointerOf(current);
+
+                if (slot == nullptr) {
+                    if (!grow())
+                        return nullptr;
+
+                    continue;
+                }
+
+                FreeSlot* next = __atomic_load_n(&slot->next, __ATOMIC_RELAXED);
+
+                if (__atomic_compare_exchange_n(&head, &current, pack(next, current),
+                        true, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+                    return slot;
+            }
+        }
+
+        /**
+         * @brief Returns a slot to the pool.
+         *
+         * @param slot A slot obtained from allocate(), or nullptr.
+         */
+        void deallocate(void* slot)
+        {
+            if (slot != nullptr)
+                pushChain((FreeSlot*)slot, (FreeSlot*)slot);
+        }
+
+        /**
+         * @brief Takes a slot from the pool and constructs a T in it.
+         *
+         * @param arguments The arguments forwarded to the constructor of T.
+         * @return A pointer to the new object, or nullptr if no memory is left.
+         */
+        template <typename... Arguments>
+        T* acquire(Arguments&&... arguments)
+        {
+            void* slot = allocate();
+
+            if (slot == nullptr)
+                return nullptr;
+
+            return new (slot) T(static_cast<Arguments&&>(arguments)...);
+        }
+
+        /**
+         * @brief Destroys an object and returns its slot to the pool.
+         *
+         * @param object An object obtained from acquire(), or nullptr.
+         */
+        void release(T* object)
+        {
+            if (object == nullptr)
+                return;
+
+            object->~T();
+            deallocate(object);
+        }
+
+    private:
+        /**
+         * @struct FreeSlot
+         * @brief Link stored in a slot while it is on the free list.
+         */
+        struct FreeSlot {
+            FreeSlot* next; ///< Next free slot.
+        };
+
+        /**
+         * @struct Slab
+         * @brief Header placed at the start of every slab.
+         */
+        struct Slab {
+            Slab* next; ///< Previously mapped slab.
+            itl::size_t size; ///< Size of the slab mapping, header included.
+        };
+
+        static constexpr itl::size_t slotAlignment = alignof(T) > alignof(FreeSlot) ? alignof(T) : alignof(FreeSlot);
+        static constexpr itl::size_t slotSize = ((sizeof(T) > sizeof(FreeSlot) ? sizeof(T) : sizeof(FreeSlot)) + slotAlignment - 1) & ~(slotAlignment - 1);
+        static constexpr itl::size_t slabHeaderSize = (sizeof(Slab) + slotAlignment - 1) & ~(slotAlignment - 1);
+        static constexpr unsigned tagShift = sizeof(void*) == 8 ? 48 : 32;
+        static constexpr itl::uint64_t pointerMask = ((itl::uint64_t)1 << tagShift) - 1;
+
+        /**
+         * @brief Extracts the slot address from a packed head.
+         */
+        static FreeSlot* pointerOf(itl::uint64_t packed)
+        {
+            return (FreeSlot*)(itl::uintptr_t)(packed & pointerMask);
+        }
+
+        /**
+         * @brief Packs a slot address with the successor of the tag of a head.
+         */
+        static itl::uint64_t pack(FreeSlot* slot, itl::uint64_t previous)
+        {
+            return (itl::uint64_t)(itl::uintptr_t)slot | (((previous >> tagShift) + 1) << tagShift);
+        }
+
+        /**
+         * @brief Pushes a chain of linked slots onto the free list at once.
+         *
+         * @param first The first slot of the chain.
+         * @param last The last slot of the chain, whose link is overwritten.
+         */
+        void pushChain(FreeSlot* first, FreeSlot* last)
+        {
+            itl::uint64_t current = __atomic_load_n(&head, __ATOMIC_RELAXED);
+
+            do {
+                __atomic_store_n(&last->next, pointerOf(current), __ATOMIC_RELAXED);
+            } while (!__atomic_compare_exchange_n(&head, &current, pack(first, current),
+                true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+        }
+
+        /**
+         * @brief Maps a new slab and pushes all its slots onto the free list.
+         *
+         * Only one thread grows the pool at a time; the others wait for it
+         * and then retry their acquisition.
+         *
+         * @return false if the slab could not be mapped.
+         */
+        bool grow()
+        {
+            if (__atomic_exchange_n(&growing, 1, __ATOMIC_ACQUIRE) != 0) {
+                while (__atomic_load_n(&growing, __ATOMIC_ACQUIRE) != 0)
+                    __builtin_ia32_pause();
+
+                return true;
+            }
+
+            bool grown = true;
+
+            if (pointerOf(__atomic_load_n(&head, __ATOMIC_ACQUIRE)) == nullptr) {
+                itl::size_t size = slabHeaderSize + POOL_MIN_SLAB_SLOTS * slotSize;
+                Slab* slab;
+
+                if (size < POOL_SLAB_SIZE)
+                    size = POOL_SLAB_SIZE;
+
+                slab = (Slab*)itl::allocPages(size);
+
+                if (slab != nullptr) {
+                    itl::size_t slots = (size - slabHeaderSize) / slotSize;
+                    unsigned char* first = (unsigned char*)slab + slabHeaderSize;
+
+                    slab->size = size;
+                    slab->next = slabs;
+                    slabs = slab;
+
+                    for (itl::size_t index = 0; index + 1 < slots; ++index)
+                        ((FreeSlot*)(first + index * slotSize))->next = (FreeSlot*)(first + (index + 1) * slotSize);
+
+                    pushChain((FreeSlot*)first, (FreeSlot*)(first + (slots - 1) * slotSize));
+                } else {
+                    grown = false;
+                }
+            }
+
+            __atomic_store_n(&growing, 0, __ATOMIC_RELEASE);
+
+            return grown;
+        }
+
+        itl::uint64_t head; ///< Packed top of the free list and its tag.
+        Slab* slabs; ///< Slabs mapped by the pool, newest first.
+        int growing; ///< Set while a thread maps a new slab.
+    };
+
+    /**
+     * @class Pool::Magazine
+     * @brief A private cache of slots in front of a pool.
+     *
+     * A magazine belongs to a single thread. It serves acquisitions and
+     * releases from a local array, takes slots from the pool when it runs
+     * empty and hands half of its slots back in a single update of the free
+     * list when it runs full. Slots acquired through a magazine may be
+     * released through any other magazine of the same pool, or directly to
+     * the pool.
+     *
+     * @tparam T The type of the pooled objects.
+     */
+    template <typename T>
+    class Pool<T>::Magazine {
+    public:
+        /**
+         * @brief Creates an empty magazine in front of a pool.
+         *
+         * @param pool The pool the magazine takes slots from.
+         */
+        explicit Magazine(itl::pool::Pool<T>* pool)
+            : pool(pool)
+            , count(0)
+        {
+        }
+
+        /**
+         * @brief Returns every cached slot to the pool.
+         */
+        ~Magazine() { flush(); }
+
+        Magazine(const Magazine&) = delete;
+        Magazine& operator=(const Magazine&) = delete;
+
+        /**
+         * @brief Takes an uninitialized slot, from the magazine if possible.
+         *
+         * @return A pointer to a slot able to hold a T, or nullptr if no
+         * memory is left.
+         */
+        void* allocate()
+        {
+            if (count == 0) {
+                while (count < POOL_MAGAZINE_SIZE / 2) {
+                    void* slot = pool->allocate();
+
+                    if (slot == nullptr)
+                        break;
+
+                    slots[count++] = slot;
+                }
+
+                if (count == 0)
+                    return nullptr;
+            }
+
+            return slots[--count];
+        }
+
+        /**
+         * @brief Returns a slot to the magazine, spilling half of it to the
+         * pool when it is full.
+         *
+         * @param slot A slot obtained from the same pool, or nullptr.
+         */
+        void deallocate(void* slot)
+        {
+            if (slot == nullptr)
+                return;
+
+            if (count == POOL_MAGAZINE_SIZE)
+                spill(POOL_MAGAZINE_SIZE / 2);
+
+            slots[count++] = slot;
+        }
+
+        /**
+         * @brief Takes a slot and constructs a T in it.
+         *
+         * @param arguments The arguments forwarded to the constructor of T.
+         * @return A pointer to the new object, or nullptr if no memory is left.
+         */
+        template <typename... Arguments>
+        T* acquire(Arguments&&... arguments)
+        {
+            void* slot = allocate();
+
+            if (slot == nullptr)
+                return nullptr;
+
+            return new (slot) T(static_cast<Arguments&&>(arguments)...);
+        }
+
+        /**
+         * @brief Destroys an object and keeps its slot in the magazine.
+         *
+         * @param object An object obtained from the same pool, or nullptr.
+         */
+        void release(T* object)
+        {
+            if (object == nullptr)
+                return;
+
+            object->~T();
+            deallocate(object);
+        }
+
+        /**
+         * @brief Returns every cached slot to the pool.
+         */
+        void flush() { spill(count); }
+
+    private:
+        /**
+         * @brief Links the topmost cached slots and pushes them to the pool.
+         *
+         * @param number The number of slots to return.
+         */
+        void spill(itl::size_t number)
+        {
+            if (number == 0)
+                return;
+
+            FreeSlot* first = (FreeSlot*)slots[count - number];
+
+            for (itl::size_t index = count - number; index + 1 < count; ++index)
+                ((FreeSlot*)slots[index])->next = (FreeSlot*)slots[index + 1];
+
+            pool->pushChain(first, (FreeSlot*)slots[count - 1]);
+            count -= number;
+        }
+
+        itl::pool::Pool<T>* pool; ///< Pool the magazine takes slots from.
+        itl::size_t count; ///< Number of cached slots.
+        void* slots[POOL_MAGAZINE_SIZE]; ///< Cached slots.
+    };
+}; // namespace pool
+} // namespace itl
+
+#endif // _ITL_MEMORY_POOL_HPP
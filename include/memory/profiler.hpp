@@ -0,0 +1,198 @@
+/**
+ * @file include/memory/profiler.hpp
+ * @brief Provides a sampling heap profiler for the ITL allocator.
+ * @category Memory Management
+ *
+ * This header defines a profiler that attributes the memory handed out by
+ * the allocator to the call stacks that requested it. Each thread samples
+ * one allocation every time it crosses a multiple of the sampling interval
+ * in allocated bytes, records the return addresses of its frame pointer
+ * chain, and pushes the sample into a lock-free ring. The samples are
+ * folded into per-stack totals that can be written out as a heap profile.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#ifndef _ITL_MEMORY_PROFILER_HPP
+#define _ITL_MEMORY_PROFILER_HPP
+
+#include "typing/ctypes.hpp"
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace profiler {
+#define PROFILE_DEFAULT_INTERVAL 524288 ///< Default number of allocated bytes between two samples.
+#define PROFILE_MAX_FRAMES 32 ///< Return addresses recorded per sample.
+#define PROFILE_MAX_FRAME_SIZE 262144 ///< Largest distance between two frame pointers the stack walk follows.
+#define PROFILE_RING_CAPACITY 1024 ///< Samples the ring holds before they are folded into the stack table.
+#define PROFILE_SITE_CAPACITY 4096 ///< Distinct call stacks the profiler tells apart, a power of two.
+#define PROFILE_LIVE_CAPACITY 16384 ///< Sampled allocations tracked until they are freed, a power of two.
+#define PROFILE_MAX_PROBES 16 ///< Slots of the live table searched for one address.
+
+    /**
+     * @enum SampleKind
+     * @brief Tells what a sample in the ring records.
+     */
+    typedef enum {
+        SAMPLE_ALLOCATION, ///< A sampled allocation, with its call stack.
+        SAMPLE_FREE ///< The release of a sampled allocation.
+    } SampleKind;
+
+    /**
+     * @struct ProfileSample
+     * @brief One entry of the sample ring.
+     *
+     * A sample stands for weight bytes of allocations made from the same
+     * call stack, which is the sampling interval times the number of
+     * interval boundaries the allocation crossed.
+     */
+    typedef struct {
+        itl::profiler::SampleKind kind; ///< What the sample records.
+        itl::uint64_t stackHash; ///< Hash of the return addresses, never 0.
+        itl::size_t size; ///< Bytes requested by the sampled allocation.
+        itl::size_t weight; ///< Bytes of allocations the sample stands for.
+        itl::size_t depth; ///< Number of recorded return addresses.
+        bool tracked; ///< Whether the release of the allocation will be seen.
+        void* frames[PROFILE_MAX_FRAMES]; ///< Return addresses, innermost first. Only set for allocations.
+    } ProfileSample;
+
+    /**
+     * @struct ProfileSite
+     * @brief Totals of the samples taken from one call stack.
+     */
+    typedef struct {
+        itl::uint64_t stackHash; ///< Hash of the return addresses, or 0 for an unused slot.
+        itl::size_t depth; ///< Number of return addresses.
+        void* frames[PROFILE_MAX_FRAMES]; ///< Return addresses, innermost first.
+        itl::size_t allocatedObjects; ///< Estimated allocations made so far.
+        itl::size_t allocatedBytes; ///< Estimated bytes allocated so far.
+        itl::size_t liveObjects; ///< Estimated allocations not freed yet.
+        itl::size_t liveBytes; ///< Estimated bytes not freed yet.
+    } ProfileSite;
+
+    /**
+     * @struct LiveSample
+     * @brief A sampled allocation that was not freed yet.
+     */
+    typedef struct {
+        itl::uintptr_t address; ///< Address of the allocation, or an empty or deleted marker.
+        itl::uint64_t stackHash; ///< Call stack of the allocation.
+        itl::size_t size; ///< Bytes requested.
+        itl::size_t weight; ///< Bytes the sample stands for.
+    } LiveSample;
+
+    /**
+     * @struct ProfileStats
+     * @brief Snapshot of the activity of the profiler.
+     */
+    typedef struct {
+        itl::size_t interval; ///< Current sampling interval, or 0 when sampling is off.
+        itl::size_t samples; ///< Allocations sampled so far.
+        itl::size_t frees; ///< Sampled allocations freed so far.
+        itl::size_t droppedSamples; ///< Samples lost because the ring was full.
+        itl::size_t untrackedSamples; ///< Samples whose release cannot be seen, the live table being full.
+        itl::size_t sites; ///< Distinct call stacks recorded.
+        itl::size_t allocatedBytes; ///< Estimated bytes allocated since profiling started.
+        itl::size_t liveBytes; ///< Estimated bytes currently held by the application.
+    } ProfileStats;
+
+    /**
+     * @brief Shared state read by the allocator on every call.
+     *
+     * Both words stay zero until profiling starts, so the allocator only
+     * pays for one load and one branch per call while it is off.
+     */
+    typedef struct {
+        itl::size_t interval; ///< Bytes between two samples, or 0 when sampling is off.
+        itl::size_t liveSamples; ///< Sampled allocations not freed yet.
+    } SamplerState;
+
+    extern itl::profiler::SamplerState internalSampler;
+
+    /**
+     * @brief Starts sampling allocations, or changes the interval.
+     *
+     * The ring and tables are mapped on the first call and kept for the
+     * life of the process, so totals accumulate across stops and restarts.
+     * The interval may be changed while profiling is on; the bytes each
+     * thread carries towards its next sample are wrapped into the new one.
+     * Call stacks are found by following frame pointers, so the library
+     * and the application should be built with -fno-omit-frame-pointer.
+     *
+     * @param interval The number of bytes each thread allocates between
+     * two samples, or 0 for PROFILE_DEFAULT_INTERVAL.
+     * @return 0 on success, or -ENOMEM if the tables could not be mapped.
+     */
+    int startProfiling(itl::size_t interval);
+
+    /**
+     * @brief Stops sampling allocations.
+     *
+     * Allocations that were already sampled are still tracked until they
+     * are freed, so the live totals stay correct.
+     */
+    void stopProfiling();
+
+    /**
+     * @brief Writes the heap profile to a file.
+     *
+     * The file is in the text format of gperftools heap profiles, with the
+     * estimated live and allocated totals of every call stack followed by
+     * the memory map of the process, so pprof can symbolize it.
+     *
+     * @param path The file to create or truncate.
+     * @return 0 on success, -EINVAL if profiling never started, or the
+     * negated errno of openat.
+     */
+    int dumpHeapProfile(const char* path);
+
+    /**
+     * @brief Writes the heap profile to an open file descriptor.
+     *
+     * @param fileDescriptor The destination of the profile.
+     * @return 0 on success, or -EINVAL if profiling never started.
+     */
+    int writeHeapProfile(int fileDescriptor);
+
+    /**
+     * @brief Takes a snapshot of the profiler statistics.
+     *
+     * Pending samples are folded into the totals first.
+     *
+     * @param stats Receives the statistics.
+     */
+    void getProfileStats(itl::profiler::ProfileStats* stats);
+
+    /**
+     * @brief Records a sampled allocation. Called by the allocator.
+     *
+     * @param pointerToMemory The allocation.
+     * @param size The bytes requested.
+     * @param weight The bytes the sample stands for.
+     */
+    void recordAllocation(void* pointerToMemory, itl::size_t size, itl::size_t weight);
+
+    /**
+     * @brief Records the release of an allocation if it was sampled.
+     * Called by the allocator before the memory is reused.
+     *
+     * @param pointerToMemory The allocation.
+     */
+    void recordFree(void* pointerToMemory);
+
+    /**
+     * @brief Moves the record of a sampled allocation to a new address.
+     * Called by the allocator when realloc() remaps a large allocation.
+     *
+     * @param oldPointer The previous address.
+     * @param newPointer The new address.
+     */
+    void recordMove(void* oldPointer, void* newPointer);
+}; // namespace profiler
+} // namespace itl
+
+#endif // _ITL_MEMORY_PROFILER_HPP
\ No newline at end of file
@@ -0,0 +1,91 @@
+/**
+ * @file include/system/auxv.hpp
+ * @brief Provides access to the auxiliary vector of the process.
+ * @category System
+ *
+ * This header declares functions that read the auxiliary vector the kernel
+ * places on the initial stack, right after the environment. Since the ITL
+ * does not depend on a C library, it reads values such as the page size
+ * directly from that vector instead of calling getauxval or sysconf.
+ *
+ * @note These functions are only available on Linux systems.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#ifndef _ITL_SYSTEM_AUXV_HPP
+#define _ITL_SYSTEM_AUXV_HPP
+
+#include "typing/ctypes.hpp"
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+#ifdef __linux__
+namespace linux {
+    namespace auxv {
+// Auxiliary vector entry types
+#define AT_NULL 0 ///< End of the vector.
+#define AT_IGNORE 1 ///< Entry should be ignored.
+#define AT_EXECFD 2 ///< File descriptor of the program.
+#define AT_PHDR 3 ///< Address of the program headers.
+#define AT_PHENT 4 ///< Size of one program header entry.
+#define AT_PHNUM 5 ///< Number of program headers.
+#define AT_PAGESZ 6 ///< System page size.
+#define AT_BASE 7 ///< Base address of the interpreter.
+#define AT_FLAGS 8 ///< Flags.
+#define AT_ENTRY 9 ///< Entry point of the program.
+#define AT_UID 11 ///< Real user identifier.
+#define AT_EUID 12 ///< Effective user identifier.
+#define AT_GID 13 ///< Real group identifier.
+#define AT_EGID 14 ///< Effective group identifier.
+#define AT_PLATFORM 15 ///< String identifying the CPU.
+#define AT_HWCAP 16 ///< Architecture-dependent CPU capabilities.
+#define AT_CLKTCK 17 ///< Frequency of times().
+#define AT_SECURE 23 ///< Whether the program runs in secure mode.
+#define AT_RANDOM 25 ///< Address of 16 random bytes.
+#define AT_HWCAP2 26 ///< Extension of AT_HWCAP.
+#define AT_EXECFN 31 ///< File name of the program.
+#define AT_SYSINFO_EHDR 33 ///< Address of the vDSO ELF header.
+#define AT_MINSIGSTKSZ 51 ///< Minimal stack size for signal delivery.
+
+        /**
+         * @brief Locates the auxiliary vector and caches the values the ITL
+         * depends on.
+         *
+         * The kernel stores the auxiliary vector right after the null
+         * pointer that terminates the environment. The runtime must call
+         * this function once at startup, before any other ITL function,
+         * with the environment received by main or, from a raw entry point,
+         * with argv + argc + 1. Until then, the compile-time defaults of
+         * mmacros.hpp are used.
+         *
+         * @param environment The null-terminated environment of the process.
+         */
+        void initialize(itl::strvec environment);
+
+        /**
+         * @brief Reads an entry of the auxiliary vector.
+         *
+         * @param type The type of the entry (e.g., AT_PAGESZ).
+         * @return The value of the entry, or 0 if it is absent or the
+         * vector was not initialized.
+         */
+        unsigned long getValue(unsigned long type);
+
+        /**
+         * @brief Returns the page size of the system.
+         *
+         * @return The page size reported by the kernel through AT_PAGESZ,
+         * or PAGE_SIZE if the vector was not initialized.
+         */
+        itl::size_t getPageSize();
+    }; // namespace auxv
+}; // namespace linux
+#endif // __linux__
+} // namespace itl
+
+#endif // _ITL_SYSTEM_AUXV_HPP
@@ -0,0 +1,59 @@
+/**
+ * @file include/system/fmacros.hpp
+ * @brief Defines file-related macros for the ITL library.
+ * @category System
+ *
+ * This header provides macros for the open flags, directory descriptors and
+ * attribute masks used in system calls such as openat and statx. These
+ * macros are specific to Linux systems on x86 and x86_64 architectures.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#ifndef _ITL_SYSTEM_FILE_MACROS_HPP
+#define _ITL_SYSTEM_FILE_MACROS_HPP
+
+namespace itl {
+namespace linux {
+    extern "C" {
+#ifdef __linux__
+// Directory descriptors
+#define AT_FDCWD -100 ///< Resolve relative paths from the working directory.
+#define AT_SYMLINK_NOFOLLOW 0x100 ///< Do not follow a final symbolic link.
+#define AT_EMPTY_PATH 0x1000 ///< Operate on the directory descriptor itself when the path is empty.
+
+// Access modes
+#define O_RDONLY 00 ///< Open for reading only.
+#define O_WRONLY 01 ///< Open for writing only.
+#define O_RDWR 02 ///< Open for reading and writing.
+#define O_ACCMODE 03 ///< Mask of the access mode.
+
+// Open flags
+#define O_CREAT 0100 ///< Create the file if it does not exist.
+#define O_EXCL 0200 ///< Fail if the file exists, with O_CREAT.
+#define O_NOCTTY 0400 ///< Do not make a terminal the controlling terminal.
+#define O_TRUNC 01000 ///< Truncate the file to length 0.
+#define O_APPEND 02000 ///< Write at the end of the file.
+#define O_NONBLOCK 04000 ///< Do not block on I/O.
+#define O_DSYNC 010000 ///< Write data synchronously.
+#define O_DIRECT 040000 ///< Bypass the page cache.
+#define O_LARGEFILE 0100000 ///< Allow 64-bit offsets on 32-bit systems.
+#define O_DIRECTORY 0200000 ///< Fail if the path is not a directory.
+#define O_NOFOLLOW 0400000 ///< Do not follow a final symbolic link.
+#define O_NOATIME 01000000 ///< Do not update the access time.
+#define O_CLOEXEC 02000000 ///< Close the descriptor on exec.
+#define O_SYNC 04010000 ///< Write data and metadata synchronously.
+#define O_PATH 010000000 ///< Obtain a descriptor for the path only.
+#define O_TMPFILE 020200000 ///< Create an unnamed temporary file.
+
+// statx masks
+#define STATX_TYPE 0x001 ///< Want the file type.
+#define STATX_MODE 0x002 ///< Want the permissions.
+#define STATX_SIZE 0x200 ///< Want the size.
+#define STATX_BASIC_STATS 0x7ff ///< Want every field of a classic stat.
+#endif // __linux__
+    }; // extern "C"
+}; // namespace linux
+}; // namespace itl
+
+#endif // _ITL_SYSTEM_FILE_MACROS_HPP
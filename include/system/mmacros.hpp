@@ -20,7 +20,10 @@ namespace linux {
     extern "C" {
 #ifdef __linux__
 // Page-related macros
-#define PAGE_SHIFT 13 ///< Number of bits to shift for page size.
+// These describe the smallest page size of the supported architectures. The
+// page size of the running system is read from the auxiliary vector by
+// itl::linux::auxv::getPageSize().
+#define PAGE_SHIFT 12 ///< Number of bits to shift for page size.
 #define PAGE_SIZE _BITUL(PAGE_SHIFT) ///< Size of a memory page in bytes.
 #define PAGE_MASK (~(PAGE_SIZE - 1)) ///< Mask to align addresses to page boundaries.
 
@@ -92,6 +95,11 @@ namespace linux {
 #define MADV_GUARD_INSTALL 102 ///< Install a guard page.
 #define MADV_GUARD_REMOVE 103 ///< Remove a guard page.
 
+// Memory remapping flags
+#define MREMAP_MAYMOVE 1 ///< The mapping may be moved to a new address.
+#define MREMAP_FIXED 2 ///< Move the mapping to the given new address.
+#define MREMAP_DONTUNMAP 4 ///< Keep the old mapping after moving its pages.
+
 // Protection key flags
 #define PKEY_DISABLE_ACCESS 0x1 ///< Disable access to the memory.
 #define PKEY_DISABLE_WRITE 0x2 ///< Disable write access to the memory.
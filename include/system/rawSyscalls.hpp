@@ -0,0 +1,356 @@
+/**
+ * @file include/system/rawSyscalls.hpp
+ * @brief Provides inline system call primitives for the ITL library.
+ * @category System
+ *
+ * This header defines the system call numbers the ITL uses and the
+ * syscall0 to syscall6 primitives, which load the number and up to six
+ * arguments into the registers the kernel expects and trap into it. The
+ * primitives are inline assembly, so a system call compiles to the trap
+ * instruction itself, without any call or return around it.
+ *
+ * @note These functions are only available on Linux systems on x86 and
+ * x86_64 architectures.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#ifndef _ITL_SYSTEM_RAW_SYSCALLS_HPP
+#define _ITL_SYSTEM_RAW_SYSCALLS_HPP
+
+#include "typing/ctypes.hpp"
+
+#ifdef __x86_64__
+// System call numbers (64-bit)
+#define SYS_READ 0 ///< Reads from a file descriptor.
+#define SYS_WRITE 1 ///< Writes to a file descriptor.
+#define SYS_CLOSE 3 ///< Closes a file descriptor.
+#define SYS_MMAP 9 ///< Maps memory.
+#define SYS_MPROTECT 10 ///< Changes the protection of memory.
+#define SYS_MUNMAP 11 ///< Unmaps memory.
+#define SYS_PREAD64 17 ///< Reads from a file at an offset.
+#define SYS_WRITEV 20 ///< Writes a vector of buffers to a file descriptor.
+#define SYS_SCHED_YIELD 24 ///< Yields the processor.
+#define SYS_MREMAP 25 ///< Resizes or moves a mapping.
+#define SYS_MADVISE 28 ///< Gives advice about the use of memory.
+#define SYS_GETPID 39 ///< Returns the process identifier.
+#define SYS_CLONE 56 ///< Creates a process or a thread.
+#define SYS_EXIT 60 ///< Terminates the calling thread.
+#define SYS_ARCH_PRCTL 158 ///< Sets architecture-specific thread state.
+#define SYS_GETTID 186 ///< Returns the thread identifier.
+#define SYS_FUTEX 202 ///< Waits on or wakes a futex.
+#define SYS_SCHED_GETAFFINITY 204 ///< Reads the CPU affinity mask of a thread.
+#define SYS_CLOCK_GETTIME 228 ///< Reads a clock.
+#define SYS_CLOCK_GETRES 229 ///< Reads the resolution of a clock.
+#define SYS_EXIT_GROUP 231 ///< Terminates every thread of the process.
+#define SYS_OPENAT 257 ///< Opens a file relative to a directory.
+#define SYS_PWRITEV 296 ///< Writes a vector of buffers to a file at an offset.
+#define SYS_STATX 332 ///< Reads the attributes of a file.
+#elif __i386__
+// System call numbers (32-bit)
+#define SYS_EXIT 1 ///< Terminates the calling thread.
+#define SYS_READ 3 ///< Reads from a file descriptor.
+#define SYS_WRITE 4 ///< Writes to a file descriptor.
+#define SYS_CLOSE 6 ///< Closes a file descriptor.
+#define SYS_GETPID 20 ///< Returns the process identifier.
+#define SYS_MMAP 90 ///< Maps memory, with the arguments in a structure.
+#define SYS_MUNMAP 91 ///< Unmaps memory.
+#define SYS_CLONE 120 ///< Creates a process or a thread.
+#define SYS_MPROTECT 125 ///< Changes the protection of memory.
+#define SYS_WRITEV 146 ///< Writes a vector of buffers to a file descriptor.
+#define SYS_SCHED_YIELD 158 ///< Yields the processor.
+#define SYS_MREMAP 163 ///< Resizes or moves a mapping.
+#define SYS_PREAD64 180 ///< Reads from a file at an offset.
+#define SYS_MMAP2 192 ///< Maps memory, with the offset in pages.
+#define SYS_MADVISE 219 ///< Gives advice about the use of memory.
+#define SYS_GETTID 224 ///< Returns the thread identifier.
+#define SYS_FUTEX 240 ///< Waits on or wakes a futex.
+#define SYS_SCHED_GETAFFINITY 242 ///< Reads the CPU affinity mask of a thread.
+#define SYS_SET_THREAD_AREA 243 ///< Sets a TLS descriptor.
+#define SYS_EXIT_GROUP 252 ///< Terminates every thread of the process.
+#define SYS_CLOCK_GETTIME 265 ///< Reads a clock.
+#define SYS_CLOCK_GETRES 266 ///< Reads the resolution of a clock.
+#define SYS_OPENAT 295 ///< Opens a file relative to a directory.
+#define SYS_PWRITEV 334 ///< Writes a vector of buffers to a file at an offset.
+#define SYS_STATX 383 ///< Reads the attributes of a file.
+#endif // #ifdef __x86_64__
+
+// System call numbers shared by every architecture
+#define SYS_IO_URING_SETUP 425 ///< Creates an io_uring instance.
+#define SYS_IO_URING_ENTER 426 ///< Submits and waits for io_uring requests.
+#define SYS_IO_URING_REGISTER 427 ///< Registers resources with an io_uring instance.
+
+/**
+ * @def SYSCALL_FAILED(result)
+ * @brief Checks whether the raw result of a system call is an error.
+ *
+ * The kernel reports failures as a negated errno value, from -4095 to -1.
+ * Every other value, including addresses in the upper half of the address
+ * space, is a valid result.
+ *
+ * @param result The result of the system call.
+ */
+#define SYSCALL_FAILED(result) ((unsigned long)(result) >= (unsigned long)-4095)
+
+// Error numbers, returned negated by the kernel and by the ITL
+#define EINTR 4 ///< Interrupted by a signal.
+#define ENOMEM 12 ///< Out of memory.
+#define EINVAL 22 ///< Invalid argument.
+#define ETIMEDOUT 110 ///< Timed out.
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+#ifdef __linux__
+namespace linux {
+    namespace syscall {
+#ifdef __x86_64__
+        /**
+         * @brief Invokes a system call without arguments (64-bit version).
+         *
+         * The number goes in rax and the arguments in rdi, rsi, rdx, r10, r8
+         * and r9. The fourth argument uses r10 instead of the rcx of the
+         * function calling convention, because the syscall instruction
+         * overwrites rcx with the return address and r11 with the flags.
+         *
+         * @param number The system call number.
+         * @return The raw result, a negated errno value on failure.
+         */
+        inline long syscall0(long number)
+        {
+            long result;
+
+            __asm__ volatile("syscall"
+                             : "=a"(result)
+                             : "a"(number)
+                             : "rcx", "r11", "memory");
+
+            return result;
+        }
+
+        /**
+         * @brief Invokes a system call with one argument (64-bit version).
+         */
+        inline long syscall1(long number, long first)
+        {
+            long result;
+
+            __asm__ volatile("syscall"
+                             : "=a"(result)
+                             : "a"(number), "D"(first)
+                             : "rcx", "r11", "memory");
+
+            return result;
+        }
+
+        /**
+         * @brief Invokes a system call with two arguments (64-bit version).
+         */
+        inline long syscall2(long number, long first, long second)
+        {
+            long result;
+
+            __asm__ volatile("syscall"
+                             : "=a"(result)
+                             : "a"(number), "D"(first), "S"(second)
+                             : "rcx", "r11", "memory");
+
+            return result;
+        }
+
+        /**
+         * @brief Invokes a system call with three arguments (64-bit version).
+         */
+        inline long syscall3(long number, long first, long second, long third)
+        {
+            long result;
+
+            __asm__ volatile("syscall"
+                             : "=a"(result)
+                             : "a"(number), "D"(first), "S"(second), "d"(third)
+                             : "rcx", "r11", "memory");
+
+            return result;
+        }
+
+        /**
+         * @brief Invokes a system call with four arguments (64-bit version).
+         */
+        inline long syscall4(long number, long first, long second, long third, long fourth)
+        {
+            long result;
+            register long r10 __asm__("r10") = fourth;
+
+            __asm__ volatile("syscall"
+                             : "=a"(result)
+                             : "a"(number), "D"(first), "S"(second), "d"(third), "r"(r10)
+                             : "rcx", "r11", "memory");
+
+            return result;
+        }
+
+        /**
+         * @brief Invokes a system call with five arguments (64-bit version).
+         */
+        inline long syscall5(long number, long first, long second, long third, long fourth, long fifth)
+        {
+            long result;
+            register long r10 __asm__("r10") = fourth;
+            register long r8 __asm__("r8") = fifth;
+
+            __asm__ volatile("syscall"
+                             : "=a"(result)
+                             : "a"(number), "D"(first), "S"(second), "d"(third), "r"(r10), "r"(r8)
+                             : "rcx", "r11", "memory");
+
+            return result;
+        }
+
+        /**
+         * @brief Invokes a system call with six arguments (64-bit version).
+         */
+        inline long syscall6(long number, long first, long second, long third, long fourth, long fifth, long sixth)
+        {
+            long result;
+            register long r10 __asm__("r10") = fourth;
+            register long r8 __asm__("r8") = fifth;
+            register long r9 __asm__("r9") = sixth;
+
+            __asm__ volatile("syscall"
+                             : "=a"(result)
+                             : "a"(number), "D"(first), "S"(second), "d"(third), "r"(r10), "r"(r8), "r"(r9)
+                             : "rcx", "r11", "memory");
+
+            return result;
+        }
+#elif __i386__
+        /**
+         * @brief Invokes a system call without arguments (32-bit version).
+         *
+         * The number goes in eax and the arguments in ebx, ecx, edx, esi,
+         * edi and ebp, and the kernel is entered with int 0x80.
+         *
+         * @param number The system call number.
+         * @return The raw result, a negated errno value on failure.
+         */
+        inline long syscall0(long number)
+        {
+            long result;
+
+            __asm__ volatile("int $0x80"
+                             : "=a"(result)
+                             : "a"(number)
+                             : "memory");
+
+            return result;
+        }
+
+        /**
+         * @brief Invokes a system call with one argument (32-bit version).
+         */
+        inline long syscall1(long number, long first)
+        {
+            long result;
+
+            __asm__ volatile("int $0x80"
+                             : "=a"(result)
+                             : "a"(number), "b"(first)
+                             : "memory");
+
+            return result;
+        }
+
+        /**
+         * @brief Invokes a system call with two arguments (32-bit version).
+         */
+        inline long syscall2(long number, long first, long second)
+        {
+            long result;
+
+            __asm__ volatile("int $0x80"
+                             : "=a"(result)
+                             : "a"(number), "b"(first), "c"(second)
+                             : "memory");
+
+            return result;
+        }
+
+        /**
+         * @brief Invokes a system call with three arguments (32-bit version).
+         */
+        inline long syscall3(long number, long first, long second, long third)
+        {
+            long result;
+
+            __asm__ volatile("int $0x80"
+                             : "=a"(result)
+                             : "a"(number), "b"(first), "c"(second), "d"(third)
+                             : "memory");
+
+            return result;
+        }
+
+        /**
+         * @brief Invokes a system call with four arguments (32-bit version).
+         */
+        inline long syscall4(long number, long first, long second, long third, long fourth)
+        {
+            long result;
+
+            __asm__ volatile("int $0x80"
+                             : "=a"(result)
+                             : "a"(number), "b"(first), "c"(second), "d"(third), "S"(fourth)
+                             : "memory");
+
+            return result;
+        }
+
+        /**
+         * @brief Invokes a system call with five arguments (32-bit version).
+         */
+        inline long syscall5(long number, long first, long second, long third, long fourth, long fifth)
+        {
+            long result;
+
+            __asm__ volatile("int $0x80"
+                             : "=a"(result)
+                             : "a"(number), "b"(first), "c"(second), "d"(third), "S"(fourth), "D"(fifth)
+                             : "memory");
+
+            return result;
+        }
+
+        /**
+         * @brief Invokes a system call with six arguments (32-bit version).
+         *
+         * The sixth argument belongs in ebp, which cannot be named as an
+         * operand because it may be the frame pointer. It is pushed before
+         * ebp is saved, while the operand still addresses the right stack
+         * slot, and loaded from the stack afterwards.
+         */
+        inline long syscall6(long number, long first, long second, long third, long fourth, long fifth, long sixth)
+        {
+            long result;
+
+            __asm__ volatile("pushl %7\n\t"
+                             "push %%ebp\n\t"
+                             "mov 4(%%esp), %%ebp\n\t"
+                             "int $0x80\n\t"
+                             "pop %%ebp\n\t"
+                             "add $4, %%esp"
+                             : "=a"(result)
+                             : "a"(number), "b"(first), "c"(second), "d"(third), "S"(fourth), "D"(fifth), "g"(sixth)
+                             : "memory");
+
+            return result;
+        }
+#endif // #ifdef __x86_64__
+    }; // namespace syscall
+}; // namespace linux
+#endif // #ifdef __linux__
+} // namespace itl
+
+#endif // _ITL_SYSTEM_RAW_SYSCALLS_HPP
@@ -0,0 +1,187 @@
+/**
+ * @file include/system/simd.hpp
+ * @brief Provides vectorized memory and reduction kernels for the ITL
+ * library.
+ * @category System
+ *
+ * This header declares byte and float kernels (copy, fill, compare,
+ * search, string length and reductions) written once over vector traits
+ * and compiled for SSE2, AVX2 and AVX-512, next to a portable version
+ * that works on 64-bit words. The processor is probed with CPUID on first
+ * use, or when initialize() runs, and every call then jumps straight to
+ * the widest kernel it supports. The library is built without a C
+ * library, so these kernels also provide memcpy, memmove, memset and
+ * memcmp to the code the compiler generates.
+ *
+ * @note These functions are only available on x86 and x86_64
+ * architectures.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#ifndef _ITL_SYSTEM_SIMD_HPP
+#define _ITL_SYSTEM_SIMD_HPP
+
+#include "typing/ctypes.hpp"
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace simd {
+// Processor features
+#define SIMD_FEATURE_SSE2 0x01 ///< SSE2 instructions.
+#define SIMD_FEATURE_AVX 0x02 ///< AVX instructions, with the YMM state enabled by the kernel.
+#define SIMD_FEATURE_AVX2 0x04 ///< AVX2 instructions.
+#define SIMD_FEATURE_FMA 0x08 ///< Fused multiply-add instructions.
+#define SIMD_FEATURE_AVX512F 0x10 ///< AVX-512 foundation, with the ZMM state enabled by the kernel.
+#define SIMD_FEATURE_AVX512BW 0x20 ///< AVX-512 byte and word instructions.
+#define SIMD_FEATURE_ERMS 0x40 ///< Enhanced rep movsb and stosb.
+
+#define SIMD_REP_MOVSB_THRESHOLD 4096 ///< Smallest copy done with rep movsb when the processor has ERMS.
+
+    /**
+     * @enum SimdLevel
+     * @brief The instruction set the kernels run with.
+     */
+    typedef enum {
+        SIMD_LEVEL_SCALAR, ///< 64-bit words, on any processor.
+        SIMD_LEVEL_SSE2, ///< 16-byte vectors.
+        SIMD_LEVEL_AVX2, ///< 32-byte vectors, with fused multiply-add.
+        SIMD_LEVEL_AVX512 ///< 64-byte vectors and mask registers.
+    } SimdLevel;
+
+    /**
+     * @struct SimdKernels
+     * @brief The kernels of one instruction set.
+     */
+    typedef struct {
+        void* (*copy)(void* destination, const void* source, itl::size_t size); ///< Copies possibly overlapping bytes.
+        void* (*fill)(void* destination, int value, itl::size_t size); ///< Sets bytes to a value.
+        int (*compare)(const void* first, const void* second, itl::size_t size); ///< Compares bytes like memcmp.
+        const void* (*findByte)(const void* data, int value, itl::size_t size); ///< Finds the first occurrence of a byte.
+        itl::size_t (*stringLength)(const char* string); ///< Measures a null-terminated string.
+        const void* (*findBytes)(const void* data, itl::size_t size, const void* pattern, itl::size_t patternSize); ///< Finds the first occurrence of a byte sequence.
+        itl::size_t (*countByte)(const void* data, int value, itl::size_t size); ///< Counts the occurrences of a byte.
+        itl::uint64_t (*sumBytes)(const void* data, itl::size_t size); ///< Adds bytes as unsigned integers.
+        float (*sumFloats)(const float* values, itl::size_t count); ///< Adds floats.
+        float (*dotFloats)(const float* first, const float* second, itl::size_t count); ///< Computes the dot product of two float arrays.
+    } SimdKernels;
+
+    /**
+     * @brief Probes the processor and selects the widest kernels it
+     * supports.
+     *
+     * Calling it is optional, since the first call to any kernel does it,
+     * but doing it at startup keeps the probe off the first hot call.
+     */
+    void initialize();
+
+    /**
+     * @brief Returns the SIMD_FEATURE_* flags of the processor.
+     */
+    itl::uint32_t getFeatures();
+
+    /**
+     * @brief Returns the instruction set of the selected kernels.
+     */
+    itl::simd::SimdLevel getLevel();
+
+    /**
+     * @brief Selects the kernels of another instruction set, such as to
+     * compare them in benchmarks.
+     *
+     * @param level The requested level, lowered to the widest one the
+     * processor supports.
+     * @return The level selected.
+     */
+    itl::simd::SimdLevel setLevel(itl::simd::SimdLevel level);
+
+    /**
+     * @brief Returns the kernels of an instruction set.
+     *
+     * @param level The level, which the processor must support.
+     * @return The kernels of that level.
+     */
+    const itl::simd::SimdKernels* getKernels(itl::simd::SimdLevel level);
+
+    /**
+     * @brief Copies bytes between two regions, which may overlap.
+     *
+     * @return The destination.
+     */
+    void* copy(void* destination, const void* source, itl::size_t size);
+
+    /**
+     * @brief Sets every byte of a region to a value.
+     *
+     * @return The destination.
+     */
+    void* fill(void* destination, int value, itl::size_t size);
+
+    /**
+     * @brief Compares two regions as unsigned bytes.
+     *
+     * @return A negative, zero or positive value as the first region is
+     * lower, equal or greater.
+     */
+    int compare(const void* first, const void* second, itl::size_t size);
+
+    /**
+     * @brief Finds the first occurrence of a byte in a region.
+     *
+     * @return The occurrence, or nullptr if there is none.
+     */
+    const void* findByte(const void* data, int value, itl::size_t size);
+
+    /**
+     * @brief Returns the length of a null-terminated string.
+     *
+     * Whole aligned vectors are read, so the string is read past its end,
+     * but never across a page boundary it does not reach.
+     */
+    itl::size_t stringLength(const char* string);
+
+    /**
+     * @brief Finds the first occurrence of a byte sequence in a region.
+     *
+     * Candidates are the positions whose first and last bytes both match
+     * the pattern, tested a whole vector at a time, so only a few of them
+     * are ever compared in full.
+     *
+     * @return The occurrence, data itself for an empty pattern, or nullptr
+     * if there is none.
+     */
+    const void* findBytes(const void* data, itl::size_t size, const void* pattern, itl::size_t patternSize);
+
+    /**
+     * @brief Counts the occurrences of a byte in a region.
+     */
+    itl::size_t countByte(const void* data, int value, itl::size_t size);
+
+    /**
+     * @brief Adds the bytes of a region as unsigned integers.
+     */
+    itl::uint64_t sumBytes(const void* data, itl::size_t size);
+
+    /**
+     * @brief Adds an array of floats.
+     *
+     * Partial sums are kept in several vector accumulators, so the result
+     * may differ in the last bits from a sequential sum.
+     */
+    float sumFloats(const float* values, itl::size_t count);
+
+    /**
+     * @brief Computes the dot product of two float arrays.
+     *
+     * The vector kernels accumulate like sumFloats(), and the AVX2 and
+     * AVX-512 ones use fused multiply-add.
+     */
+    float dotFloats(const float* first, const float* second, itl::size_t count);
+}; // namespace simd
+} // namespace itl
+
+#endif // _ITL_SYSTEM_SIMD_HPP
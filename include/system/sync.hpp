@@ -0,0 +1,410 @@
+/**
+ * @file include/system/sync.hpp
+ * @brief Provides futex-based synchronization primitives for the ITL
+ * library.
+ * @category System
+ *
+ * This header defines a mutex, a condition variable, a reader-writer
+ * lock, a one-shot event and a barrier built directly on the futex system
+ * call. Each primitive keeps its whole state in one or two 32-bit words:
+ * uncontended operations are a single atomic instruction in user space,
+ * contended ones spin briefly and then park the thread in the kernel, and
+ * the kernel is only asked to wake threads when the state records that
+ * some are parked.
+ *
+ * @note These functions are only available on Linux systems on x86 and
+ * x86_64 architectures.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#ifndef _ITL_SYSTEM_SYNC_HPP
+#define _ITL_SYSTEM_SYNC_HPP
+
+#include "system/syscalls.hpp"
+#include "typing/ctypes.hpp"
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace thread {
+// Futex operations
+#define FUTEX_WAIT 0 ///< Sleeps while the word holds the expected value.
+#define FUTEX_WAKE 1 ///< Wakes threads sleeping on the word.
+#define FUTEX_REQUEUE 3 ///< Wakes some threads and moves the rest to another word.
+#define FUTEX_CMP_REQUEUE 4 ///< FUTEX_REQUEUE, if the word still holds a value.
+#define FUTEX_PRIVATE_FLAG 128 ///< The word is not shared with other processes.
+#define FUTEX_WAIT_PRIVATE (FUTEX_WAIT | FUTEX_PRIVATE_FLAG) ///< FUTEX_WAIT within the process.
+#define FUTEX_WAKE_PRIVATE (FUTEX_WAKE | FUTEX_PRIVATE_FLAG) ///< FUTEX_WAKE within the process.
+#define FUTEX_CMP_REQUEUE_PRIVATE (FUTEX_CMP_REQUEUE | FUTEX_PRIVATE_FLAG) ///< FUTEX_CMP_REQUEUE within the process.
+#define FUTEX_WAKE_ALL 0x7fffffff ///< Largest count a futex wake accepts, to wake every sleeper.
+
+#define CACHE_LINE_SIZE 64 ///< Size of a cache line, to keep words written by different threads apart.
+
+// Spinning
+#define SYNC_SPIN_LIMIT 100 ///< Spins before a waiter parks, for primitives without adaptive spinning.
+#define MUTEX_MAX_SPINS 1000 ///< Upper bound of the adaptive spin count of a mutex.
+
+// Mutex states
+#define MUTEX_UNLOCKED 0 ///< Nobody holds the mutex.
+#define MUTEX_LOCKED 1 ///< Held, nobody parked.
+#define MUTEX_CONTENDED 2 ///< Held, and threads may be parked.
+
+// Reader-writer lock state bits
+#define RWLOCK_READERS_MASK 0x1fffffffU ///< Number of readers holding the lock.
+#define RWLOCK_WRITER 0x80000000U ///< A writer holds the lock.
+#define RWLOCK_WRITER_PENDING 0x40000000U ///< A writer is parked; new readers wait.
+#define RWLOCK_WAITERS 0x20000000U ///< Threads may be parked on the lock.
+
+#define MUTEX_INITIALIZER { 0, 0 } ///< Static initializer of an unlocked mutex.
+#define CONDITION_INITIALIZER { 0, 0, nullptr } ///< Static initializer of a condition variable.
+#define RWLOCK_INITIALIZER { 0 } ///< Static initializer of an unlocked reader-writer lock.
+#define EVENT_INITIALIZER { 0 } ///< Static initializer of an unset event.
+
+    /**
+     * @struct Mutex
+     * @brief A mutual exclusion lock that parks contended waiters.
+     */
+    typedef struct {
+        itl::uint32_t state; ///< MUTEX_UNLOCKED, MUTEX_LOCKED or MUTEX_CONTENDED.
+        itl::uint32_t spins; ///< Average spins that recently led to the lock.
+    } Mutex;
+
+    /**
+     * @struct Condition
+     * @brief A condition variable, used together with a Mutex.
+     */
+    typedef struct {
+        itl::uint32_t sequence; ///< Incremented by every signal; waiters sleep on it.
+        itl::uint32_t waiters; ///< Number of threads waiting.
+        itl::thread::Mutex* mutex; ///< Mutex of the last wait, target of broadcasts.
+    } Condition;
+
+    /**
+     * @struct RwLock
+     * @brief A reader-writer lock that prefers waiting writers.
+     */
+    typedef struct {
+        itl::uint32_t state; ///< Reader count and RWLOCK_* bits.
+    } RwLock;
+
+    /**
+     * @struct Event
+     * @brief A one-shot event: once set, every wait returns immediately.
+     */
+    typedef struct {
+        itl::uint32_t state; ///< 0 unset, 1 set, 2 unset with parked waiters.
+    } Event;
+
+    /**
+     * @struct Barrier
+     * @brief A reusable barrier for a fixed number of threads.
+     */
+    typedef struct {
+        itl::uint32_t count; ///< Number of threads that meet at the barrier.
+        itl::uint32_t arrived; ///< Threads arrived in the current generation.
+        itl::uint32_t generation; ///< Incremented each time the barrier opens.
+        itl::uint32_t sleepers; ///< Threads parked in the kernel.
+    } Barrier;
+
+    /**
+     * @brief Waits while a futex word holds a value.
+     *
+     * @param word The futex word.
+     * @param expected The value the word must hold for the thread to sleep.
+     * @param timeout A relative timeout, or nullptr to wait indefinitely.
+     * @return 0 when woken, or a negated errno value (-EAGAIN when the
+     * word changed, -ETIMEDOUT, -EINTR).
+     */
+    inline int futexWait(itl::uint32_t* word, itl::uint32_t expected, const itl::linux::syscall::timespec_struct* timeout)
+    {
+        return (int)itl::linux::syscall::futex(word, FUTEX_WAIT_PRIVATE, expected, timeout, nullptr, 0);
+    }
+
+    /**
+     * @brief Wakes threads sleeping on a futex word.
+     *
+     * @param word The futex word.
+     * @param count The maximum number of threads to wake.
+     * @return The number of threads woken.
+     */
+    inline int futexWake(itl::uint32_t* word, itl::uint32_t count)
+    {
+        return (int)itl::linux::syscall::futex(word, FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+    }
+
+    /**
+     * @brief Acquires a contended mutex, spinning and then parking.
+     *
+     * This is the slow path of lockMutex().
+     */
+    void lockMutexContended(itl::thread::Mutex* mutex);
+
+    /**
+     * @brief Initializes an unlocked mutex.
+     */
+    inline void initializeMutex(itl::thread::Mutex* mutex)
+    {
+        mutex->state = MUTEX_UNLOCKED;
+        mutex->spins = 0;
+    }
+
+    /**
+     * @brief Acquires a mutex.
+     *
+     * An unlocked mutex is taken with a single compare-and-swap.
+     *
+     * @param mutex The mutex.
+     */
+    inline void lockMutex(itl::thread::Mutex* mutex)
+    {
+        itl::uint32_t expected = MUTEX_UNLOCKED;
+
+        if (__builtin_expect(!__atomic_compare_exchange_n(&mutex->state, &expected, MUTEX_LOCKED,
+                                 false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED),
+                0))
+            lockMutexContended(mutex);
+    }
+
+    /**
+     * @brief Acquires a mutex if it is unlocked.
+     *
+     * @return true if the mutex was acquired.
+     */
+    inline bool tryLockMutex(itl::thread::Mutex* mutex)
+    {
+        itl::uint32_t expected = MUTEX_UNLOCKED;
+
+        return __atomic_compare_exchange_n(&mutex->state, &expected, MUTEX_LOCKED,
+            false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+    }
+
+    /**
+     * @brief Releases a mutex.
+     *
+     * The kernel is only entered when the state records parked waiters.
+     *
+     * @param mutex The mutex, held by the calling thread.
+     */
+    inline void unlockMutex(itl::thread::Mutex* mutex)
+    {
+        if (__builtin_expect(__atomic_exchange_n(&mutex->state, MUTEX_UNLOCKED, __ATOMIC_RELEASE) == MUTEX_CONTENDED, 0))
+            futexWake(&mutex->state, 1);
+    }
+
+    /**
+     * @brief Initializes a condition variable.
+     */
+    inline void initializeCondition(itl::thread::Condition* condition)
+    {
+        condition->sequence = 0;
+        condition->waiters = 0;
+        condition->mutex = nullptr;
+    }
+
+    /**
+     * @brief Releases a mutex, waits for a signal and reacquires the mutex.
+     *
+     * Like every condition variable, it may return without a signal, so
+     * the caller checks its predicate in a loop.
+     *
+     * @param condition The condition variable.
+     * @param mutex The mutex, held by the calling thread.
+     */
+    void waitCondition(itl::thread::Condition* condition, itl::thread::Mutex* mutex);
+
+    /**
+     * @brief Waits for a signal, for at most a relative timeout.
+     *
+     * @param condition The condition variable.
+     * @param mutex The mutex, held by the calling thread.
+     * @param timeout The longest time to wait.
+     * @return false if the timeout expired, true otherwise.
+     */
+    bool timedWaitCondition(itl::thread::Condition* condition, itl::thread::Mutex* mutex,
+        const itl::linux::syscall::timespec_struct* timeout);
+
+    /**
+     * @brief Wakes one thread waiting on a condition variable.
+     *
+     * Without waiters, this is a single load.
+     */
+    void signalCondition(itl::thread::Condition* condition);
+
+    /**
+     * @brief Wakes every thread waiting on a condition variable.
+     *
+     * One thread is woken and the others are moved to the queue of the
+     * mutex, where unlockMutex() releases them one by one, instead of
+     * waking them all to fight for the mutex.
+     */
+    void broadcastCondition(itl::thread::Condition* condition);
+
+    /**
+     * @brief Initializes an unlocked reader-writer lock.
+     */
+    inline void initializeRwLock(itl::thread::RwLock* lock)
+    {
+        lock->state = 0;
+    }
+
+    /**
+     * @brief Acquires a reader-writer lock for reading, spinning and then
+     * parking.
+     *
+     * This is the slow path of readLock().
+     */
+    void readLockContended(itl::thread::RwLock* lock);
+
+    /**
+     * @brief Acquires a reader-writer lock for writing, spinning and then
+     * parking.
+     *
+     * This is the slow path of writeLock().
+     */
+    void writeLockContended(itl::thread::RwLock* lock);
+
+    /**
+     * @brief Acquires a reader-writer lock for reading, if it is not held
+     * and not awaited by a writer.
+     *
+     * @return true if the lock was acquired.
+     */
+    inline bool tryReadLock(itl::thread::RwLock* lock)
+    {
+        itl::uint32_t state = __atomic_load_n(&lock->state, __ATOMIC_RELAXED);
+
+        return !(state & (RWLOCK_WRITER | RWLOCK_WRITER_PENDING))
+            && __atomic_compare_exchange_n(&lock->state, &state, state + 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+    }
+
+    /**
+     * @brief Acquires a reader-writer lock for reading.
+     *
+     * @param lock The lock.
+     */
+    inline void readLock(itl::thread::RwLock* lock)
+    {
+        if (__builtin_expect(!tryReadLock(lock), 0))
+            readLockContended(lock);
+    }
+
+    /**
+     * @brief Releases a reader-writer lock held for reading.
+     *
+     * @param lock The lock.
+     */
+    inline void readUnlock(itl::thread::RwLock* lock)
+    {
+        itl::uint32_t state = __atomic_sub_fetch(&lock->state, 1, __ATOMIC_RELEASE);
+
+        // The last reader out wakes the parked threads, if there are any.
+        if (__builtin_expect((state & RWLOCK_READERS_MASK) == 0 && (state & RWLOCK_WAITERS), 0)) {
+            __atomic_fetch_and(&lock->state, ~RWLOCK_WAITERS, __ATOMIC_RELAXED);
+            futexWake(&lock->state, FUTEX_WAKE_ALL);
+        }
+    }
+
+    /**
+     * @brief Acquires a reader-writer lock for writing, if it is free.
+     *
+     * @return true if the lock was acquired.
+     */
+    inline bool tryWriteLock(itl::thread::RwLock* lock)
+    {
+        itl::uint32_t state = __atomic_load_n(&lock->state, __ATOMIC_RELAXED);
+
+        return !(state & (RWLOCK_WRITER | RWLOCK_READERS_MASK))
+            && __atomic_compare_exchange_n(&lock->state, &state, (state | RWLOCK_WRITER) & ~RWLOCK_WRITER_PENDING,
+                false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+    }
+
+    /**
+     * @brief Acquires a reader-writer lock for writing.
+     *
+     * @param lock The lock.
+     */
+    inline void writeLock(itl::thread::RwLock* lock)
+    {
+        if (__builtin_expect(!tryWriteLock(lock), 0))
+            writeLockContended(lock);
+    }
+
+    /**
+     * @brief Releases a reader-writer lock held for writing.
+     *
+     * @param lock The lock.
+     */
+    inline void writeUnlock(itl::thread::RwLock* lock)
+    {
+        itl::uint32_t state = __atomic_fetch_and(&lock->state, ~(RWLOCK_WRITER | RWLOCK_WAITERS), __ATOMIC_RELEASE);
+
+        if (__builtin_expect(state & RWLOCK_WAITERS, 0))
+            futexWake(&lock->state, FUTEX_WAKE_ALL);
+    }
+
+    /**
+     * @brief Initializes an unset event.
+     */
+    inline void initializeEvent(itl::thread::Event* event)
+    {
+        event->state = 0;
+    }
+
+    /**
+     * @brief Reports whether an event was set.
+     */
+    inline bool isEventSet(const itl::thread::Event* event)
+    {
+        return __atomic_load_n(&event->state, __ATOMIC_ACQUIRE) == 1;
+    }
+
+    /**
+     * @brief Sets an event and releases every thread waiting on it.
+     *
+     * @param event The event.
+     */
+    inline void setEvent(itl::thread::Event* event)
+    {
+        if (__atomic_exchange_n(&event->state, 1, __ATOMIC_RELEASE) == 2)
+            futexWake(&event->state, FUTEX_WAKE_ALL);
+    }
+
+    /**
+     * @brief Waits until an event is set.
+     *
+     * @param event The event.
+     */
+    void waitEvent(itl::thread::Event* event);
+
+    /**
+     * @brief Initializes a barrier.
+     *
+     * @param barrier The barrier.
+     * @param count The number of threads that meet at the barrier, at
+     * least 1.
+     */
+    inline void initializeBarrier(itl::thread::Barrier* barrier, itl::uint32_t count)
+    {
+        barrier->count = count;
+        barrier->arrived = 0;
+        barrier->generation = 0;
+        barrier->sleepers = 0;
+    }
+
+    /**
+     * @brief Waits until every thread of the barrier arrived.
+     *
+     * The barrier then resets itself for the next round.
+     *
+     * @param barrier The barrier.
+     * @return true in exactly one thread per round, the last to arrive.
+     */
+    bool arriveAndWait(itl::thread::Barrier* barrier);
+}; // namespace thread
+} // namespace itl
+
+#endif // _ITL_SYSTEM_SYNC_HPP
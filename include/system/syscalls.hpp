@@ -1,12 +1,18 @@
 /**
  * @file include/system/syscalls.hpp
- * @brief Provides system call wrappers for memory management.
+ * @brief Provides typed system call wrappers for the ITL library.
  * @category System
  *
- * This header defines wrappers for system calls such as mmap and munmap,
- * which are used for memory mapping and unmapping in Linux systems.
+ * This header defines wrappers for the system calls the ITL relies on:
+ * mmap, munmap, madvise and mremap for memory mapping, read, write, writev,
+ * pread, pwritev, openat, close and statx for files, futex and clone for
+ * threads, clock_gettime and clock_getres for clocks, and the io_uring
+ * calls. Each wrapper is an inline function over the primitives of
+ * rawSyscalls.hpp, which takes care of the argument order of each
+ * architecture.
  *
- * @note These functions are only available on Linux systems.
+ * @note These functions are only available on Linux systems on x86 and
+ * x86_64 architectures.
  *
  * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
  * @date 05.05.2025
@@ -14,6 +20,7 @@
 #ifndef _ITL_SYSTEM_SYSCALLS_HPP
 #define _ITL_SYSTEM_SYSCALLS_HPP
 
+#include "system/rawSyscalls.hpp"
 #include "typing/ctypes.hpp"
 
 /**
@@ -25,7 +32,6 @@ namespace itl {
 #ifdef __linux__
 namespace linux {
     namespace syscall {
-        extern "C" {
 #ifdef __x86_64__
         /**
          * @brief Maps a region of memory (64-bit version).
@@ -43,12 +49,15 @@ namespace linux {
          * @param fileDescriptor The file descriptor of the file to map,
          * or -1 for anonymous mapping.
          * @param offset The offset in the file where the mapping starts.
-         * @return A pointer to the mapped memory region, or nullptr if the
-         * mapping fails.
+         * @return A pointer to the mapped memory region, or a negated errno
+         * value if the mapping fails.
          */
-        void* mmap(
+        inline void* mmap(
             unsigned long address, unsigned long length, unsigned long protection,
-            unsigned long flags, unsigned long fileDescriptor, unsigned long offset);
+            unsigned long flags, unsigned long fileDescriptor, unsigned long offset)
+        {
+            return (void*)syscall6(SYS_MMAP, address, length, protection, flags, fileDescriptor, offset);
+        }
 #elif __i386__
         /**
          * @struct mmap_arg_struct
@@ -78,10 +87,38 @@ namespace linux {
          *
          * @param arguments A pointer to a mmap_arg_struct containing the
          * parameters for the mapping.
-         * @return A pointer to the mapped memory region, or nullptr if the
-         * mapping fails.
+         * @return A pointer to the mapped memory region, or a negated errno
+         * value if the mapping fails.
          */
-        void* mmap(mmap_arg_struct arguments);
+        inline void* mmap(mmap_arg_struct arguments)
+        {
+            return (void*)syscall1(SYS_MMAP, (long)&arguments);
+        }
+
+        /**
+         * @brief Maps a region of memory at a large file offset (32-bit
+         * version).
+         *
+         * This function wraps the mmap2 system call, which takes its
+         * arguments in registers and the offset in units of 4096 bytes, so
+         * files larger than 4 GiB can be mapped past their first 4 GiB.
+         *
+         * @param address The starting address for the mapping, or 0.
+         * @param length The length of the mapping, in bytes.
+         * @param protection The desired memory protection of the mapping.
+         * @param flags Flags that determine the nature of the mapping.
+         * @param fileDescriptor The file descriptor of the file to map,
+         * or -1 for anonymous mapping.
+         * @param pageOffset The offset in the file, in units of 4096 bytes.
+         * @return A pointer to the mapped memory region, or a negated errno
+         * value if the mapping fails.
+         */
+        inline void* mmap2(
+            unsigned long address, unsigned long length, unsigned long protection,
+            unsigned long flags, unsigned long fileDescriptor, unsigned long pageOffset)
+        {
+            return (void*)syscall6(SYS_MMAP2, address, length, protection, flags, fileDescriptor, pageOffset);
+        }
 #endif // ifdef __x86_64__
         /**
          * @brief Unmaps a region of memory.
@@ -91,13 +128,471 @@ namespace linux {
          *
          * @param address The starting address of the memory region to unmap.
          * @param length The length of the memory region to unmap, in bytes.
-         * @return 0 on success, or -1 if the unmapping fails.
+         * @return 0 on success, or a negated errno value on failure.
          */
-        int munmap(unsigned long address, itl::size_t length);
-#endif // #ifdef __linux__
-        }; // extern "C"
+        inline int munmap(unsigned long address, itl::size_t length)
+        {
+            return (int)syscall2(SYS_MUNMAP, address, length);
+        }
+
+        /**
+         * @brief Gives advice about the use of a region of memory.
+         *
+         * This function wraps the madvise system call, which lets the kernel
+         * adapt its paging of a region, for example by backing it with
+         * transparent huge pages or by reclaiming pages that are no longer
+         * needed.
+         *
+         * @param address The starting address of the memory region, aligned
+         * to a page.
+         * @param length The length of the memory region, in bytes.
+         * @param advice The advice to apply (e.g., MADV_HUGEPAGE, MADV_FREE).
+         * @return 0 on success, or a negated errno value on failure.
+         */
+        inline int madvise(unsigned long address, itl::size_t length, int advice)
+        {
+            return (int)syscall3(SYS_MADVISE, address, length, advice);
+        }
+
+        /**
+         * @brief Changes the protection of a region of memory.
+         *
+         * @param address The starting address of the memory region, aligned
+         * to a page.
+         * @param length The length of the memory region, in bytes.
+         * @param protection The new protection (e.g., PROT_NONE, PROT_READ).
+         * @return 0 on success, or a negated errno value on failure.
+         */
+        inline int mprotect(unsigned long address, itl::size_t length, int protection)
+        {
+            return (int)syscall3(SYS_MPROTECT, address, length, protection);
+        }
+
+        /**
+         * @brief Resizes or moves a region of memory.
+         *
+         * This function wraps the mremap system call, which expands or
+         * shrinks an existing mapping and may move it to another address.
+         * The pages themselves are moved in the page tables, so the content
+         * of the mapping is never copied.
+         *
+         * @param oldAddress The starting address of the mapping, aligned to
+         * a page.
+         * @param oldLength The current length of the mapping, in bytes.
+         * @param newLength The new length of the mapping, in bytes.
+         * @param flags Flags controlling the move (e.g., MREMAP_MAYMOVE,
+         * MREMAP_FIXED).
+         * @param newAddress The address to move the mapping to, when
+         * MREMAP_FIXED is set.
+         * @return The address of the resized mapping, or a negated errno
+         * value on failure.
+         */
+        inline void* mremap(unsigned long oldAddress, itl::size_t oldLength, itl::size_t newLength,
+            unsigned long flags, unsigned long newAddress)
+        {
+            return (void*)syscall5(SYS_MREMAP, oldAddress, oldLength, newLength, flags, newAddress);
+        }
+
+        /**
+         * @struct timespec_struct
+         * @brief Time value exchanged with the clock system calls.
+         *
+         * Both fields have the width of a long, as the clock_gettime system
+         * call of each architecture expects.
+         */
+        typedef struct {
+            long seconds; ///< Whole seconds.
+            long nanoseconds; ///< Nanoseconds, below one second.
+        } timespec_struct;
+
+        /**
+         * @brief Reads the current value of a clock.
+         *
+         * This function wraps the clock_gettime system call. The ITL prefers
+         * the version exported by the vDSO, which avoids entering the
+         * kernel, and only uses this one as a fallback (see itl::time).
+         *
+         * @param clockId The identifier of the clock (e.g., CLOCK_MONOTONIC).
+         * @param time Receives the value of the clock.
+         * @return 0 on success, or a negated errno value on failure.
+         */
+        inline int clock_gettime(int clockId, timespec_struct* time)
+        {
+            return (int)syscall2(SYS_CLOCK_GETTIME, clockId, (long)time);
+        }
+
+        /**
+         * @brief Reads the resolution of a clock.
+         *
+         * This function wraps the clock_getres system call.
+         *
+         * @param clockId The identifier of the clock (e.g., CLOCK_MONOTONIC).
+         * @param resolution Receives the resolution of the clock.
+         * @return 0 on success, or a negated errno value on failure.
+         */
+        inline int clock_getres(int clockId, timespec_struct* resolution)
+        {
+            return (int)syscall2(SYS_CLOCK_GETRES, clockId, (long)resolution);
+        }
+
+        /**
+         * @struct iovec_struct
+         * @brief Buffer of a vectored read or write.
+         */
+        typedef struct {
+            void* base; ///< Start of the buffer.
+            itl::size_t length; ///< Length of the buffer, in bytes.
+        } iovec_struct;
+
+        /**
+         * @brief Reads from a file descriptor.
+         *
+         * @param fileDescriptor The file descriptor to read from.
+         * @param buffer The buffer receiving the bytes.
+         * @param count The maximum number of bytes to read.
+         * @return The number of bytes read, 0 at the end of the file, or a
+         * negated errno value on failure.
+         */
+        inline itl::ssize_t read(int fileDescriptor, void* buffer, itl::size_t count)
+        {
+            return syscall3(SYS_READ, fileDescriptor, (long)buffer, count);
+        }
+
+        /**
+         * @brief Writes to a file descriptor.
+         *
+         * @param fileDescriptor The file descriptor to write to.
+         * @param buffer The bytes to write.
+         * @param count The number of bytes to write.
+         * @return The number of bytes written, or a negated errno value on
+         * failure.
+         */
+        inline itl::ssize_t write(int fileDescriptor, const void* buffer, itl::size_t count)
+        {
+            return syscall3(SYS_WRITE, fileDescriptor, (long)buffer, count);
+        }
+
+        /**
+         * @brief Reads from a file at an offset, without moving its position.
+         *
+         * On x86 the 64-bit offset is split in two registers, low half
+         * first.
+         *
+         * @param fileDescriptor The file descriptor to read from.
+         * @param buffer The buffer receiving the bytes.
+         * @param count The maximum number of bytes to read.
+         * @param offset The position in the file to read from.
+         * @return The number of bytes read, 0 at the end of the file, or a
+         * negated errno value on failure.
+         */
+        inline itl::ssize_t pread(int fileDescriptor, void* buffer, itl::size_t count, itl::int64_t offset)
+        {
+#ifdef __x86_64__
+            return syscall4(SYS_PREAD64, fileDescriptor, (long)buffer, count, offset);
+#elif __i386__
+            return syscall5(SYS_PREAD64, fileDescriptor, (long)buffer, count,
+                (long)(offset & 0xffffffff), (long)(offset >> 32));
+#endif // #ifdef __x86_64__
+        }
+
+        /**
+         * @brief Writes a vector of buffers to a file descriptor.
+         *
+         * The buffers are written in order, as if they were concatenated,
+         * with a single system call.
+         *
+         * @param fileDescriptor The file descriptor to write to.
+         * @param vectors The buffers to write, in order.
+         * @param count The number of buffers.
+         * @return The number of bytes written, or a negated errno value on
+         * failure.
+         */
+        inline itl::ssize_t writev(int fileDescriptor, const iovec_struct* vectors, int count)
+        {
+            return syscall3(SYS_WRITEV, fileDescriptor, (long)vectors, count);
+        }
+
+        /**
+         * @brief Writes a vector of buffers to a file at an offset, without
+         * moving its position.
+         *
+         * The kernel always takes the offset as two words, low half first;
+         * on x86_64 the low word holds the whole offset.
+         *
+         * @param fileDescriptor The file descriptor to write to.
+         * @param vectors The buffers to write, in order.
+         * @param count The number of buffers.
+         * @param offset The position in the file to write to.
+         * @return The number of bytes written, or a negated errno value on
+         * failure.
+         */
+        inline itl::ssize_t pwritev(int fileDescriptor, const iovec_struct* vectors, int count, itl::int64_t offset)
+        {
+#ifdef __x86_64__
+            return syscall5(SYS_PWRITEV, fileDescriptor, (long)vectors, count, offset, 0);
+#elif __i386__
+            return syscall5(SYS_PWRITEV, fileDescriptor, (long)vectors, count,
+                (long)(offset & 0xffffffff), (long)(offset >> 32));
+#endif // #ifdef __x86_64__
+        }
+
+        /**
+         * @brief Opens a file relative to a directory.
+         *
+         * @param directory The directory file descriptor, or AT_FDCWD for
+         * the working directory.
+         * @param path The path of the file.
+         * @param flags The open flags (e.g., O_RDONLY).
+         * @param mode The permissions of a created file.
+         * @return The new file descriptor, or a negated errno value on
+         * failure.
+         */
+        inline int openat(int directory, const char* path, int flags, unsigned mode)
+        {
+            return (int)syscall4(SYS_OPENAT, directory, (long)path, flags, mode);
+        }
+
+        /**
+         * @brief Closes a file descriptor.
+         *
+         * @param fileDescriptor The file descriptor to close.
+         * @return 0 on success, or a negated errno value on failure.
+         */
+        inline int close(int fileDescriptor)
+        {
+            return (int)syscall1(SYS_CLOSE, fileDescriptor);
+        }
+
+        /**
+         * @struct statx_timestamp_struct
+         * @brief Timestamp reported by the statx system call.
+         */
+        typedef struct {
+            itl::int64_t seconds; ///< Seconds since the Unix epoch.
+            itl::uint32_t nanoseconds; ///< Nanoseconds, below one second.
+            itl::int32_t reserved; ///< Reserved.
+        } statx_timestamp_struct;
+
+        /**
+         * @struct statx_struct
+         * @brief Attributes of a file, as reported by the statx system call.
+         *
+         * Unlike stat, the layout is the same on every architecture.
+         */
+        typedef struct {
+            itl::uint32_t mask; ///< Fields that were filled (STATX_*).
+            itl::uint32_t blockSize; ///< Preferred I/O block size.
+            itl::uint64_t attributes; ///< File attributes.
+            itl::uint32_t linkCount; ///< Number of hard links.
+            itl::uint32_t userId; ///< Owner.
+            itl::uint32_t groupId; ///< Group.
+            itl::uint16_t mode; ///< File type and permissions.
+            itl::uint16_t reserved0; ///< Reserved.
+            itl::uint64_t inode; ///< Inode number.
+            itl::uint64_t size; ///< Size, in bytes.
+            itl::uint64_t blocks; ///< Number of 512-byte blocks allocated.
+            itl::uint64_t attributesMask; ///< Attributes supported by the file system.
+            statx_timestamp_struct accessTime; ///< Last access.
+            statx_timestamp_struct creationTime; ///< Creation.
+            statx_timestamp_struct changeTime; ///< Last attribute change.
+            statx_timestamp_struct modificationTime; ///< Last modification.
+            itl::uint32_t deviceMajor; ///< Device of a special file, major number.
+            itl::uint32_t deviceMinor; ///< Device of a special file, minor number.
+            itl::uint32_t fileSystemMajor; ///< Device holding the file, major number.
+            itl::uint32_t fileSystemMinor; ///< Device holding the file, minor number.
+            itl::uint64_t reserved[14]; ///< Fields of newer kernels, left unread.
+        } statx_struct;
+
+        /**
+         * @brief Reads the attributes of a file.
+         *
+         * @param directory The directory file descriptor, or AT_FDCWD.
+         * @param path The path of the file, or "" with AT_EMPTY_PATH to read
+         * the attributes of directory itself.
+         * @param flags Lookup flags (e.g., AT_EMPTY_PATH).
+         * @param mask The fields to read (e.g., STATX_SIZE).
+         * @param attributes Receives the attributes.
+         * @return 0 on success, or a negated errno value on failure.
+         */
+        inline int statx(int directory, const char* path, int flags, unsigned mask, statx_struct* attributes)
+        {
+            return (int)syscall5(SYS_STATX, directory, (long)path, flags, mask, (long)attributes);
+        }
+
+        /**
+         * @brief Waits on or wakes a futex.
+         *
+         * @param address The futex word.
+         * @param operation The operation (e.g., FUTEX_WAIT, FUTEX_WAKE).
+         * @param value The expected value, or the number of waiters to wake.
+         * @param timeout The relative timeout of a wait, or nullptr.
+         * @param secondAddress The second futex word of requeue operations.
+         * @param thirdValue The extra argument of some operations.
+         * @return A result that depends on the operation, or a negated
+         * errno value on failure.
+         */
+        inline long futex(itl::uint32_t* address, int operation, itl::uint32_t value,
+            const timespec_struct* timeout, itl::uint32_t* secondAddress, itl::uint32_t thirdValue)
+        {
+            return syscall6(SYS_FUTEX, (long)address, operation, (long)value, (long)timeout,
+                (long)secondAddress, (long)thirdValue);
+        }
+
+        /**
+         * @brief Creates a process or a thread.
+         *
+         * On x86 the kernel takes the thread pointer before the child
+         * identifier; the wrapper reorders the arguments.
+         *
+         * @warning When a new stack is given, the child starts on that stack
+         * and cannot return from this function. Threads are started from an
+         * assembly trampoline instead; this wrapper suits fork-like calls.
+         *
+         * @param flags The clone flags.
+         * @param stack The top of the stack of the child, or nullptr to share
+         * a copy of the current stack.
+         * @param parentTid Receives the identifier of the child in the
+         * parent, with CLONE_PARENT_SETTID.
+         * @param childTid Receives the identifier of the child in the child,
+         * or is cleared when it exits, with CLONE_CHILD_SETTID or
+         * CLONE_CHILD_CLEARTID.
+         * @param threadPointer The thread pointer of the child, with
+         * CLONE_SETTLS.
+         * @return The identifier of the child in the parent, 0 in the child,
+         * or a negated errno value on failure.
+         */
+        inline long clone(unsigned long flags, void* stack, int* parentTid, int* childTid, unsigned long threadPointer)
+        {
+#ifdef __x86_64__
+            return syscall5(SYS_CLONE, flags, (long)stack, (long)parentTid, (long)childTid, threadPointer);
+#elif __i386__
+            return syscall5(SYS_CLONE, flags, (long)stack, (long)parentTid, threadPointer, (long)childTid);
+#endif // #ifdef __x86_64__
+        }
+
+#ifdef __x86_64__
+        /**
+         * @brief Reads or sets architecture-specific thread state.
+         *
+         * The ITL uses it to set and read the FS base, which holds the
+         * thread pointer on x86_64.
+         *
+         * @param code The operation (e.g., ARCH_SET_FS, ARCH_GET_FS).
+         * @param address The value to set, or where to store the value read.
+         * @return 0 on success, or a negated errno value on failure.
+         */
+        inline int arch_prctl(int code, unsigned long address)
+        {
+            return (int)syscall2(SYS_ARCH_PRCTL, code, address);
+        }
+#elif __i386__
+        /**
+         * @struct user_desc_struct
+         * @brief Segment descriptor exchanged with set_thread_area and
+         * clone.
+         *
+         * The flags pack the bit fields of the kernel structure: 32-bit
+         * segment (bit 0), limit in pages (bit 4) and usable (bit 6), among
+         * others.
+         */
+        typedef struct {
+            unsigned entryNumber; ///< Index in the TLS entries of the GDT, or -1 to pick a free one.
+            unsigned baseAddress; ///< Base of the segment: the thread pointer.
+            unsigned limit; ///< Limit of the segment.
+            unsigned flags; ///< Packed attribute bits.
+        } user_desc_struct;
+
+        /**
+         * @brief Installs a TLS segment descriptor for the calling thread.
+         *
+         * @param descriptor The descriptor. When its entry number is -1, the
+         * kernel picks a free entry and stores it back.
+         * @return 0 on success, or a negated errno value on failure.
+         */
+        inline int set_thread_area(user_desc_struct* descriptor)
+        {
+            return (int)syscall1(SYS_SET_THREAD_AREA, (long)descriptor);
+        }
+#endif // #ifdef __x86_64__
+
+        /**
+         * @brief Gives up the processor to another runnable thread.
+         *
+         * @return 0 on success, or a negated errno value on failure.
+         */
+        inline int sched_yield()
+        {
+            return (int)syscall0(SYS_SCHED_YIELD);
+        }
+
+        /**
+         * @brief Reads the set of processors a thread may run on.
+         *
+         * @param threadId The thread, or 0 for the calling thread.
+         * @param size The size of the mask, in bytes, a multiple of the size
+         * of a long.
+         * @param mask Receives one bit per processor.
+         * @return The number of bytes the kernel wrote, or a negated errno
+         * value on failure.
+         */
+        inline int sched_getaffinity(int threadId, itl::size_t size, unsigned long* mask)
+        {
+            return (int)syscall3(SYS_SCHED_GETAFFINITY, threadId, size, (long)mask);
+        }
+
+        /**
+         * @brief Creates an io_uring instance.
+         *
+         * @param entries The requested number of submission queue entries.
+         * @param parameters The setup parameters, updated with the offsets
+         * of the rings.
+         * @return The file descriptor of the instance, or a negated errno
+         * value on failure.
+         */
+        inline int io_uring_setup(itl::uint32_t entries, void* parameters)
+        {
+            return (int)syscall2(SYS_IO_URING_SETUP, entries, (long)parameters);
+        }
+
+        /**
+         * @brief Submits io_uring requests and waits for completions.
+         *
+         * @param ringDescriptor The file descriptor of the instance.
+         * @param toSubmit The number of queued submissions to consume.
+         * @param minimumComplete The number of completions to wait for,
+         * with IORING_ENTER_GETEVENTS.
+         * @param flags The enter flags.
+         * @param signalMask The signal mask to apply while waiting, or
+         * nullptr.
+         * @param signalMaskSize The size of the signal mask, in bytes.
+         * @return The number of submissions consumed, or a negated errno
+         * value on failure.
+         */
+        inline int io_uring_enter(int ringDescriptor, itl::uint32_t toSubmit, itl::uint32_t minimumComplete,
+            itl::uint32_t flags, const void* signalMask, itl::size_t signalMaskSize)
+        {
+            return (int)syscall6(SYS_IO_URING_ENTER, ringDescriptor, toSubmit, minimumComplete, flags,
+                (long)signalMask, signalMaskSize);
+        }
+
+        /**
+         * @brief Registers resources, such as buffers or files, with an
+         * io_uring instance.
+         *
+         * @param ringDescriptor The file descriptor of the instance.
+         * @param opcode The registration operation.
+         * @param argument The resources to register.
+         * @param count The number of resources.
+         * @return A result that depends on the operation, or a negated
+         * errno value on failure.
+         */
+        inline int io_uring_register(int ringDescriptor, itl::uint32_t opcode, const void* argument, itl::uint32_t count)
+        {
+            return (int)syscall4(SYS_IO_URING_REGISTER, ringDescriptor, opcode, (long)argument, count);
+        }
     }; // namespace syscall
 }; // namespace linux
+#endif // #ifdef __linux__
 } // namespace itl
 
 #endif // _ITL_SYSTEM_SYSCALLS_HPP
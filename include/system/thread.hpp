@@ -0,0 +1,134 @@
+/**
+ * @file include/system/thread.hpp
+ * @brief Provides threads for the ITL library.
+ * @category System
+ *
+ * This header declares functions that create and join threads directly
+ * with the clone system call, without any C library. Each thread gets a
+ * single mapping holding a guard page, its stack and its own copy of the
+ * thread-local storage of the program, so the per-thread caches of the
+ * allocator and the output buffers of itl::io work in every thread.
+ *
+ * @note These functions are only available on Linux systems on x86 and
+ * x86_64 architectures.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#ifndef _ITL_SYSTEM_THREAD_HPP
+#define _ITL_SYSTEM_THREAD_HPP
+
+#include "system/rawSyscalls.hpp"
+#include "system/syscalls.hpp"
+#include "typing/ctypes.hpp"
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace thread {
+// Clone flags
+#define CLONE_VM 0x00000100 ///< Share the address space.
+#define CLONE_FS 0x00000200 ///< Share the root, working directory and umask.
+#define CLONE_FILES 0x00000400 ///< Share the file descriptor table.
+#define CLONE_SIGHAND 0x00000800 ///< Share the signal handlers.
+#define CLONE_THREAD 0x00010000 ///< Join the thread group of the caller.
+#define CLONE_SYSVSEM 0x00040000 ///< Share System V semaphore adjustments.
+#define CLONE_SETTLS 0x00080000 ///< Set the thread pointer of the child.
+#define CLONE_PARENT_SETTID 0x00100000 ///< Store the identifier of the child in the parent.
+#define CLONE_CHILD_CLEARTID 0x00200000 ///< Clear the identifier and wake it when the child exits.
+
+/**
+ * @brief Flags creating a thread that shares everything with its creator,
+ * with its own thread pointer and an identifier cleared on exit.
+ */
+#define THREAD_CLONE_FLAGS (CLONE_VM | CLONE_FS | CLONE_FILES | CLONE_SIGHAND | CLONE_THREAD \
+    | CLONE_SYSVSEM | CLONE_SETTLS | CLONE_PARENT_SETTID | CLONE_CHILD_CLEARTID)
+
+#define THREAD_DEFAULT_STACK_SIZE (1UL << 20) ///< Stack size of threads created without an explicit one.
+#define THREAD_CONTROL_BLOCK_SIZE 64 ///< Bytes reserved at the thread pointer, after the TLS block.
+#define THREAD_MAX_CPUS 1024 ///< Processors counted by getCpuCount().
+
+    /**
+     * @struct Thread
+     * @brief A thread created with clone.
+     *
+     * The descriptor must stay valid until the thread is joined: the kernel
+     * clears its identifier when the thread exits.
+     */
+    typedef struct {
+        int threadId; ///< Identifier of the thread, cleared by the kernel when it exits.
+        void* mapping; ///< Guard page, stack and thread-local storage of the thread.
+        itl::size_t mappingSize; ///< Size of the mapping, in bytes.
+        void (*function)(void*); ///< Function run by the thread.
+        void* argument; ///< Argument passed to the function.
+    } Thread;
+
+    /**
+     * @brief Locates the thread-local storage template of the program.
+     *
+     * The template is found through the AT_PHDR entry of the auxiliary
+     * vector, so this function must run after
+     * itl::linux::auxv::initialize() and before the first thread is
+     * created. When the calling thread has no thread pointer yet, as in a
+     * program entered directly from _start, it also installs thread-local
+     * storage for it.
+     *
+     * @return 0 on success, or a negated errno value on failure.
+     */
+    int initialize();
+
+    /**
+     * @brief Starts a thread.
+     *
+     * The stack, a guard page below it and the thread-local storage are
+     * mapped together. The guard page is installed with MADV_GUARD_INSTALL,
+     * which keeps the mapping in one piece, or protected with mprotect on
+     * kernels older than 6.13. When the function returns, the thread
+     * releases its allocator cache, flushes its buffered output and exits.
+     *
+     * @param thread The thread descriptor, which must stay valid until the
+     * thread is joined.
+     * @param function The function run by the thread.
+     * @param argument The argument passed to the function.
+     * @param stackSize The size of the stack, in bytes, or 0 for
+     * THREAD_DEFAULT_STACK_SIZE.
+     * @return 0 on success, or a negated errno value on failure.
+     */
+    int createThread(itl::thread::Thread* thread, void (*function)(void*), void* argument, itl::size_t stackSize);
+
+    /**
+     * @brief Waits for a thread to exit and releases its stack and storage.
+     *
+     * @param thread The thread to join.
+     */
+    void joinThread(itl::thread::Thread* thread);
+
+    /**
+     * @brief Counts the processors the calling thread may run on.
+     *
+     * @return The number of processors in the affinity mask, at least 1.
+     */
+    itl::uint32_t getCpuCount();
+
+    /**
+     * @brief Returns the identifier of the calling thread.
+     */
+    inline int getThreadId()
+    {
+        return (int)itl::linux::syscall::syscall0(SYS_GETTID);
+    }
+
+    /**
+     * @brief Gives up the processor to another runnable thread.
+     */
+    inline void yield()
+    {
+        itl::linux::syscall::sched_yield();
+    }
+}; // namespace thread
+} // namespace itl
+
+#endif // _ITL_SYSTEM_THREAD_HPP
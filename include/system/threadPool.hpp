@@ -0,0 +1,292 @@
+/**
+ * @file include/system/threadPool.hpp
+ * @brief Provides a work-stealing thread pool for the ITL library.
+ * @category System
+ *
+ * This header declares a pool of worker threads that run tasks from
+ * per-worker Chase-Lev deques. A worker pushes and pops tasks at the
+ * bottom of its own deque without any lock, and idle workers steal from
+ * the top of the others, so fork-join code spreads over every core while
+ * each worker mostly runs the tasks it spawned, whose data is still in
+ * its cache. Waiting threads run tasks instead of blocking, and idle
+ * workers sleep on a futex.
+ *
+ * @note These functions are only available on Linux systems on x86 and
+ * x86_64 architectures.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#ifndef _ITL_SYSTEM_THREAD_POOL_HPP
+#define _ITL_SYSTEM_THREAD_POOL_HPP
+
+#include "system/sync.hpp"
+#include "system/thread.hpp"
+#include "typing/ctypes.hpp"
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace thread {
+#define POOL_DEQUE_CAPACITY 1024 ///< Tasks a worker can queue, a power of two.
+#define POOL_MAX_WORKERS 256 ///< Largest number of workers of a pool.
+#define POOL_SPIN_ROUNDS 64 ///< Rounds of looking for work before an idle thread sleeps.
+#define TASK_GROUP_WAITING 0x80000000U ///< A thread is parked until the group completes.
+#define TASK_GROUP_COUNT_MASK 0x7fffffffU ///< Number of unfinished tasks of a group.
+
+    /**
+     * @struct TaskGroup
+     * @brief A set of tasks that can be waited for together.
+     */
+    typedef struct {
+        itl::uint32_t pending; ///< Unfinished tasks, and TASK_GROUP_WAITING.
+    } TaskGroup;
+
+    /**
+     * @struct Task
+     * @brief A function to run on the pool.
+     *
+     * Tasks are owned by the caller, usually on its stack, and must stay
+     * valid until their group has been waited for, so spawning never
+     * allocates.
+     */
+    typedef struct Task {
+        void (*function)(void*); ///< Function to run.
+        void* argument; ///< Argument passed to the function.
+        itl::thread::TaskGroup* group; ///< Group completed by the task.
+        struct Task* next; ///< Next task of the injection queue.
+    } Task;
+
+    /**
+     * @struct WorkDeque
+     * @brief Chase-Lev deque of the tasks spawned by one worker.
+     *
+     * The owner pushes and pops at the bottom; other threads steal at the
+     * top. Both ends sit on their own cache line, so stealing does not
+     * disturb the owner until the deque is almost empty.
+     */
+    typedef struct {
+        itl::size_t top __attribute__((aligned(CACHE_LINE_SIZE))); ///< Next task to steal; advanced by thieves.
+        itl::size_t bottom __attribute__((aligned(CACHE_LINE_SIZE))); ///< Next free slot; written by the owner only.
+        itl::thread::Task* tasks[POOL_DEQUE_CAPACITY] __attribute__((aligned(CACHE_LINE_SIZE))); ///< Ring of tasks.
+    } WorkDeque;
+
+    /**
+     * @struct Worker
+     * @brief A thread of a pool and its deque.
+     */
+    typedef struct Worker {
+        itl::thread::WorkDeque deque; ///< Tasks spawned by the worker.
+        itl::thread::Thread thread; ///< The thread running the worker.
+        struct ThreadPool* pool; ///< Pool of the worker.
+        itl::uint32_t index; ///< Index of the worker in its pool.
+        itl::uint32_t random; ///< State of the generator choosing steal victims.
+    } Worker;
+
+    /**
+     * @struct ThreadPool
+     * @brief A set of workers sharing their tasks by stealing.
+     *
+     * Threads outside the pool queue their tasks in a shared injection
+     * queue, guarded by a mutex, that workers check before stealing.
+     */
+    typedef struct ThreadPool {
+        itl::thread::Worker* workers; ///< Array of workers.
+        itl::uint32_t workerCount; ///< Number of workers.
+        itl::uint32_t stopping; ///< Set when the pool is destroyed.
+        itl::thread::Mutex injectionLock; ///< Guards the injection queue.
+        itl::thread::Task* injectedHead; ///< Oldest task queued from outside the pool.
+        itl::thread::Task* injectedTail; ///< Newest task queued from outside the pool.
+        itl::uint32_t epoch __attribute__((aligned(CACHE_LINE_SIZE))); ///< Futex word, bumped to wake sleeping workers.
+        itl::uint32_t sleepers; ///< Workers sleeping, or about to, on the epoch.
+    } ThreadPool;
+
+    /**
+     * @brief Pushes a task at the bottom of a deque.
+     *
+     * Only the owner of the deque may call it.
+     *
+     * @return false if the deque is full.
+     */
+    inline bool pushDeque(itl::thread::WorkDeque* deque, itl::thread::Task* task)
+    {
+        itl::size_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_RELAXED);
+        itl::size_t top = __atomic_load_n(&deque->top, __ATOMIC_ACQUIRE);
+
+        if (bottom - top >= POOL_DEQUE_CAPACITY)
+            return false;
+
+        __atomic_store_n(&deque->tasks[bottom & (POOL_DEQUE_CAPACITY - 1)], task, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        __atomic_store_n(&deque->bottom, bottom + 1, __ATOMIC_RELAXED);
+
+        return true;
+    }
+
+    /**
+     * @brief Pops the newest task from the bottom of a deque.
+     *
+     * Only the owner of the deque may call it.
+     *
+     * @return The task, or nullptr if the deque is empty.
+     */
+    inline itl::thread::Task* popDeque(itl::thread::WorkDeque* deque)
+    {
+        itl::size_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_RELAXED) - 1;
+
+        // Claim the slot before looking at the top, so a thief that read
+        // the old bottom and the owner cannot both miss each other.
+        __atomic_store_n(&deque->bottom, bottom, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+        itl::size_t top = __atomic_load_n(&deque->top, __ATOMIC_RELAXED);
+
+        if ((itl::ssize_t)(bottom - top) < 0) {
+            __atomic_store_n(&deque->bottom, bottom + 1, __ATOMIC_RELAXED);
+            return nullptr;
+        }
+
+        itl::thread::Task* task = __atomic_load_n(&deque->tasks[bottom & (POOL_DEQUE_CAPACITY - 1)], __ATOMIC_RELAXED);
+
+        if (bottom != top)
+            return task;
+
+        // The last task is raced for with the thieves on the top.
+        if (!__atomic_compare_exchange_n(&deque->top, &top, top + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+            task = nullptr;
+
+        __atomic_store_n(&deque->bottom, bottom + 1, __ATOMIC_RELAXED);
+        return task;
+    }
+
+    /**
+     * @brief Steals the oldest task from the top of a deque.
+     *
+     * Any thread may call it.
+     *
+     * @return The task, or nullptr if the deque is empty or another thread
+     * took the task first.
+     */
+    inline itl::thread::Task* stealDeque(itl::thread::WorkDeque* deque)
+    {
+        itl::size_t top = __atomic_load_n(&deque->top, __ATOMIC_ACQUIRE);
+
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+        itl::size_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_ACQUIRE);
+
+        if ((itl::ssize_t)(bottom - top) <= 0)
+            return nullptr;
+
+        itl::thread::Task* task = __atomic_load_n(&deque->tasks[top & (POOL_DEQUE_CAPACITY - 1)], __ATOMIC_RELAXED);
+
+        if (!__atomic_compare_exchange_n(&deque->top, &top, top + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+            return nullptr;
+
+        return task;
+    }
+
+    /**
+     * @brief Reports whether a deque looks empty.
+     */
+    inline bool isDequeEmpty(const itl::thread::WorkDeque* deque)
+    {
+        return (itl::ssize_t)(__atomic_load_n(&deque->bottom, __ATOMIC_RELAXED) - __atomic_load_n(&deque->top, __ATOMIC_RELAXED)) <= 0;
+    }
+
+    /**
+     * @brief Starts the workers of a pool.
+     *
+     * itl::thread::initialize() must have run before.
+     *
+     * @param pool The pool to start.
+     * @param workerCount The number of workers, or 0 for one less than the
+     * number of processors, since the thread waiting for the tasks runs
+     * them too.
+     * @return 0 on success, or a negated errno value on failure.
+     */
+    int createPool(itl::thread::ThreadPool* pool, itl::uint32_t workerCount);
+
+    /**
+     * @brief Stops and joins the workers of a pool and releases it.
+     *
+     * Every task group must have been waited for.
+     *
+     * @param pool The pool to destroy.
+     */
+    void destroyPool(itl::thread::ThreadPool* pool);
+
+    /**
+     * @brief Prepares an empty task group.
+     */
+    inline void initializeTaskGroup(itl::thread::TaskGroup* group)
+    {
+        group->pending = 0;
+    }
+
+    /**
+     * @brief Queues a task on a pool.
+     *
+     * A worker of the pool pushes the task on its own deque, or runs it at
+     * once when the deque is full; other threads queue it in the injection
+     * queue. A sleeping worker is woken if there is one.
+     *
+     * @param pool The pool to run the task on.
+     * @param group The group the task belongs to.
+     * @param task The task, valid until the group has been waited for.
+     * @param function The function to run.
+     * @param argument The argument passed to the function.
+     */
+    void spawnTask(itl::thread::ThreadPool* pool, itl::thread::TaskGroup* group, itl::thread::Task* task,
+        void (*function)(void*), void* argument);
+
+    /**
+     * @brief Waits until every task of a group has finished.
+     *
+     * The calling thread runs queued tasks of the pool while it waits, and
+     * only parks when there is nothing left to run.
+     *
+     * @param pool The pool running the tasks.
+     * @param group The group to wait for.
+     */
+    void waitTaskGroup(itl::thread::ThreadPool* pool, itl::thread::TaskGroup* group);
+
+    /**
+     * @brief Runs two functions in parallel and waits for both.
+     *
+     * The second function is queued and the first one runs on the calling
+     * thread.
+     */
+    void forkJoin(itl::thread::ThreadPool* pool, void (*first)(void*), void* firstArgument,
+        void (*second)(void*), void* secondArgument);
+
+    /**
+     * @brief Runs a function over a range of indices in parallel.
+     *
+     * The range is split in halves down to the grain, and the upper halves
+     * are spawned as tasks, so thieves take the largest pieces left while
+     * each thread works through contiguous indices.
+     *
+     * @param pool The pool to run on.
+     * @param begin The first index.
+     * @param end One past the last index.
+     * @param grain The largest piece run by one call, or 0 to pick one from
+     * the number of workers.
+     * @param function Called with the argument and a [begin, end) piece.
+     * @param argument The argument passed to the function.
+     */
+    void parallelFor(itl::thread::ThreadPool* pool, itl::size_t begin, itl::size_t end, itl::size_t grain,
+        void (*function)(void*, itl::size_t, itl::size_t), void* argument);
+
+    /**
+     * @brief Returns the index of the calling worker, or -1 outside of any
+     * pool.
+     */
+    int getWorkerIndex();
+}; // namespace thread
+} // namespace itl
+
+#endif // _ITL_SYSTEM_THREAD_POOL_HPP
@@ -0,0 +1,164 @@
+/**
+ * @file include/system/time.hpp
+ * @brief Provides high-resolution clocks for the ITL library.
+ * @category System
+ *
+ * This header declares functions that read the clocks of the kernel and
+ * the time stamp counter of the processor. Clocks are read through the
+ * clock_gettime function exported by the vDSO, a small shared object the
+ * kernel maps into every process, so reading the time does not enter the
+ * kernel. The time stamp counter is calibrated against the monotonic
+ * clock, which makes it usable as a nanosecond timestamp for
+ * instrumentation.
+ *
+ * @note These functions are only available on Linux systems on x86 and
+ * x86_64 architectures.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#ifndef _ITL_SYSTEM_TIME_HPP
+#define _ITL_SYSTEM_TIME_HPP
+
+#include "system/syscalls.hpp"
+#include "typing/ctypes.hpp"
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace time {
+// Clock identifiers
+#define CLOCK_REALTIME 0 ///< Wall-clock time.
+#define CLOCK_MONOTONIC 1 ///< Time since an unspecified point, never set backwards.
+#define CLOCK_PROCESS_CPUTIME_ID 2 ///< Processor time consumed by the process.
+#define CLOCK_THREAD_CPUTIME_ID 3 ///< Processor time consumed by the thread.
+#define CLOCK_MONOTONIC_RAW 4 ///< Monotonic time, not adjusted by NTP.
+#define CLOCK_REALTIME_COARSE 5 ///< Faster, tick-resolution wall-clock time.
+#define CLOCK_MONOTONIC_COARSE 6 ///< Faster, tick-resolution monotonic time.
+#define CLOCK_BOOTTIME 7 ///< Monotonic time, including time spent suspended.
+
+#define NANOSECONDS_PER_SECOND 1000000000ULL ///< Nanoseconds in a second.
+#define TIME_CALIBRATION_NANOSECONDS 10000000 ///< Default duration of the cycle calibration.
+
+    /**
+     * @brief A time value, as read from a clock.
+     */
+    typedef itl::linux::syscall::timespec_struct TimeSpec;
+
+    /**
+     * @brief Locates clock_gettime and clock_getres in the vDSO.
+     *
+     * The vDSO is found through the AT_SYSINFO_EHDR entry of the auxiliary
+     * vector, so this function must run after
+     * itl::linux::auxv::initialize(). Clock functions call it on their
+     * first use, but calling it explicitly at startup keeps the lookup out
+     * of measured code. When the vDSO is missing, clocks are read with the
+     * raw system calls.
+     */
+    void initialize();
+
+    /**
+     * @brief Reports whether clocks are read through the vDSO.
+     *
+     * @return true if clock_gettime was found in the vDSO.
+     */
+    bool hasVdso();
+
+    /**
+     * @brief Reads the current value of a clock.
+     *
+     * @param clock The identifier of the clock (e.g., CLOCK_MONOTONIC).
+     * @param time Receives the value of the clock.
+     * @return 0 on success, or a negated errno value on failure.
+     */
+    int getTime(int clock, itl::time::TimeSpec* time);
+
+    /**
+     * @brief Reads the resolution of a clock.
+     *
+     * @param clock The identifier of the clock (e.g., CLOCK_MONOTONIC).
+     * @param resolution Receives the resolution of the clock.
+     * @return 0 on success, or a negated errno value on failure.
+     */
+    int getResolution(int clock, itl::time::TimeSpec* resolution);
+
+    /**
+     * @brief Reads CLOCK_MONOTONIC.
+     *
+     * @return The monotonic time, in nanoseconds.
+     */
+    itl::uint64_t monotonicNanoseconds();
+
+    /**
+     * @brief Reads CLOCK_REALTIME.
+     *
+     * @return The time elapsed since the Unix epoch, in nanoseconds.
+     */
+    itl::uint64_t realtimeNanoseconds();
+
+    /**
+     * @brief Reads the time stamp counter, ordered after earlier loads.
+     *
+     * The lfence keeps the read from being executed before the
+     * instructions that precede it, so the counter can delimit a measured
+     * region.
+     *
+     * @return The current value of the time stamp counter.
+     */
+    inline itl::uint64_t readCycles()
+    {
+        __asm__ volatile("lfence" ::: "memory");
+        return __builtin_ia32_rdtsc();
+    }
+
+    /**
+     * @brief Measures the frequency of the time stamp counter against
+     * CLOCK_MONOTONIC.
+     *
+     * The calibration spins for the given duration, so it belongs in
+     * startup code. It can be repeated to correct the drift of a long
+     * running process: the result is published under a sequence lock, so
+     * threads converting cycles meanwhile see either the old or the new
+     * calibration, never a mix of both.
+     *
+     * @param durationNanoseconds How long to measure, from 1 microsecond to
+     * 1 second, or 0 for TIME_CALIBRATION_NANOSECONDS.
+     * @return true if the processor has an invariant time stamp counter,
+     * which ticks at a constant rate on every core.
+     */
+    bool calibrateCycles(itl::uint64_t durationNanoseconds);
+
+    /**
+     * @brief Returns the measured frequency of the time stamp counter.
+     *
+     * @return The frequency, in hertz, or 0 before calibration.
+     */
+    itl::uint64_t getCycleFrequency();
+
+    /**
+     * @brief Converts a number of time stamp counter cycles to nanoseconds.
+     *
+     * Before calibration, one cycle counts as one nanosecond.
+     *
+     * @param cycles The number of cycles.
+     * @return The duration, in nanoseconds.
+     */
+    itl::uint64_t cyclesToNanoseconds(itl::uint64_t cycles);
+
+    /**
+     * @brief Reads a monotonic timestamp from the time stamp counter.
+     *
+     * The timestamp is on the same scale as monotonicNanoseconds(), from
+     * the last calibration on. Without a calibrated invariant counter, it
+     * reads CLOCK_MONOTONIC instead.
+     *
+     * @return The monotonic time, in nanoseconds.
+     */
+    itl::uint64_t timestamp();
+}; // namespace time
+} // namespace itl
+
+#endif // _ITL_SYSTEM_TIME_HPP
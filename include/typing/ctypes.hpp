@@ -69,6 +69,54 @@ typedef signed int intptr_t;
 typedef unsigned int uintptr_t;
 #endif // __i386__
 
+/**
+ * @typedef int8_t
+ * @brief Signed integer type of exactly 8 bits.
+ */
+typedef signed char int8_t;
+
+/**
+ * @typedef uint8_t
+ * @brief Unsigned integer type of exactly 8 bits.
+ */
+typedef unsigned char uint8_t;
+
+/**
+ * @typedef int16_t
+ * @brief Signed integer type of exactly 16 bits.
+ */
+typedef signed short int16_t;
+
+/**
+ * @typedef uint16_t
+ * @brief Unsigned integer type of exactly 16 bits.
+ */
+typedef unsigned short uint16_t;
+
+/**
+ * @typedef int32_t
+ * @brief Signed integer type of exactly 32 bits.
+ */
+typedef signed int int32_t;
+
+/**
+ * @typedef uint32_t
+ * @brief Unsigned integer type of exactly 32 bits.
+ */
+typedef unsigned int uint32_t;
+
+/**
+ * @typedef int64_t
+ * @brief Signed integer type of exactly 64 bits, on both architectures.
+ */
+typedef signed long long int64_t;
+
+/**
+ * @typedef uint64_t
+ * @brief Unsigned integer type of exactly 64 bits, on both architectures.
+ */
+typedef unsigned long long uint64_t;
+
 /**
  * @typedef char_ptr
  * @brief Pointer to a character.
@@ -0,0 +1,683 @@
+/**
+ * @file src/containers/matrix.cpp
+ * @brief Implements the kernels of the ITL matrices.
+ * @category Containers
+ *
+ * This file contains the blocked multiplication, with its packing
+ * routines, register-tiled micro-kernels and parallel driver, and the
+ * transposing copy. The kernels are written once over the vector width
+ * and compiled for each instruction set of itl::simd; the level itl::simd
+ * selected also selects them.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#include "containers/matrix.hpp"
+#include "memory/allocator.hpp"
+#include "system/rawSyscalls.hpp"
+#include "system/simd.hpp"
+#include "system/threadPool.hpp"
+#include "typing/ctypes.hpp"
+
+/**
+ * @struct Sequence
+ * @brief A pack of integer constants, to expand shuffle masks.
+ */
+template <typename T, T... I>
+struct Sequence {
+};
+
+/**
+ * @struct GemmKernel
+ * @brief The macro-kernel of one instruction set and its micro-tile.
+ */
+template <typename T>
+struct GemmKernel {
+    itl::size_t height; ///< Rows of a micro-tile, dividing MATRIX_BLOCK_M.
+    itl::size_t width; ///< Columns of a micro-tile, dividing MATRIX_PARALLEL_COLUMNS.
+    void (*run)(itl::size_t rows, itl::size_t columns, itl::size_t depth, const T* packedA, const T* packedB, T* c,
+        itl::size_t rowStride, itl::size_t columnStride, T alpha, T beta); ///< Multiplies packed blocks into c.
+};
+
+/**
+ * @struct GemmPass
+ * @brief State shared by the tasks multiplying one packed panel of b.
+ */
+template <typename T>
+struct GemmPass {
+    itl::matrix::View<T> a; ///< The left operand.
+    itl::matrix::View<T> c; ///< The result.
+    const GemmKernel<T>* kernel; ///< The kernel of the selected level.
+    const T* packedB; ///< The packed panel of b.
+    T** packedA; ///< One buffer per thread that may run a task.
+    itl::uint32_t* claimed; ///< Whether each buffer is in use.
+    itl::size_t buffers; ///< Number of buffers.
+    itl::size_t column; ///< First column of c covered by the panel.
+    itl::size_t columns; ///< Columns of c covered by the panel.
+    itl::size_t depthStart; ///< First column of a covered by the panel.
+    itl::size_t depth; ///< Columns of a covered by the panel.
+    itl::size_t bufferDepth; ///< Depth the buffers of a are allocated for, that of the deepest panel.
+    itl::size_t chunks; ///< Column chunks the panel is split into.
+    itl::size_t chunkWidth; ///< Columns of one chunk.
+    T alpha; ///< The factor of the product.
+    T beta; ///< The factor of c for this panel.
+    itl::uint32_t failed; ///< Set when a task could not allocate its buffer.
+};
+
+#pragma GCC push_options
+// Let the compiler fuse the multiplications and additions of the kernels
+// into FMA instructions wherever the target has them.
+#pragma GCC optimize("fp-contract=fast")
+
+/**
+ * @brief Computes a micro-tile of c from a sliver of packed a and one of
+ * packed b.
+ *
+ * The ROWS by VECTORS accumulators stay in registers for the whole depth;
+ * each step loads VECTORS vectors of b and broadcasts ROWS elements of a.
+ * Full tiles of row-major results are stored with vector instructions,
+ * the others element by element.
+ */
+template <typename T, int LANES, int VECTORS, int ROWS>
+static inline void __internal_microKernel(itl::size_t depth, const T* packedA, const T* packedB, T* c,
+    itl::size_t rowStride, itl::size_t columnStride, itl::size_t rows, itl::size_t columns, T alpha, T beta)
+{
+    typedef T Vector __attribute__((vector_size(sizeof(T) * LANES)));
+    typedef T Aligned __attribute__((vector_size(sizeof(T) * LANES), may_alias));
+    typedef T Unaligned __attribute__((vector_size(sizeof(T) * LANES), may_alias, aligned(sizeof(T))));
+
+    constexpr itl::size_t width = LANES * VECTORS;
+    Vector sums[ROWS][VECTORS] = {};
+
+    for (itl::size_t step = 0; step < depth; ++step) {
+        Vector right[VECTORS];
+
+#pragma GCC unroll 16
+        for (int vector = 0; vector < VECTORS; ++vector)
+            right[vector] = *(const Aligned*)(packedB + step * width + vector * LANES);
+
+#pragma GCC unroll 16
+        for (int row = 0; row < ROWS; ++row) {
+            Vector left = (Vector) {} + packedA[step * ROWS + row];
+
+#pragma GCC unroll 16
+            for (int vector = 0; vector < VECTORS; ++vector)
+                sums[row][vector] += left * right[vector];
+        }
+    }
+
+    if (rows == ROWS && columns == width && columnStride == 1) {
+#pragma GCC unroll 16
+        for (int row = 0; row < ROWS; ++row) {
+#pragma GCC unroll 16
+            for (int vector = 0; vector < VECTORS; ++vector) {
+                Unaligned* target = (Unaligned*)(c + row * rowStride + vector * LANES);
+
+                *target = beta == 0 ? sums[row][vector] * alpha : sums[row][vector] * alpha + *target * beta;
+            }
+        }
+
+        return;
+    }
+
+    for (itl::size_t row = 0; row < rows; ++row) {
+        for (itl::size_t column = 0; column < columns; ++column) {
+            T value = alpha * sums[row][column / LANES][column % LANES];
+            T* target = c + row * rowStride + column * columnStride;
+
+            *target = beta == 0 ? value : value + beta * *target;
+        }
+    }
+}
+
+/**
+ * @brief Multiplies a packed block of a by a packed panel of b, one
+ * micro-tile at a time.
+ *
+ * The sliver of b is kept while the slivers of a stream past it, so it
+ * stays in the L1 cache and the block of a in the L2 cache.
+ */
+template <typename T, int LANES, int VECTORS, int ROWS>
+static inline void __internal_macroKernel(itl::size_t rows, itl::size_t columns, itl::size_t depth,
+    const T* packedA, const T* packedB, T* c, itl::size_t rowStride, itl::size_t columnStride, T alpha, T beta)
+{
+    constexpr itl::size_t width = LANES * VECTORS;
+
+    for (itl::size_t column = 0; column < columns; column += width) {
+        itl::size_t tileColumns = columns - column < width ? columns - column : width;
+        const T* sliverB = packedB + column * depth;
+
+        for (itl::size_t row = 0; row < rows; row += ROWS) {
+            itl::size_t tileRows = rows - row < ROWS ? rows - row : ROWS;
+
+            __internal_microKernel<T, LANES, VECTORS, ROWS>(depth, packedA + row * depth, sliverB,
+                c + row * rowStride + column * columnStride, rowStride, columnStride, tileRows, tileColumns, alpha, beta);
+        }
+    }
+}
+
+/**
+ * @brief Interleaves the low halves of two vectors into zipped.
+ */
+template <typename V, int... I>
+static inline void __internal_zipLow(const V& first, const V& second, V* zipped, Sequence<int, I...>)
+{
+    *zipped = __builtin_shufflevector(first, second, ((I & 1) ? (int)sizeof...(I) + I / 2 : I / 2)...);
+}
+
+/**
+ * @brief Interleaves the high halves of two vectors into zipped.
+ */
+template <typename V, int... I>
+static inline void __internal_zipHigh(const V& first, const V& second, V* zipped, Sequence<int, I...>)
+{
+    *zipped = __builtin_shufflevector(first, second,
+        ((I & 1) ? (int)sizeof...(I) + (int)sizeof...(I) / 2 + I / 2 : (int)sizeof...(I) / 2 + I / 2)...);
+}
+
+/**
+ * @brief Transposes a square of LANES vectors of LANES elements.
+ *
+ * Row i of a round is zipped with row i + LANES / 2; each round rotates
+ * the bits of the element indices by one, so log2(LANES) rounds swap the
+ * row and column bits.
+ */
+template <typename V, int LANES>
+static inline void __internal_transposeSquare(V* lines)
+{
+#pragma GCC unroll 8
+    for (int round = 1; round < LANES; round *= 2) {
+        V zipped[LANES];
+
+#pragma GCC unroll 16
+        for (int line = 0; line < LANES / 2; ++line) {
+            __internal_zipLow(lines[line], lines[line + LANES / 2], &zipped[2 * line], Sequence<int, __integer_pack(LANES)...> {});
+            __internal_zipHigh(lines[line], lines[line + LANES / 2], &zipped[2 * line + 1], Sequence<int, __integer_pack(LANES)...> {});
+        }
+
+#pragma GCC unroll 16
+        for (int line = 0; line < LANES; ++line)
+            lines[line] = zipped[line];
+    }
+}
+
+/**
+ * @brief Stores the transpose of a row-major matrix into another.
+ *
+ * destination[column * destinationStride + row] receives
+ * source[row * sourceStride + column], walking MATRIX_TRANSPOSE_TILE
+ * squares so both sides stay in cache, and transposing LANES by LANES
+ * squares in registers within them.
+ */
+template <typename T, int LANES>
+static inline void __internal_transposeKernel(const T* source, itl::size_t sourceStride, T* destination,
+    itl::size_t destinationStride, itl::size_t rows, itl::size_t columns)
+{
+    typedef T Vector __attribute__((vector_size(sizeof(T) * LANES)));
+    typedef T Unaligned __attribute__((vector_size(sizeof(T) * LANES), may_alias, aligned(sizeof(T))));
+
+    for (itl::size_t rowTile = 0; rowTile < rows; rowTile += MATRIX_TRANSPOSE_TILE) {
+        itl::size_t rowEnd = rows - rowTile < MATRIX_TRANSPOSE_TILE ? rows : rowTile + MATRIX_TRANSPOSE_TILE;
+
+        for (itl::size_t columnTile = 0; columnTile < columns; columnTile += MATRIX_TRANSPOSE_TILE) {
+            itl::size_t columnEnd = columns - columnTile < MATRIX_TRANSPOSE_TILE ? columns : columnTile + MATRIX_TRANSPOSE_TILE;
+            itl::size_t row = rowTile;
+
+            for (; row + LANES <= rowEnd; row += LANES) {
+                itl::size_t column = columnTile;
+
+                for (; column + LANES <= columnEnd; column += LANES) {
+                    Vector lines[LANES];
+
+#pragma GCC unroll 16
+                    for (int line = 0; line < LANES; ++line)
+                        lines[line] = *(const Unaligned*)(source + (row + line) * sourceStride + column);
+
+                    __internal_transposeSquare<Vector, LANES>(lines);
+
+#pragma GCC unroll 16
+                    for (int line = 0; line < LANES; ++line)
+                        *(Unaligned*)(destination + (column + line) * destinationStride + row) = lines[line];
+                }
+
+                for (; column < columnEnd; ++column)
+                    for (itl::size_t line = 0; line < LANES; ++line)
+                        destination[column * destinationStride + row + line] = source[(row + line) * sourceStride + column];
+            }
+
+            for (; row < rowEnd; ++row)
+                for (itl::size_t column = columnTile; column < columnEnd; ++column)
+                    destination[column * destinationStride + row] = source[row * sourceStride + column];
+        }
+    }
+}
+#pragma GCC pop_options
+
+/**
+ * @brief Instantiates the kernels of one instruction set for floats and
+ * doubles, with everything they call inlined into them.
+ */
+#define MATRIX_DEFINE_KERNELS(NAME, FLOAT_LANES, DOUBLE_LANES, VECTORS, ROWS, ...)                                   \
+    __attribute__((__VA_ARGS__)) static void __internal_multiplyFloats##NAME(itl::size_t rows, itl::size_t columns, \
+        itl::size_t depth, const float* packedA, const float* packedB, float* c, itl::size_t rowStride,              \
+        itl::size_t columnStride, float alpha, float beta)                                                           \
+    {                                                                                                                \
+        __internal_macroKernel<float, FLOAT_LANES, VECTORS, ROWS>(rows, columns, depth, packedA, packedB, c,         \
+            rowStride, columnStride, alpha, beta);                                                                   \
+    }                                                                                                                \
+    __attribute__((__VA_ARGS__)) static void __internal_multiplyDoubles##NAME(itl::size_t rows, itl::size_t columns, \
+        itl::size_t depth, const double* packedA, const double* packedB, double* c, itl::size_t rowStride,           \
+        itl::size_t columnStride, double alpha, double beta)                                                         \
+    {                                                                                                                \
+        __internal_macroKernel<double, DOUBLE_LANES, VECTORS, ROWS>(rows, columns, depth, packedA, packedB, c,       \
+            rowStride, columnStride, alpha, beta);                                                                   \
+    }                                                                                                                \
+    __attribute__((__VA_ARGS__)) static void __internal_transposeFloats##NAME(const float* source,                   \
+        itl::size_t sourceStride, float* destination, itl::size_t destinationStride, itl::size_t rows,               \
+        itl::size_t columns)                                                                                         \
+    {                                                                                                                \
+        __internal_transposeKernel<float, FLOAT_LANES>(source, sourceStride, destination, destinationStride, rows,   \
+            columns);                                                                                                \
+    }                                                                                                                \
+    __attribute__((__VA_ARGS__)) static void __internal_transposeDoubles##NAME(const double* source,                 \
+        itl::size_t sourceStride, double* destination, itl::size_t destinationStride, itl::size_t rows,              \
+        itl::size_t columns)                                                                                         \
+    {                                                                                                                \
+        __internal_transposeKernel<double, DOUBLE_LANES>(source, sourceStride, destination, destinationStride, rows, \
+            columns);                                                                                                \
+    }
+
+// 32-bit targets have half as many vector registers, so their tiles are
+// kept short enough for the accumulators not to spill.
+#ifdef __x86_64__
+MATRIX_DEFINE_KERNELS(Scalar, 1, 1, 4, 4, flatten)
+MATRIX_DEFINE_KERNELS(Sse2, 4, 2, 2, 6, target("sse2"), flatten)
+MATRIX_DEFINE_KERNELS(Avx2, 8, 4, 2, 6, target("avx2,fma"), flatten)
+MATRIX_DEFINE_KERNELS(Avx512, 16, 8, 2, 8, target("avx512f,avx512bw,avx2,fma"), flatten)
+#elif __i386__
+MATRIX_DEFINE_KERNELS(Scalar, 1, 1, 2, 2, flatten)
+MATRIX_DEFINE_KERNELS(Sse2, 4, 2, 2, 2, target("sse2"), flatten)
+MATRIX_DEFINE_KERNELS(Avx2, 8, 4, 2, 2, target("avx2,fma"), flatten)
+MATRIX_DEFINE_KERNELS(Avx512, 16, 8, 2, 2, target("avx512f,avx512bw,avx2,fma"), flatten)
+#endif // #ifdef __x86_64__
+
+#ifdef __x86_64__
+static const GemmKernel<float> internalFloatKernels[] = {
+    { 4, 4, __internal_multiplyFloatsScalar },
+    { 6, 8, __internal_multiplyFloatsSse2 },
+    { 6, 16, __internal_multiplyFloatsAvx2 },
+    { 8, 32, __internal_multiplyFloatsAvx512 },
+};
+
+static const GemmKernel<double> internalDoubleKernels[] = {
+    { 4, 4, __internal_multiplyDoublesScalar },
+    { 6, 4, __internal_multiplyDoublesSse2 },
+    { 6, 8, __internal_multiplyDoublesAvx2 },
+    { 8, 16, __internal_multiplyDoublesAvx512 },
+};
+#elif __i386__
+static const GemmKernel<float> internalFloatKernels[] = {
+    { 2, 2, __internal_multiplyFloatsScalar },
+    { 2, 8, __internal_multiplyFloatsSse2 },
+    { 2, 16, __internal_multiplyFloatsAvx2 },
+    { 2, 32, __internal_multiplyFloatsAvx512 },
+};
+
+static const GemmKernel<double> internalDoubleKernels[] = {
+    { 2, 2, __internal_multiplyDoublesScalar },
+    { 2, 4, __internal_multiplyDoublesSse2 },
+    { 2, 8, __internal_multiplyDoublesAvx2 },
+    { 2, 16, __internal_multiplyDoublesAvx512 },
+};
+#endif // #ifdef __x86_64__
+
+static void (*const internalFloatTransposes[])(const float*, itl::size_t, float*, itl::size_t, itl::size_t, itl::size_t) = {
+    __internal_transposeFloatsScalar,
+    __internal_transposeFloatsSse2,
+    __internal_transposeFloatsAvx2,
+    __internal_transposeFloatsAvx512,
+};
+
+static void (*const internalDoubleTransposes[])(const double*, itl::size_t, double*, itl::size_t, itl::size_t, itl::size_t) = {
+    __internal_transposeDoublesScalar,
+    __internal_transposeDoublesSse2,
+    __internal_transposeDoublesAvx2,
+    __internal_transposeDoublesAvx512,
+};
+
+/**
+ * @brief Returns the multiplication kernel of the level selected by
+ * itl::simd.
+ */
+static const GemmKernel<float>* __internal_selectMultiply(float)
+{
+    return &internalFloatKernels[itl::simd::getLevel()];
+}
+
+static const GemmKernel<double>* __internal_selectMultiply(double)
+{
+    return &internalDoubleKernels[itl::simd::getLevel()];
+}
+
+/**
+ * @brief Returns the transposing kernel of the level selected by
+ * itl::simd.
+ */
+static void (*__internal_selectTranspose(float))(const float*, itl::size_t, float*, itl::size_t, itl::size_t, itl::size_t)
+{
+    return internalFloatTransposes[itl::simd::getLevel()];
+}
+
+static void (*__internal_selectTranspose(double))(const double*, itl::size_t, double*, itl::size_t, itl::size_t, itl::size_t)
+{
+    return internalDoubleTransposes[itl::simd::getLevel()];
+}
+
+/**
+ * @brief Packs a block of a into slivers of height rows, each stored
+ * column after column, padding the last one with zeros.
+ */
+template <typename T>
+static void __internal_packA(const itl::matrix::View<T>& a, itl::size_t row, itl::size_t rows, itl::size_t depthStart,
+    itl::size_t depth, itl::size_t height, T* packed)
+{
+    for (itl::size_t sliver = 0; sliver < rows; sliver += height) {
+        itl::size_t valid = rows - sliver < height ? rows - sliver : height;
+        const T* origin = &a(row + sliver, depthStart);
+
+        for (itl::size_t step = 0; step < depth; ++step) {
+            const T* column = origin + step * a.columnStride;
+            itl::size_t line = 0;
+
+            for (; line < valid; ++line)
+                packed[line] = column[line * a.rowStride];
+
+            for (; line < height; ++line)
+                packed[line] = 0;
+
+            packed += height;
+        }
+    }
+}
+
+/**
+ * @brief Packs a panel of b into slivers of width columns, each stored
+ * row after row, padding the last one with zeros.
+ */
+template <typename T>
+static void __internal_packB(const itl::matrix::View<T>& b, itl::size_t depthStart, itl::size_t depth,
+    itl::size_t column, itl::size_t columns, itl::size_t width, T* packed)
+{
+    for (itl::size_t sliver = 0; sliver < columns; sliver += width) {
+        itl::size_t valid = columns - sliver < width ? columns - sliver : width;
+        const T* origin = &b(depthStart, column + sliver);
+
+        for (itl::size_t step = 0; step < depth; ++step) {
+            const T* row = origin + step * b.rowStride;
+            itl::size_t line = 0;
+
+            if (b.columnStride == 1) {
+                for (; line < valid; ++line)
+                    packed[line] = row[line];
+            } else {
+                for (; line < valid; ++line)
+                    packed[line] = row[line * b.columnStride];
+            }
+
+            for (; line < width; ++line)
+                packed[line] = 0;
+
+            packed += width;
+        }
+    }
+}
+
+/**
+ * @brief Multiplies c by beta, clearing it when beta is 0.
+ */
+template <typename T>
+static void __internal_scale(const itl::matrix::View<T>& c, T beta)
+{
+    for (itl::size_t row = 0; row < c.rows; ++row) {
+        if (beta == 0 && c.columnStride == 1) {
+            itl::simd::fill(&c(row, 0), 0, c.columns * sizeof(T));
+            continue;
+        }
+
+        for (itl::size_t column = 0; column < c.columns; ++column)
+            c(row, column) = beta == 0 ? 0 : c(row, column) * beta;
+    }
+}
+
+/**
+ * @brief Runs the tasks of a pass from begin to end.
+ *
+ * Task t covers block t / chunks of the rows of c and chunk t % chunks of
+ * the columns of the panel. The calling thread claims one of the packing
+ * buffers for the duration, so threads never share one, and packs each
+ * block of a only once when it runs consecutive chunks of it.
+ */
+template <typename T>
+static void __internal_runTasks(void* argument, itl::size_t begin, itl::size_t end)
+{
+    GemmPass<T>* pass = (GemmPass<T>*)argument;
+    const GemmKernel<T>* kernel = pass->kernel;
+    itl::size_t slot = 0;
+
+    while (__atomic_exchange_n(&pass->claimed[slot], 1, __ATOMIC_ACQUIRE) != 0)
+        slot = slot + 1 == pass->buffers ? 0 : slot + 1;
+
+    T* packedA = pass->packedA[slot];
+
+    if (packedA == nullptr) {
+        packedA = (T*)itl::allocAligned(MATRIX_BLOCK_M * pass->bufferDepth * sizeof(T), MATRIX_ALIGNMENT);
+        pass->packedA[slot] = packedA;
+    }
+
+    if (packedA == nullptr) {
+        __atomic_store_n(&pass->failed, 1, __ATOMIC_RELAXED);
+        __atomic_store_n(&pass->claimed[slot], 0, __ATOMIC_RELEASE);
+        return;
+    }
+
+    itl::size_t packedBlock = (itl::size_t)-1;
+
+    for (itl::size_t task = begin; task < end; ++task) {
+        itl::size_t block = task / pass->chunks;
+        itl::size_t row = block * MATRIX_BLOCK_M;
+        itl::size_t rows = pass->c.rows - row < MATRIX_BLOCK_M ? pass->c.rows - row : MATRIX_BLOCK_M;
+        itl::size_t chunk = (task % pass->chunks) * pass->chunkWidth;
+        itl::size_t columns = pass->columns - chunk < pass->chunkWidth ? pass->columns - chunk : pass->chunkWidth;
+
+        if (block != packedBlock) {
+            __internal_packA(pass->a, row, rows, pass->depthStart, pass->depth, kernel->height, packedA);
+            packedBlock = block;
+        }
+
+        kernel->run(rows, columns, pass->depth, packedA, pass->packedB + chunk * pass->depth,
+            &pass->c(row, pass->column + chunk), pass->c.rowStride, pass->c.columnStride, pass->alpha, pass->beta);
+    }
+
+    __atomic_store_n(&pass->claimed[slot], 0, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Multiplies two views with the kernels of the selected level.
+ *
+ * The columns of c are walked in panels of MATRIX_BLOCK_N and the depth
+ * in steps of MATRIX_BLOCK_K. Each panel of b is packed once and shared
+ * by every block of MATRIX_BLOCK_M rows of a, which each task packs for
+ * itself.
+ */
+template <typename T>
+static int __internal_multiply(itl::matrix::View<T> a, itl::matrix::View<T> b, itl::matrix::View<T> c, T alpha, T beta,
+    itl::thread::ThreadPool* pool)
+{
+    if (a.rows != c.rows || b.columns != c.columns || a.columns != b.rows)
+        return -EINVAL;
+
+    // A column-major result is computed as its transpose, the product of
+    // the transposed operands in reverse order, so the kernels always
+    // store along rows.
+    if (c.columnStride != 1 && c.rowStride == 1) {
+        itl::matrix::View<T> left = a;
+
+        a = b.transposed();
+        b = left.transposed();
+        c = c.transposed();
+    }
+
+    if (c.rows == 0 || c.columns == 0)
+        return 0;
+
+    if (a.columns == 0 || alpha == 0) {
+        __internal_scale(c, beta);
+        return 0;
+    }
+
+    const GemmKernel<T>* kernel = __internal_selectMultiply((T)0);
+    itl::size_t panelColumns = (c.columns + kernel->width - 1) / kernel->width * kernel->width;
+    itl::size_t panelDepth = a.columns < MATRIX_BLOCK_K ? a.columns : MATRIX_BLOCK_K;
+    itl::size_t buffers = pool != nullptr ? pool->workerCount + 1 : 1;
+
+    if (panelColumns > MATRIX_BLOCK_N)
+        panelColumns = MATRIX_BLOCK_N;
+
+    T* packedB = (T*)itl::allocAligned(panelDepth * panelColumns * sizeof(T), MATRIX_ALIGNMENT);
+    T** packedA = (T**)itl::calloc(buffers, sizeof(T*));
+    itl::uint32_t* claimed = (itl::uint32_t*)itl::calloc(buffers, sizeof(itl::uint32_t));
+    int result = 0;
+
+    if (packedB == nullptr || packedA == nullptr || claimed == nullptr) {
+        result = -ENOMEM;
+        buffers = 0;
+    }
+
+    itl::size_t blocks = (c.rows + MATRIX_BLOCK_M - 1) / MATRIX_BLOCK_M;
+
+    for (itl::size_t column = 0; result == 0 && column < c.columns; column += MATRIX_BLOCK_N) {
+        itl::size_t columns = c.columns - column < MATRIX_BLOCK_N ? c.columns - column : MATRIX_BLOCK_N;
+
+        for (itl::size_t depthStart = 0; result == 0 && depthStart < a.columns; depthStart += MATRIX_BLOCK_K) {
+            itl::size_t depth = a.columns - depthStart < MATRIX_BLOCK_K ? a.columns - depthStart : MATRIX_BLOCK_K;
+            GemmPass<T> pass;
+
+            __internal_packB(b, depthStart, depth, column, columns, kernel->width, packedB);
+
+            pass.a = a;
+            pass.c = c;
+            pass.kernel = kernel;
+            pass.packedB = packedB;
+            pass.packedA = packedA;
+            pass.claimed = claimed;
+            pass.buffers = buffers;
+            pass.column = column;
+            pass.columns = columns;
+            pass.depthStart = depthStart;
+            pass.depth = depth;
+            pass.bufferDepth = panelDepth;
+            pass.chunks = 1;
+            pass.chunkWidth = columns;
+            pass.alpha = alpha;
+            pass.beta = depthStart == 0 ? beta : 1;
+            pass.failed = 0;
+
+            if (pool == nullptr) {
+                __internal_runTasks<T>(&pass, 0, blocks);
+            } else {
+                pass.chunks = (columns + MATRIX_PARALLEL_COLUMNS - 1) / MATRIX_PARALLEL_COLUMNS;
+                pass.chunkWidth = MATRIX_PARALLEL_COLUMNS;
+                itl::thread::parallelFor(pool, 0, blocks * pass.chunks, 1, __internal_runTasks<T>, &pass);
+            }
+
+            if (pass.failed)
+                result = -ENOMEM;
+        }
+    }
+
+    for (itl::size_t slot = 0; slot < buffers; ++slot)
+        itl::free(packedA[slot]);
+
+    itl::free(claimed);
+    itl::free(packedA);
+    itl::free(packedB);
+
+    return result;
+}
+
+/**
+ * @brief Copies a view into another of the same shape.
+ */
+template <typename T>
+static int __internal_copyView(const itl::matrix::View<T>& source, const itl::matrix::View<T>& destination)
+{
+    if (source.rows != destination.rows || source.columns != destination.columns)
+        return -EINVAL;
+
+    if (source.rows == 0 || source.columns == 0)
+        return 0;
+
+    if (source.columnStride == 1 && destination.columnStride == 1) {
+        if (source.rowStride == source.columns && destination.rowStride == destination.columns) {
+            itl::simd::copy(destination.data, source.data, source.rows * source.columns * sizeof(T));
+            return 0;
+        }
+
+        for (itl::size_t row = 0; row < source.rows; ++row)
+            itl::simd::copy(&destination(row, 0), &source(row, 0), source.columns * sizeof(T));
+
+        return 0;
+    }
+
+    if (source.rowStride == 1 && destination.rowStride == 1)
+        return __internal_copyView(source.transposed(), destination.transposed());
+
+    if (source.rowStride == 1 && destination.columnStride == 1) {
+        __internal_selectTranspose((T)0)(source.data, source.columnStride, destination.data, destination.rowStride,
+            source.columns, source.rows);
+        return 0;
+    }
+
+    if (source.columnStride == 1 && destination.rowStride == 1) {
+        __internal_selectTranspose((T)0)(source.data, source.rowStride, destination.data, destination.columnStride,
+            source.rows, source.columns);
+        return 0;
+    }
+
+    for (itl::size_t row = 0; row < source.rows; ++row)
+        for (itl::size_t column = 0; column < source.columns; ++column)
+            destination(row, column) = source(row, column);
+
+    return 0;
+}
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace matrix {
+    int multiply(const itl::matrix::View<float>& a, const itl::matrix::View<float>& b, const itl::matrix::View<float>& c,
+        float alpha, float beta, itl::thread::ThreadPool* pool)
+    {
+        return __internal_multiply<float>(a, b, c, alpha, beta, pool);
+    }
+
+    int multiply(const itl::matrix::View<double>& a, const itl::matrix::View<double>& b, const itl::matrix::View<double>& c,
+        double alpha, double beta, itl::thread::ThreadPool* pool)
+    {
+        return __internal_multiply<double>(a, b, c, alpha, beta, pool);
+    }
+
+    int copy(const itl::matrix::View<float>& source, const itl::matrix::View<float>& destination)
+    {
+        return __internal_copyView<float>(source, destination);
+    }
+
+    int copy(const itl::matrix::View<double>& source, const itl::matrix::View<double>& destination)
+    {
+        return __internal_copyView<double>(source, destination);
+    }
+}; // namespace matrix
+} // namespace itl
@@ -0,0 +1,125 @@
+/**
+ * @file src/containers/queue.cpp
+ * @brief Implements the ring storage of the ITL queues.
+ * @category Containers
+ *
+ * This file allocates and releases the rings of the lock-free queues,
+ * either from the ITL allocator or from huge pages, so that a large ring
+ * costs one TLB entry per 2 MiB instead of one per page.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#include "containers/queue.hpp"
+#include "memory/allocator.hpp"
+#include "system/mmacros.hpp"
+#include "system/rawSyscalls.hpp"
+#include "system/sync.hpp"
+#include "system/syscalls.hpp"
+#include "typing/ctypes.hpp"
+
+/**
+ * @brief Rounds a ring size up to whole huge pages.
+ */
+static itl::size_t __internal_hugeSize(itl::size_t size)
+{
+    return (size + BLOCK_SIZE - 1) & ~((itl::size_t)BLOCK_SIZE - 1);
+}
+
+/**
+ * @brief Maps a ring on hugetlb pages, populated up front.
+ *
+ * @return The mapping, or nullptr when the hugetlb pool cannot serve it.
+ */
+static void* __internal_mapHugetlb(itl::size_t size)
+{
+#ifdef __x86_64__
+    void* ring = itl::linux::syscall::mmap(0, size, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE, -1, 0);
+#elif __i386__
+    void* ring = itl::linux::syscall::mmap2(0, size, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE, -1, 0);
+#endif // #ifdef __x86_64__
+
+    return SYSCALL_FAILED(ring) ? nullptr : ring;
+}
+
+/**
+ * @brief Maps a ring on regular pages aligned to a huge page.
+ *
+ * A transparent huge page can only back a 2 MiB range that is aligned to
+ * 2 MiB, so the mapping is made one huge page larger and trimmed.
+ *
+ * @return The aligned mapping, or nullptr on failure.
+ */
+static void* __internal_mapAligned(itl::size_t size)
+{
+    unsigned char* raw = (unsigned char*)itl::allocPages(size + BLOCK_SIZE);
+
+    if (raw == nullptr)
+        return nullptr;
+
+    unsigned char* aligned = (unsigned char*)(((itl::uintptr_t)raw + BLOCK_SIZE - 1) & ~((itl::uintptr_t)BLOCK_SIZE - 1));
+    itl::size_t head = aligned - raw;
+    itl::size_t tail = BLOCK_SIZE - head;
+
+    if (head > 0)
+        itl::linux::syscall::munmap((unsigned long)raw, head);
+
+    if (tail > 0)
+        itl::linux::syscall::munmap((unsigned long)(aligned + size), tail);
+
+    return aligned;
+}
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace queue {
+    void* allocateRing(itl::size_t size, itl::queue::QueueStorage storage, itl::MemoryBacking* backing)
+    {
+        *backing = BACKING_REGULAR;
+
+        if (storage == QUEUE_STORAGE_ALLOCATOR)
+            return itl::allocAligned(size, CACHE_LINE_SIZE);
+
+        itl::size_t hugeSize = __internal_hugeSize(size);
+        void* ring = __internal_mapHugetlb(hugeSize);
+
+        if (ring != nullptr) {
+            *backing = BACKING_HUGETLB;
+            return ring;
+        }
+
+        // Without hugetlb pages, ask for transparent huge pages and fault
+        // the ring in now rather than on the first lap.
+        ring = __internal_mapAligned(hugeSize);
+
+        if (ring == nullptr)
+            return nullptr;
+
+        if (itl::linux::syscall::madvise((unsigned long)ring, hugeSize, MADV_HUGEPAGE) == 0)
+            *backing = BACKING_TRANSPARENT;
+
+        itl::linux::syscall::madvise((unsigned long)ring, hugeSize, MADV_POPULATE_WRITE);
+
+        return ring;
+    }
+
+    void freeRing(void* ring, itl::size_t size, itl::queue::QueueStorage storage, itl::MemoryBacking backing)
+    {
+        if (ring == nullptr)
+            return;
+
+        if (storage == QUEUE_STORAGE_ALLOCATOR)
+            itl::free(ring);
+        else if (backing == BACKING_HUGETLB)
+            itl::linux::syscall::munmap((unsigned long)ring, __internal_hugeSize(size));
+        else
+            itl::freePages(ring, __internal_hugeSize(size));
+    }
+}; // namespace queue
+} // namespace itl
@@ -0,0 +1,214 @@
+/**
+ * @file src/io/mapping.cpp
+ * @brief Implements read-only memory-mapped views of files.
+ * @category Input/Output
+ *
+ * This file contains the functions that open and size a file, map and
+ * slide its window, and pass access pattern hints to the kernel. Reading
+ * through a window is inline in the header and never enters the kernel.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#include "io/mapping.hpp"
+#include "system/auxv.hpp"
+#include "system/fmacros.hpp"
+#include "system/mmacros.hpp"
+#include "system/rawSyscalls.hpp"
+#include "system/syscalls.hpp"
+#include "typing/ctypes.hpp"
+
+/**
+ * @brief Maps part of a file read-only.
+ *
+ * @param address The address to replace with MAP_FIXED, or 0.
+ * @param length The length of the mapping, in bytes.
+ * @param flags Extra mapping flags (e.g., MAP_POPULATE).
+ * @param fileDescriptor The file to map.
+ * @param offset The offset in the file, aligned to a page.
+ * @return The mapping, or a negated errno value cast to a pointer.
+ */
+static void* __internal_mapRange(void* address, itl::size_t length, unsigned long flags, int fileDescriptor, itl::uint64_t offset)
+{
+#ifdef __x86_64__
+    return itl::linux::syscall::mmap(
+        (unsigned long)address, ///< address
+        length, ///< length
+        PROT_READ, ///< protection
+        MAP_SHARED | flags, ///< flags
+        (unsigned long)fileDescriptor, ///< fileDescriptor
+        offset ///< offset
+    );
+#elif __i386__
+    // mmap2 counts the offset in 4096-byte units, which reaches past 4 GiB.
+    return itl::linux::syscall::mmap2((unsigned long)address, length, PROT_READ,
+        MAP_SHARED | flags, (unsigned long)fileDescriptor, (unsigned long)(offset >> 12));
+#endif // #ifdef __x86_64__
+}
+
+/**
+ * @brief Unmaps the current window, if any.
+ */
+static void __internal_unmapWindow(itl::file::MappedFile* file)
+{
+    if (file->mapping != nullptr)
+        itl::linux::syscall::munmap((unsigned long)file->mapping, file->mappingSize);
+
+    file->mapping = nullptr;
+    file->mappingSize = 0;
+}
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace file {
+    int mapFile(itl::file::MappedFile* file, const char* path, itl::size_t budget, unsigned flags)
+    {
+        int fileDescriptor = itl::linux::syscall::openat(AT_FDCWD, path, O_RDONLY | O_CLOEXEC | O_LARGEFILE, 0);
+
+        if (fileDescriptor < 0)
+            return fileDescriptor;
+
+        int result = mapDescriptor(file, fileDescriptor, budget, flags & ~MAPPING_KEEP_DESCRIPTOR);
+
+        if (result < 0)
+            itl::linux::syscall::close(fileDescriptor);
+
+        return result;
+    }
+
+    int mapDescriptor(itl::file::MappedFile* file, int fileDescriptor, itl::size_t budget, unsigned flags)
+    {
+        itl::linux::syscall::statx_struct attributes;
+        int result = itl::linux::syscall::statx(fileDescriptor, "", AT_EMPTY_PATH, STATX_SIZE, &attributes);
+
+        if (result < 0)
+            return result;
+
+        itl::size_t pageSize = itl::linux::auxv::getPageSize();
+
+        if (budget == 0)
+            budget = MAPPING_DEFAULT_BUDGET;
+
+        budget &= ~(pageSize - 1);
+
+        if (budget == 0)
+            budget = pageSize;
+
+        file->fileDescriptor = fileDescriptor;
+        file->flags = flags;
+        file->advice = MADV_NORMAL;
+        file->fileSize = attributes.size;
+        file->budget = budget;
+        file->mapping = nullptr;
+        file->mappingSize = 0;
+        file->mappingOffset = 0;
+
+        // An empty file has nothing to map and keeps an empty window.
+        if (file->fileSize == 0)
+            return 0;
+
+        return mapWindow(file, 0);
+    }
+
+    void unmapFile(itl::file::MappedFile* file)
+    {
+        __internal_unmapWindow(file);
+
+        if (!(file->flags & MAPPING_KEEP_DESCRIPTOR) && file->fileDescriptor >= 0)
+            itl::linux::syscall::close(file->fileDescriptor);
+
+        file->fileDescriptor = -1;
+        file->fileSize = 0;
+        file->mappingOffset = 0;
+    }
+
+    int mapWindow(itl::file::MappedFile* file, itl::uint64_t offset)
+    {
+        if (offset >= file->fileSize)
+            return -EINVAL;
+
+        itl::uint64_t start = offset & ~(itl::uint64_t)(itl::linux::auxv::getPageSize() - 1);
+        itl::uint64_t remaining = file->fileSize - start;
+        itl::size_t size = remaining < file->budget ? (itl::size_t)remaining : file->budget;
+
+        if (file->mapping != nullptr && start == file->mappingOffset && size == file->mappingSize)
+            return 0;
+
+        unsigned long flags = (file->flags & MAPPING_POPULATE) ? MAP_POPULATE : 0;
+        void* address = nullptr;
+
+        // A window of the same size replaces the old one in place, which
+        // takes one system call instead of an unmap and a map.
+        if (file->mapping != nullptr && size == file->mappingSize) {
+            address = file->mapping;
+            flags |= MAP_FIXED;
+        } else {
+            __internal_unmapWindow(file);
+        }
+
+        void* mapping = __internal_mapRange(address, size, flags, file->fileDescriptor, start);
+
+        if (SYSCALL_FAILED(mapping)) {
+            __internal_unmapWindow(file);
+            return (int)(long)mapping;
+        }
+
+        file->mapping = mapping;
+        file->mappingSize = size;
+        file->mappingOffset = start;
+
+        if (file->advice != MADV_NORMAL)
+            itl::linux::syscall::madvise((unsigned long)mapping, size, file->advice);
+
+        return 0;
+    }
+
+    bool nextWindow(itl::file::MappedFile* file)
+    {
+        if (file->mapping == nullptr)
+            return false;
+
+        itl::uint64_t next = file->mappingOffset + file->mappingSize;
+
+        if (next >= file->fileSize)
+            return false;
+
+        return mapWindow(file, next) == 0;
+    }
+
+    int adviseMapping(itl::file::MappedFile* file, int advice)
+    {
+        // MADV_WILLNEED is a one-time request for the current window, not a
+        // pattern to keep applying.
+        if (advice != MADV_WILLNEED)
+            file->advice = advice;
+
+        if (file->mapping == nullptr)
+            return 0;
+
+        return itl::linux::syscall::madvise((unsigned long)file->mapping, file->mappingSize, advice);
+    }
+
+    int prefetch(itl::file::MappedFile* file, itl::uint64_t offset, itl::size_t length)
+    {
+        if (file->mapping == nullptr || offset >= file->mappingOffset + file->mappingSize)
+            return 0;
+
+        if (offset < file->mappingOffset)
+            offset = file->mappingOffset;
+
+        itl::size_t pageSize = itl::linux::auxv::getPageSize();
+        itl::size_t begin = (itl::size_t)(offset - file->mappingOffset) & ~(pageSize - 1);
+        itl::size_t end = (itl::size_t)(offset - file->mappingOffset) + length;
+
+        if (end > file->mappingSize || end < begin)
+            end = file->mappingSize;
+
+        return itl::linux::syscall::madvise((unsigned long)file->mapping + begin, end - begin, MADV_WILLNEED);
+    }
+}; // namespace file
+} // namespace itl
@@ -0,0 +1,588 @@
+/**
+ * @file src/io/print.cpp
+ * @brief Implements buffered formatted output.
+ * @category Input/Output
+ *
+ * This file contains the formatting engine behind the print functions:
+ * it walks a format string that was checked at compile time, converts
+ * each argument straight into the buffer of a writer and writes the
+ * buffer out with write or writev. Nothing is allocated; the only state
+ * is the pair of writers in the TLS block of each thread.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#include "io/print.hpp"
+#include "system/simd.hpp"
+#include "system/syscalls.hpp"
+#include "typing/ctypes.hpp"
+
+#define IO_INLINE_COPY 32 ///< Longest run copied inline rather than through itl::simd.
+
+/**
+ * @brief Standard output writer of the calling thread.
+ *
+ * The writer is zero-initialized, so it lives in the TLS block of every
+ * thread without any constructor, and is bound to its descriptor on
+ * first use.
+ */
+static thread_local itl::io::Writer internalOutput
+    __attribute__((tls_model("initial-exec")));
+
+/**
+ * @brief Standard error writer of the calling thread.
+ */
+static thread_local itl::io::Writer internalErrorOutput
+    __attribute__((tls_model("initial-exec")));
+
+/**
+ * @brief Pairs of decimal digits, used to convert two digits per division.
+ */
+static const char decimalPairs[201] = "00010203040506070809"
+                                      "10111213141516171819"
+                                      "20212223242526272829"
+                                      "30313233343536373839"
+                                      "40414243444546474849"
+                                      "50515253545556575859"
+                                      "60616263646566676869"
+                                      "70717273747576777879"
+                                      "80818283848586878889"
+                                      "90919293949596979899";
+
+/**
+ * @brief Powers of ten that scale the decimals of a float.
+ */
+static const itl::uint32_t decimalScales[IO_MAX_FLOAT_PRECISION + 1] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+/**
+ * @brief Largest magnitude printed in fixed notation; larger floats switch
+ * to scientific notation so their integer part fits in 63 bits.
+ */
+#define FIXED_NOTATION_LIMIT 1e18
+
+/**
+ * @brief Size of the scratch space a single number is converted in.
+ */
+#define NUMBER_BUFFER_SIZE 80
+
+/**
+ * @brief Writes a vector of buffers completely, retrying partial writes.
+ *
+ * Output that cannot be written is dropped, since a logger has nowhere to
+ * report its own failures.
+ */
+static void __internal_writeAll(int fileDescriptor, itl::linux::syscall::iovec_struct* vectors, int count)
+{
+    while (count > 0) {
+        itl::ssize_t written = itl::linux::syscall::writev(fileDescriptor, vectors, count);
+
+        if (written == -EINTR)
+            continue;
+
+        if (written <= 0)
+            return;
+
+        while (count > 0 && (itl::size_t)written >= vectors->length) {
+            written -= vectors->length;
+            ++vectors;
+            --count;
+        }
+
+        if (count > 0) {
+            vectors->base = (char*)vectors->base + written;
+            vectors->length -= written;
+        }
+    }
+}
+
+/**
+ * @brief Copies bytes into the buffer of a writer.
+ *
+ * Most appends are a few characters of a format string or a number, so
+ * those are moved inline with unaligned 8-byte loads and stores, and only
+ * longer runs pay the call into the vector kernels.
+ */
+static inline void __internal_copy(char* destination, const char* source, itl::size_t length)
+{
+    if (length > IO_INLINE_COPY) {
+        itl::simd::copy(destination, source, length);
+        return;
+    }
+
+    while (length >= 8) {
+        __builtin_memcpy(destination, source, 8);
+        destination += 8;
+        source += 8;
+        length -= 8;
+    }
+
+    while (length > 0) {
+        *destination++ = *source++;
+        --length;
+    }
+}
+
+/**
+ * @brief Finds the next brace of a format string.
+ *
+ * Eight characters are tested at once: a byte of the word XORed with the
+ * brace is zero exactly where the brace is, and the classic
+ * (x - 0x01..) & ~x & 0x80.. test flags words with a zero byte.
+ *
+ * @return The index of the next { or }, or length if there is none.
+ */
+static inline itl::size_t __internal_findBrace(const char* text, itl::size_t index, itl::size_t length)
+{
+    const itl::uint64_t ones = 0x0101010101010101ULL;
+    const itl::uint64_t highs = 0x8080808080808080ULL;
+
+    while (index + 8 <= length) {
+        itl::uint64_t word;
+
+        __builtin_memcpy(&word, text + index, 8);
+
+        itl::uint64_t open = word ^ (ones * '{');
+        itl::uint64_t close = word ^ (ones * '}');
+
+        if ((((open - ones) & ~open) | ((close - ones) & ~close)) & highs)
+            break;
+
+        index += 8;
+    }
+
+    while (index < length && text[index] != '{' && text[index] != '}')
+        ++index;
+
+    return index;
+}
+
+/**
+ * @brief Appends bytes that do not fit in the buffer of a writer.
+ *
+ * Long runs are written together with the buffered output by a single
+ * writev, without copying them first.
+ */
+static void __internal_appendSlow(itl::io::Writer* writer, const char* data, itl::size_t length)
+{
+    if (length >= IO_BUFFER_SIZE / 2) {
+        itl::linux::syscall::iovec_struct vectors[2] = {
+            { writer->buffer, writer->length },
+            { (void*)data, length }
+        };
+
+        __internal_writeAll(writer->fileDescriptor, vectors, 2);
+        writer->length = 0;
+        return;
+    }
+
+    itl::io::flush(writer);
+    __internal_copy(writer->buffer, data, length);
+    writer->length = length;
+}
+
+/**
+ * @brief Appends bytes to a writer.
+ */
+static inline void __internal_append(itl::io::Writer* writer, const char* data, itl::size_t length)
+{
+    itl::size_t used = writer->length;
+
+    if (__builtin_expect(used + length > IO_BUFFER_SIZE, 0)) {
+        __internal_appendSlow(writer, data, length);
+        return;
+    }
+
+    __internal_copy(writer->buffer + used, data, length);
+    writer->length = used + length;
+}
+
+/**
+ * @brief Appends a character repeated a number of times.
+ */
+static void __internal_appendRepeated(itl::io::Writer* writer, char character, itl::size_t count)
+{
+    while (count > 0) {
+        if (writer->length == IO_BUFFER_SIZE)
+            itl::io::flush(writer);
+
+        itl::size_t room = IO_BUFFER_SIZE - writer->length;
+        itl::size_t run = count < room ? count : room;
+
+        itl::simd::fill(writer->buffer + writer->length, character, run);
+        writer->length += run;
+        count -= run;
+    }
+}
+
+/**
+ * @brief Appends a field, padded to the width of a placeholder.
+ *
+ * @param writer The writer.
+ * @param spec The options of the placeholder.
+ * @param prefix Characters placed before the zero padding (sign, 0x).
+ * @param prefixLength The number of prefix characters.
+ * @param body The field itself.
+ * @param bodyLength The length of the field.
+ */
+static void __internal_appendField(itl::io::Writer* writer, const itl::io::FormatSpec* spec,
+    const char* prefix, itl::size_t prefixLength, const char* body, itl::size_t bodyLength)
+{
+    itl::size_t length = prefixLength + bodyLength;
+    itl::size_t padding = spec->width > length ? spec->width - length : 0;
+
+    if (padding > 0 && !spec->leftAlign && !spec->zeroPad)
+        __internal_appendRepeated(writer, ' ', padding);
+
+    __internal_append(writer, prefix, prefixLength);
+
+    if (padding > 0 && !spec->leftAlign && spec->zeroPad)
+        __internal_appendRepeated(writer, '0', padding);
+
+    __internal_append(writer, body, bodyLength);
+
+    if (padding > 0 && spec->leftAlign)
+        __internal_appendRepeated(writer, ' ', padding);
+}
+
+/**
+ * @brief Divides a value by 100 in place.
+ *
+ * On x86_64 the constant divisor compiles to a multiplication. x86 has no
+ * 64-bit division instruction, so there large values are divided in
+ * 16-bit limbs with 32-bit divisions instead of calling a helper routine
+ * from libgcc.
+ *
+ * @param value The dividend, replaced by the quotient.
+ * @return The remainder.
+ */
+static inline itl::uint32_t __internal_divideBy100(itl::uint64_t* value)
+{
+#ifdef __x86_64__
+    itl::uint64_t quotient = *value / 100;
+    itl::uint32_t remainder = (itl::uint32_t)(*value - quotient * 100);
+
+    *value = quotient;
+    return remainder;
+#elif __i386__
+    if ((*value >> 32) == 0) {
+        itl::uint32_t low = (itl::uint32_t)*value;
+
+        *value = low / 100;
+        return low % 100;
+    }
+
+    itl::uint64_t quotient = 0;
+    itl::uint32_t remainder = 0;
+
+    for (int shift = 48; shift >= 0; shift -= 16) {
+        itl::uint32_t current = (remainder << 16) | (itl::uint32_t)((*value >> shift) & 0xffff);
+
+        quotient |= (itl::uint64_t)(current / 100) << shift;
+        remainder = current % 100;
+    }
+
+    *value = quotient;
+    return remainder;
+#endif // #ifdef __x86_64__
+}
+
+/**
+ * @brief Converts an unsigned value to digits, right-aligned in a buffer.
+ *
+ * @param value The value.
+ * @param base 2, 10 or 16.
+ * @param uppercase Whether hexadecimal digits are uppercase.
+ * @param end One past the last byte of the buffer.
+ * @param minimumDigits The minimum number of digits, padded with zeros.
+ * @return The first digit.
+ */
+static char* __internal_formatUnsigned(itl::uint64_t value, unsigned base, bool uppercase, char* end, unsigned minimumDigits)
+{
+    const char* digits = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+    char* cursor = end;
+
+    if (base == 10) {
+        while (value >= 100) {
+            itl::uint32_t pair = __internal_divideBy100(&value) * 2;
+
+            *--cursor = decimalPairs[pair + 1];
+            *--cursor = decimalPairs[pair];
+        }
+
+        if (value >= 10) {
+            *--cursor = decimalPairs[value * 2 + 1];
+            *--cursor = decimalPairs[value * 2];
+        } else if (value > 0 || cursor == end) {
+            *--cursor = (char)('0' + value);
+        }
+    } else {
+        unsigned shift = base == 16 ? 4 : 1;
+
+        do {
+            *--cursor = digits[value & (base - 1)];
+            value >>= shift;
+        } while (value != 0);
+    }
+
+    while ((unsigned)(end - cursor) < minimumDigits)
+        *--cursor = '0';
+
+    return cursor;
+}
+
+/**
+ * @brief Appends an integer.
+ */
+static void __internal_appendInteger(itl::io::Writer* writer, const itl::io::FormatSpec* spec, itl::uint64_t magnitude, bool negative)
+{
+    char number[NUMBER_BUFFER_SIZE];
+    char* end = number + NUMBER_BUFFER_SIZE;
+    unsigned base = spec->type == 'b' ? 2 : (spec->type == 'x' || spec->type == 'X') ? 16 : 10;
+    char* digits = __internal_formatUnsigned(magnitude, base, spec->type == 'X', end, 1);
+
+    __internal_appendField(writer, spec, "-", negative ? 1 : 0, digits, end - digits);
+}
+
+/**
+ * @brief Appends a float in fixed or scientific notation.
+ *
+ * The decimals are rounded to the precision of the placeholder, which is
+ * enough for logs and metrics; it is not the shortest representation that
+ * reads back to the same double.
+ */
+static void __internal_appendFloat(itl::io::Writer* writer, const itl::io::FormatSpec* spec, double value)
+{
+    char number[NUMBER_BUFFER_SIZE];
+    char* end = number + NUMBER_BUFFER_SIZE;
+    char* cursor = end;
+    union {
+        double value;
+        itl::uint64_t bits;
+    } representation = { value };
+    bool negative = (representation.bits >> 63) != 0;
+    int precision = spec->precision < 0 ? IO_DEFAULT_FLOAT_PRECISION : spec->precision;
+    double magnitude = negative ? -value : value;
+
+    if (value != value) {
+        __internal_appendField(writer, spec, "", 0, "nan", 3);
+        return;
+    }
+
+    if (magnitude > 1.7976931348623157e308) {
+        __internal_appendField(writer, spec, "-", negative ? 1 : 0, "inf", 3);
+        return;
+    }
+
+    bool scientific = spec->type == 'e' || magnitude >= FIXED_NOTATION_LIMIT;
+    int exponent = 0;
+
+    if (scientific && magnitude != 0) {
+        while (magnitude >= 1e16) {
+            magnitude /= 1e16;
+            exponent += 16;
+        }
+
+        while (magnitude >= 10) {
+            magnitude /= 10;
+            ++exponent;
+        }
+
+        while (magnitude < 1e-16) {
+            magnitude *= 1e16;
+            exponent -= 16;
+        }
+
+        while (magnitude < 1) {
+            magnitude *= 10;
+            --exponent;
+        }
+    }
+
+    itl::uint32_t scale = decimalScales[precision];
+    itl::int64_t integer = (itl::int64_t)magnitude;
+    itl::int64_t decimals = (itl::int64_t)((magnitude - (double)integer) * scale + 0.5);
+
+    if (decimals >= scale) {
+        decimals -= scale;
+        ++integer;
+    }
+
+    if (scientific) {
+        // Rounding 9.99... up gives 10, which is 1 with a larger exponent.
+        if (integer >= 10) {
+            integer = 1;
+            ++exponent;
+        }
+
+        unsigned exponentMagnitude = exponent < 0 ? -exponent : exponent;
+
+        cursor = __internal_formatUnsigned(exponentMagnitude, 10, false, end, 2);
+        *--cursor = exponent < 0 ? '-' : '+';
+        *--cursor = 'e';
+    }
+
+    if (precision > 0) {
+        cursor = __internal_formatUnsigned((itl::uint64_t)decimals, 10, false, cursor, precision);
+        *--cursor = '.';
+    }
+
+    cursor = __internal_formatUnsigned((itl::uint64_t)integer, 10, false, cursor, 1);
+    __internal_appendField(writer, spec, "-", negative ? 1 : 0, cursor, end - cursor);
+}
+
+/**
+ * @brief Appends an argument formatted with the options of a placeholder.
+ */
+static void __internal_appendArgument(itl::io::Writer* writer, const itl::io::FormatSpec* spec, const itl::io::Argument* argument)
+{
+    switch (argument->type) {
+    case itl::io::ARGUMENT_BOOLEAN:
+        if (argument->signedValue)
+            __internal_appendField(writer, spec, "", 0, "true", 4);
+        else
+            __internal_appendField(writer, spec, "", 0, "false", 5);
+        break;
+    case itl::io::ARGUMENT_CHARACTER: {
+        char character = (char)argument->signedValue;
+
+        __internal_appendField(writer, spec, "", 0, &character, 1);
+        break;
+    }
+    case itl::io::ARGUMENT_SIGNED: {
+        itl::int64_t value = argument->signedValue;
+        itl::uint64_t magnitude = value < 0 ? 0 - (itl::uint64_t)value : (itl::uint64_t)value;
+
+        __internal_appendInteger(writer, spec, magnitude, value < 0);
+        break;
+    }
+    case itl::io::ARGUMENT_UNSIGNED:
+        __internal_appendInteger(writer, spec, argument->unsignedValue, false);
+        break;
+    case itl::io::ARGUMENT_FLOAT:
+        __internal_appendFloat(writer, spec, argument->floatValue);
+        break;
+    case itl::io::ARGUMENT_STRING: {
+        const char* data = argument->string.data;
+        itl::size_t length = argument->string.length;
+
+        if (data == nullptr) {
+            data = "(null)";
+            length = 6;
+        } else if (length == (itl::size_t)-1) {
+            length = 0;
+
+            while (data[length] != '\0')
+                ++length;
+        }
+
+        if (spec->precision >= 0 && length > (itl::size_t)spec->precision)
+            length = spec->precision;
+
+        __internal_appendField(writer, spec, "", 0, data, length);
+        break;
+    }
+    case itl::io::ARGUMENT_POINTER: {
+        char number[NUMBER_BUFFER_SIZE];
+        char* end = number + NUMBER_BUFFER_SIZE;
+        char* digits = __internal_formatUnsigned((itl::uintptr_t)argument->pointer, 16, false, end, 1);
+
+        __internal_appendField(writer, spec, "0x", 2, digits, end - digits);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace io {
+    void initializeWriter(itl::io::Writer* writer, int fileDescriptor, itl::size_t threshold)
+    {
+        writer->fileDescriptor = fileDescriptor;
+        writer->length = 0;
+        writer->threshold = threshold > IO_BUFFER_SIZE ? IO_BUFFER_SIZE : threshold;
+        writer->ready = true;
+    }
+
+    itl::io::Writer* getOutput()
+    {
+        if (__builtin_expect(!internalOutput.ready, 0))
+            initializeWriter(&internalOutput, 1, IO_FLUSH_THRESHOLD);
+
+        return &internalOutput;
+    }
+
+    itl::io::Writer* getErrorOutput()
+    {
+        if (__builtin_expect(!internalErrorOutput.ready, 0))
+            initializeWriter(&internalErrorOutput, 2, 0);
+
+        return &internalErrorOutput;
+    }
+
+    void writeFormatted(itl::io::Writer* writer, const char* format, itl::size_t length, const itl::io::Argument* arguments, bool newline)
+    {
+        itl::size_t index = 0;
+        itl::size_t literal = 0;
+
+        while (index < length) {
+            index = __internal_findBrace(format, index, length);
+
+            if (index == length)
+                break;
+
+            char character = format[index];
+
+            // Literal text is appended in runs, and {{ or }} keep one brace.
+            __internal_append(writer, format + literal, index - literal + (format[index + 1] == character));
+            index += 1;
+
+            if (format[index] == character) {
+                literal = ++index;
+                continue;
+            }
+
+            itl::io::FormatSpec spec;
+
+            parseSpec(format, length, &index, &spec);
+            __internal_appendArgument(writer, &spec, arguments++);
+            literal = index;
+        }
+
+        __internal_append(writer, format + literal, index - literal);
+
+        if (newline)
+            __internal_append(writer, "\n", 1);
+
+        if (writer->length >= writer->threshold)
+            flush(writer);
+    }
+
+    void flush(itl::io::Writer* writer)
+    {
+        if (writer->length == 0)
+            return;
+
+        itl::linux::syscall::iovec_struct vector = { writer->buffer, writer->length };
+
+        __internal_writeAll(writer->fileDescriptor, &vector, 1);
+        writer->length = 0;
+    }
+
+    void flush()
+    {
+        if (internalOutput.ready)
+            flush(&internalOutput);
+
+        if (internalErrorOutput.ready)
+            flush(&internalErrorOutput);
+    }
+}; // namespace io
+} // namespace itl
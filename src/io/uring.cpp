@@ -0,0 +1,304 @@
+/**
+ * @file src/io/uring.cpp
+ * @brief Implements the io_uring engine for asynchronous file I/O.
+ * @category Input/Output
+ *
+ * This file contains the slow paths of the engine: setting up and mapping
+ * the rings, entering the kernel to submit or wait, and registering
+ * buffers and files. Queuing requests and polling completions are inline
+ * in the header and never enter the kernel.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#include "io/uring.hpp"
+#include "system/mmacros.hpp"
+#include "system/rawSyscalls.hpp"
+#include "system/syscalls.hpp"
+#include "typing/ctypes.hpp"
+
+/**
+ * @struct FilesUpdate
+ * @brief Argument of IORING_REGISTER_FILES_UPDATE.
+ */
+typedef struct {
+    itl::uint32_t offset; ///< Index of the first slot to replace.
+    itl::uint32_t reserved; ///< Reserved.
+    itl::uint64_t fileDescriptors; ///< Address of the new file descriptors.
+} FilesUpdate;
+
+/**
+ * @brief Maps a region of an io_uring instance, shared with the kernel.
+ *
+ * @param ringDescriptor The file descriptor of the instance.
+ * @param size The size of the region, in bytes.
+ * @param offset The IORING_OFF_* offset of the region.
+ * @return The mapping, or nullptr on failure.
+ */
+static void* __internal_mapRing(int ringDescriptor, itl::size_t size, itl::uint64_t offset)
+{
+    void* mapping;
+
+#ifdef __x86_64__
+    mapping = itl::linux::syscall::mmap(
+        0, ///< address
+        size, ///< length
+        PROT_READ | PROT_WRITE, ///< protection
+        MAP_SHARED | MAP_POPULATE, ///< flags
+        ringDescriptor, ///< fileDescriptor
+        offset ///< offset
+    );
+#elif __i386__
+    itl::linux::syscall::mmap_arg_struct arguments = {
+        .address = 0,
+        .length = size,
+        .protection = PROT_READ | PROT_WRITE,
+        .flags = MAP_SHARED | MAP_POPULATE,
+        .fileDescriptor = (unsigned long)ringDescriptor,
+        .offset = (unsigned long)offset
+    };
+
+    mapping = itl::linux::syscall::mmap(arguments);
+#endif
+
+    if (SYSCALL_FAILED(mapping))
+        return nullptr;
+
+    return mapping;
+}
+
+/**
+ * @brief Unmaps every ring mapping that was created.
+ */
+static void __internal_unmapRings(itl::file::Ring* ring)
+{
+    if (ring->entries != nullptr)
+        itl::linux::syscall::munmap((unsigned long)ring->entries, ring->entriesMappingSize);
+
+    if (ring->completionMapping != nullptr && ring->completionMapping != ring->submissionMapping)
+        itl::linux::syscall::munmap((unsigned long)ring->completionMapping, ring->completionMappingSize);
+
+    if (ring->submissionMapping != nullptr)
+        itl::linux::syscall::munmap((unsigned long)ring->submissionMapping, ring->submissionMappingSize);
+}
+
+/**
+ * @brief Publishes the queued entries by storing the submission tail.
+ *
+ * @return The number of entries published since the last call, which
+ * does not count the published entries the kernel has not consumed.
+ */
+static itl::uint32_t __internal_publish(itl::file::Ring* ring)
+{
+    itl::uint32_t count = ring->queuedTail - ring->publishedTail;
+
+    if (count != 0) {
+        __atomic_store_n(ring->submissionTail, ring->queuedTail, __ATOMIC_RELEASE);
+        ring->publishedTail = ring->queuedTail;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Publishes the queued entries and enters the kernel if needed.
+ *
+ * Without IORING_SETUP_SQPOLL, every entry the kernel has not consumed yet
+ * is handed to io_uring_enter, not only the ones published by this call,
+ * so entries left over by a failed or short submission are retried.
+ *
+ * @param ring The ring to submit.
+ * @param waitCount The number of completions to wait for.
+ * @return The number of entries submitted, or a negated errno value.
+ */
+static int __internal_submit(itl::file::Ring* ring, itl::uint32_t waitCount)
+{
+    itl::uint32_t count = __internal_publish(ring);
+    itl::uint32_t flags = 0;
+
+    if (ring->flags & IORING_SETUP_SQPOLL) {
+        // The polling thread picks the entries up by itself unless it sleeps.
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+        if (__atomic_load_n(ring->submissionFlags, __ATOMIC_RELAXED) & IORING_SQ_NEED_WAKEUP)
+            flags |= IORING_ENTER_SQ_WAKEUP;
+
+        if (flags == 0 && waitCount == 0)
+            return (int)count;
+    } else {
+        count = ring->queuedTail - __atomic_load_n(ring->submissionHead, __ATOMIC_ACQUIRE);
+    }
+
+    if (waitCount > 0)
+        flags |= IORING_ENTER_GETEVENTS;
+
+    if (count == 0 && flags == 0)
+        return 0;
+
+    int result = itl::linux::syscall::io_uring_enter(ring->ringDescriptor,
+        (ring->flags & IORING_SETUP_SQPOLL) ? 0 : count, waitCount, flags, nullptr, 0);
+
+    if (result < 0)
+        return result;
+
+    return (ring->flags & IORING_SETUP_SQPOLL) ? (int)count : result;
+}
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace file {
+    int createRing(itl::file::Ring* ring, itl::uint32_t entries, itl::uint32_t flags)
+    {
+        itl::file::RingParameters parameters;
+        itl::uint32_t* words = (itl::uint32_t*)&parameters;
+
+        for (itl::size_t index = 0; index < sizeof(parameters) / sizeof(itl::uint32_t); ++index)
+            words[index] = 0;
+
+        parameters.flags = flags;
+
+        int ringDescriptor = itl::linux::syscall::io_uring_setup(entries == 0 ? URING_DEFAULT_ENTRIES : entries, &parameters);
+
+        if (ringDescriptor < 0)
+            return ringDescriptor;
+
+        const itl::file::SubmissionRingOffsets* submission = &parameters.submissionOffsets;
+        const itl::file::CompletionRingOffsets* completion = &parameters.completionOffsets;
+
+        ring->ringDescriptor = ringDescriptor;
+        ring->flags = flags;
+        ring->features = parameters.features;
+        ring->submissionMappingSize = submission->array + parameters.submissionEntries * sizeof(itl::uint32_t);
+        ring->completionMappingSize = completion->completions + parameters.completionEntries * sizeof(itl::file::CompletionEntry);
+        ring->entriesMappingSize = parameters.submissionEntries * sizeof(itl::file::SubmissionEntry);
+        ring->submissionMapping = nullptr;
+        ring->completionMapping = nullptr;
+        ring->entries = nullptr;
+
+        // Recent kernels place both rings in one mapping, sized for the larger.
+        if (ring->features & IORING_FEAT_SINGLE_MMAP) {
+            if (ring->completionMappingSize > ring->submissionMappingSize)
+                ring->submissionMappingSize = ring->completionMappingSize;
+
+            ring->completionMappingSize = ring->submissionMappingSize;
+        }
+
+        ring->submissionMapping = __internal_mapRing(ringDescriptor, ring->submissionMappingSize, IORING_OFF_SQ_RING);
+
+        if (ring->submissionMapping != nullptr) {
+            if (ring->features & IORING_FEAT_SINGLE_MMAP)
+                ring->completionMapping = ring->submissionMapping;
+            else
+                ring->completionMapping = __internal_mapRing(ringDescriptor, ring->completionMappingSize, IORING_OFF_CQ_RING);
+        }
+
+        if (ring->completionMapping != nullptr)
+            ring->entries = (itl::file::SubmissionEntry*)__internal_mapRing(ringDescriptor, ring->entriesMappingSize, IORING_OFF_SQES);
+
+        if (ring->entries == nullptr) {
+            __internal_unmapRings(ring);
+            itl::linux::syscall::close(ringDescriptor);
+
+            return -ENOMEM;
+        }
+
+        unsigned char* submissionBase = (unsigned char*)ring->submissionMapping;
+        unsigned char* completionBase = (unsigned char*)ring->completionMapping;
+        itl::uint32_t* array = (itl::uint32_t*)(submissionBase + submission->array);
+
+        ring->submissionHead = (itl::uint32_t*)(submissionBase + submission->head);
+        ring->submissionTail = (itl::uint32_t*)(submissionBase + submission->tail);
+        ring->submissionFlags = (itl::uint32_t*)(submissionBase + submission->flags);
+        ring->submissionMask = *(itl::uint32_t*)(submissionBase + submission->ringMask);
+        ring->submissionEntries = *(itl::uint32_t*)(submissionBase + submission->ringEntries);
+        ring->queuedTail = *ring->submissionTail;
+        ring->publishedTail = ring->queuedTail;
+
+        ring->completionHead = (itl::uint32_t*)(completionBase + completion->head);
+        ring->completionTail = (itl::uint32_t*)(completionBase + completion->tail);
+        ring->completionMask = *(itl::uint32_t*)(completionBase + completion->ringMask);
+        ring->completionEntries = *(itl::uint32_t*)(completionBase + completion->ringEntries);
+        ring->completions = (itl::file::CompletionEntry*)(completionBase + completion->completions);
+
+        // Slots map one to one to entries, so the indirection array is
+        // filled once instead of on every submission.
+        for (itl::uint32_t index = 0; index < ring->submissionEntries; ++index)
+            array[index] = index;
+
+        return 0;
+    }
+
+    void destroyRing(itl::file::Ring* ring)
+    {
+        __internal_unmapRings(ring);
+        itl::linux::syscall::close(ring->ringDescriptor);
+
+        ring->ringDescriptor = -1;
+        ring->submissionMapping = nullptr;
+        ring->completionMapping = nullptr;
+        ring->entries = nullptr;
+    }
+
+    int submit(itl::file::Ring* ring)
+    {
+        return __internal_submit(ring, 0);
+    }
+
+    int submitAndWait(itl::file::Ring* ring, itl::uint32_t waitCount)
+    {
+        return __internal_submit(ring, waitCount);
+    }
+
+    int waitCompletion(itl::file::Ring* ring, itl::file::CompletionEntry** completion)
+    {
+        while (true) {
+            itl::file::CompletionEntry* entry = peekCompletion(ring);
+
+            if (entry != nullptr) {
+                *completion = entry;
+                return 0;
+            }
+
+            int result = __internal_submit(ring, 1);
+
+            if (result < 0 && result != -EINTR)
+                return result;
+        }
+    }
+
+    int registerBuffers(itl::file::Ring* ring, const itl::linux::syscall::iovec_struct* buffers, itl::uint32_t count)
+    {
+        return itl::linux::syscall::io_uring_register(ring->ringDescriptor, IORING_REGISTER_BUFFERS, buffers, count);
+    }
+
+    int unregisterBuffers(itl::file::Ring* ring)
+    {
+        return itl::linux::syscall::io_uring_register(ring->ringDescriptor, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+    }
+
+    int registerFiles(itl::file::Ring* ring, const int* fileDescriptors, itl::uint32_t count)
+    {
+        return itl::linux::syscall::io_uring_register(ring->ringDescriptor, IORING_REGISTER_FILES, fileDescriptors, count);
+    }
+
+    int updateFiles(itl::file::Ring* ring, itl::uint32_t offset, const int* fileDescriptors, itl::uint32_t count)
+    {
+        FilesUpdate update = {
+            .offset = offset,
+            .reserved = 0,
+            .fileDescriptors = (itl::uint64_t)(itl::uintptr_t)fileDescriptors
+        };
+
+        return itl::linux::syscall::io_uring_register(ring->ringDescriptor, IORING_REGISTER_FILES_UPDATE, &update, count);
+    }
+
+    int unregisterFiles(itl::file::Ring* ring)
+    {
+        return itl::linux::syscall::io_uring_register(ring->ringDescriptor, IORING_UNREGISTER_FILES, nullptr, 0);
+    }
+}; // namespace file
+} // namespace itl
@@ -11,7 +11,10 @@
  * @date 05.06.2025
  */
 #include "memory/allocator.hpp"
+#include "memory/profiler.hpp"
+#include "system/auxv.hpp"
 #include "system/mmacros.hpp"
+#include "system/simd.hpp"
 #include "system/syscalls.hpp"
 #include "typing/ctypes.hpp"
 
@@ -30,9 +33,126 @@ namespace itl {
  */
 itl::MemoryMap internalMemoryMap = {
     .blocks = { nullptr }, ///< Array of pointers to memory blocks.
-    .blockCount = 0 ///< Number of memory blocks currently in use.
+    .blockCount = 0, ///< Number of memory blocks currently in use.
+    .classes = {}, ///< Segregated size classes, filled on first use.
+    .dirtyBytes = 0, ///< Bytes of chunks returned since the last purge.
+    .returnsSincePurge = 0, ///< Chunks returned since the last purge.
+    .lock = MUTEX_INITIALIZER ///< Mutex guarding the central heap.
 };
 
+/**
+ * @brief Purge policy of the central heap.
+ */
+static itl::PurgeConfig internalPurgeConfig = {
+    .dirtyThreshold = 16 * BLOCK_SIZE, ///< Purge once 32 MiB of chunks were returned.
+    .decayReturns = 1UL << 20, ///< Purge at least once per million chunk returns.
+    .retainedEmptyBlocks = 1, ///< Keep one empty block per class to absorb bursts.
+    .advice = MADV_FREE ///< Let the kernel reclaim lazily, under memory pressure.
+};
+
+/**
+ * @brief Huge page configuration applied to new blocks.
+ */
+static itl::HugePageConfig internalHugePageConfig = {
+    .mode = HUGE_PAGES_DISABLED, ///< Regular pages until configured otherwise.
+    .collapse = false, ///< Collapsing is synchronous and opt-in.
+    .minimumLargeSize = BLOCK_SIZE ///< Smaller large blocks would waste most of a huge page.
+};
+
+/**
+ * @brief Memory currently mapped by the allocator, by backing.
+ */
+static itl::HugePageStats internalHugePageStats = {
+    .hugetlbBytes = 0,
+    .collapsedBytes = 0,
+    .transparentBytes = 0,
+    .hugetlbFallbacks = 0
+};
+
+/**
+ * @brief Index of the large object tier.
+ */
+static itl::LargeObjectIndex internalLargeObjects = {
+    .entries = nullptr, ///< Mapped on the first large allocation.
+    .count = 0,
+    .capacity = 0,
+    .mappedBytes = 0,
+    .inPlaceResizes = 0,
+    .movedResizes = 0,
+#if ITL_ALLOCATOR_STATS
+    .allocations = 0,
+    .frees = 0,
+#endif
+    .lock = MUTEX_INITIALIZER
+};
+
+#if ITL_ALLOCATOR_STATS
+/**
+ * @brief Registered thread caches, guarded by the heap lock.
+ */
+static itl::ThreadCache* internalThreadCaches = nullptr;
+
+/**
+ * @brief Counters of the threads that released their cache.
+ */
+static itl::ThreadStats internalRetiredStats = {};
+
+/**
+ * @brief System calls issued by the allocator.
+ */
+static itl::SystemCallStats internalSystemCallStats = {
+    .mmapCalls = 0,
+    .munmapCalls = 0,
+    .mremapCalls = 0,
+    .madviseCalls = 0
+};
+
+/**
+ * @brief Adds to a counter written by a single thread, or under a lock.
+ */
+#define STATS_COUNT(counter, amount) \
+    __atomic_store_n(&(counter), __atomic_load_n(&(counter), __ATOMIC_RELAXED) + (amount), __ATOMIC_RELAXED)
+
+/**
+ * @brief Adds to a counter shared by every thread.
+ */
+#define STATS_COUNT_SHARED(counter, amount) __atomic_fetch_add(&(counter), (amount), __ATOMIC_RELAXED)
+#else
+#define STATS_COUNT(counter, amount) ((void)0)
+#define STATS_COUNT_SHARED(counter, amount) ((void)0)
+#endif // ITL_ALLOCATOR_STATS
+
+/**
+ * @brief Allocator cache of the calling thread.
+ *
+ * The cache is zero-initialized, so it lives in the TLS block of every
+ * thread without any constructor or registration.
+ */
+static thread_local itl::ThreadCache internalThreadCache
+    __attribute__((tls_model("initial-exec")));
+
+/**
+ * @brief Chunk sizes of the segregated size classes.
+ *
+ * Classes grow in steps of 16 bytes up to 128 bytes and then in four
+ * evenly spaced steps per power of two, which bounds internal fragmentation
+ * to 25% while keeping the class of a size computable without a search.
+ */
+static const itl::size_t sizeClassTable[SIZE_CLASS_COUNT] = {
+    8, 16, 32, 48, 64, 80, 96, 112, 128,
+    160, 192, 224, 256, 320, 384, 448, 512,
+    640, 768, 896, 1024, 1280, 1536, 1792, 2048,
+    2560, 3072, 3584, 4096, 5120, 6144, 7168, 8192,
+    10240, 12288, 14336, 16384, 20480, 24576, 28672, 32768,
+    40960, 49152, 57344, 65536, 81920, 98304, 114688, 131072,
+    163840, 196608, 229376, 262144
+};
+
+/**
+ * @brief Number of chunks tracked by one word of a block bitmap.
+ */
+#define BITS_PER_WORD (sizeof(itl::size_t) * 8)
+
 /**
  * @brief Normalizes the requested size to be aligned with a base size.
  *
@@ -52,43 +172,204 @@ static itl::size_t __internal_normalizeSize(itl::size_t size, itl::size_t base)
     return (size + base - 1) & ~(base - 1);
 }
 
+/**
+ * @brief Computes the size class that serves a request.
+ *
+ * The index is derived from the position of the highest set bit of the
+ * size, so the lookup takes constant time for every request.
+ *
+ * @param size The requested size, in bytes. Must not exceed MAX_SMALL_SIZE.
+ * @return The index of the smallest size class that fits the request.
+ */
+static itl::size_t __internal_sizeClassIndex(itl::size_t size)
+{
+    if (size <= MIN_CHUNK_SIZE)
+        return 0;
+
+    if (size <= 128)
+        return (size + 15) >> 4;
+
+    itl::size_t rounded = size - 1;
+    itl::size_t log2 = (sizeof(itl::size_t) * 8 - 1) - __builtin_clzl(rounded);
+
+    return 9 + (log2 - 7) * 4 + ((rounded >> (log2 - 2)) & 3);
+}
+
+/**
+ * @brief Computes the size of a block header followed by its bitmap.
+ *
+ * @param totalChunks The number of chunks tracked by the bitmap.
+ * @return The header size, rounded up to BLOCK_HEADER_ALIGNMENT.
+ */
+static itl::size_t __internal_headerSize(itl::size_t totalChunks)
+{
+    itl::size_t words = (totalChunks + BITS_PER_WORD - 1) / BITS_PER_WORD;
+
+    return __internal_normalizeSize(
+        sizeof(itl::MemoryBlock) + words * sizeof(itl::size_t), BLOCK_HEADER_ALIGNMENT);
+}
+
+/**
+ * @brief Computes the alignment guaranteed to every chunk of a size class.
+ *
+ * @param chunkSize The chunk size of the class.
+ * @return The largest power of two dividing the chunk size, clamped between
+ * BLOCK_HEADER_ALIGNMENT and MIN_PAGE_SIZE.
+ */
+static itl::size_t __internal_chunkAlignment(itl::size_t chunkSize)
+{
+    itl::size_t alignment = chunkSize & -chunkSize;
+
+    if (alignment < BLOCK_HEADER_ALIGNMENT)
+        return BLOCK_HEADER_ALIGNMENT;
+
+    return alignment > MIN_PAGE_SIZE ? MIN_PAGE_SIZE : alignment;
+}
+
+/**
+ * @brief Returns the chunk bitmap stored right after a block header.
+ *
+ * @param block The block whose bitmap is requested.
+ * @return A pointer to the first word of the bitmap.
+ */
+static inline itl::size_t* __internal_bitmap(itl::MemoryBlock* block)
+{
+    return (itl::size_t*)(block + 1);
+}
+
+/**
+ * @brief Returns the block that owns a pointer handed out by the allocator.
+ *
+ * @param pointerToMemory A pointer returned by the allocator.
+ * @return The header of the owning block.
+ */
+static inline itl::MemoryBlock* __internal_blockOf(void* pointerToMemory)
+{
+    return (itl::MemoryBlock*)((itl::uintptr_t)pointerToMemory & BLOCK_MASK);
+}
+
+/**
+ * @brief Returns the descriptor of a size class, initializing it on first use.
+ *
+ * The number of chunks of a block is the largest one for which the chunks,
+ * the header and its bitmap all fit in BLOCK_SIZE bytes. The header is
+ * padded to the chunk alignment of the class, so every chunk is aligned to
+ * the largest power of two dividing the chunk size, up to MIN_PAGE_SIZE.
+ *
+ * @param index The index of the size class.
+ * @return A pointer to the size class descriptor.
+ */
+static itl::SizeClass* __internal_getSizeClass(itl::size_t index)
+{
+    itl::SizeClass* sizeClass = &internalMemoryMap.classes[index];
+
+    if (sizeClass->chunkSize == 0) {
+        itl::size_t chunkSize = sizeClassTable[index];
+        itl::size_t alignment = __internal_chunkAlignment(chunkSize);
+        itl::size_t chunks = ((BLOCK_SIZE - sizeof(itl::MemoryBlock)) * 8) / (chunkSize * 8 + 1);
+        itl::size_t headerSize = __internal_normalizeSize(__internal_headerSize(chunks), alignment);
+
+        while (headerSize + chunks * chunkSize > BLOCK_SIZE)
+            headerSize = __internal_normalizeSize(__internal_headerSize(--chunks), alignment);
+
+        sizeClass->chunksPerBlock = chunks;
+        sizeClass->headerSize = headerSize;
+        sizeClass->chunkSize = chunkSize;
+    }
+
+    return sizeClass;
+}
+
+/**
+ * @brief Computes how many chunks move between a thread cache and the
+ * central heap at once.
+ *
+ * @param index The index of the size class.
+ * @return The batch size, between 2 and MAX_CACHE_BATCH chunks.
+ */
+static itl::size_t __internal_batchSize(itl::size_t index)
+{
+    itl::size_t batch = CACHE_BATCH_BYTES / sizeClassTable[index];
+
+    if (batch < 2)
+        return 2;
+
+    return batch > MAX_CACHE_BATCH ? MAX_CACHE_BATCH : batch;
+}
+
+/**
+ * @brief Acquires the lock of the central heap.
+ *
+ * The lock is only held to move batches of chunks or to map and unmap
+ * blocks, so contended waiters usually get it while spinning; they park
+ * only when the holder is stuck in a long system call or was preempted.
+ */
+static void __internal_lockHeap()
+{
+    itl::thread::lockMutex(&internalMemoryMap.lock);
+}
+
+/**
+ * @brief Releases the lock of the central heap.
+ */
+static void __internal_unlockHeap()
+{
+    itl::thread::unlockMutex(&internalMemoryMap.lock);
+}
+
+/**
+ * @brief Acquires the lock of the large object index.
+ */
+static void __internal_lockLarge()
+{
+    itl::thread::lockMutex(&internalLargeObjects.lock);
+}
+
+/**
+ * @brief Releases the lock of the large object index.
+ */
+static void __internal_unlockLarge()
+{
+    itl::thread::unlockMutex(&internalLargeObjects.lock);
+}
+
 /**
  * @brief Searches for available memory chunks that can fit the requested size.
  *
- * This function iterates through the internal memory map to find a chunk
- * that can accommodate the requested size. If no suitable chunk is found,
- * it returns an empty result.
+ * The request is mapped to its size class and the bitmap of the first block
+ * on the list of blocks with free chunks is scanned from its search hint,
+ * so the search never depends on the number of blocks in the heap. If the
+ * class has no free chunk, it returns an empty result.
  *
  * @param size The size of the memory chunk to search for, in bytes.
  * @return An AllocationSearch structure containing the search result.
  */
 static itl::AllocationSearch __internal_searchAvailableChunks(itl::size_t size)
 {
-    itl::size_t normalizedSize = __internal_normalizeSize(size, MIN_CHUNK_SIZE);
+    itl::SizeClass* sizeClass = __internal_getSizeClass(__internal_sizeClassIndex(size));
+    itl::MemoryBlock* block = sizeClass->partialBlocks;
 
-    for (itl::size_t _block = 0; _block < internalMemoryMap.blockCount; ++_block) {
-        MemoryBlock* block = internalMemoryMap.blocks[_block];
+    if (block == nullptr) {
+        return (AllocationSearch) {
+            .block = nullptr,
+            .index = 0,
+            .found = false
+        };
+    }
 
-        if (block->chunkSize < normalizedSize)
-            continue;
+    itl::size_t* bitmap = __internal_bitmap(block);
+    itl::size_t word = block->searchHint;
 
-        for (itl::size_t iterator = 0; iterator < block->totalChunks; ++iterator) {
-            AllocationMetadata* meta = block->chunks[iterator];
+    while (bitmap[word] == ~(itl::size_t)0)
+        ++word;
 
-            if (meta == nullptr || !meta->used) {
-                return (AllocationSearch) {
-                    .block = block,
-                    .index = iterator,
-                    .found = true
-                };
-            }
-        }
-    }
+    STATS_COUNT(sizeClass->probes, word - block->searchHint + 1);
+    block->searchHint = word;
 
     return (AllocationSearch) {
-        .block = nullptr,
-        .index = 0,
-        .found = false
+        .block = block,
+        .index = word * BITS_PER_WORD + __builtin_ctzl(~bitmap[word]),
+        .found = true
     };
 }
 
@@ -99,20 +380,21 @@ static itl::AllocationSearch __internal_searchAvailableChunks(itl::size_t size)
  * from the operating system.
  *
  * @param size The size of the memory block to allocate, in bytes.
+ * @param extraFlags Mapping flags added to MAP_PRIVATE | MAP_ANONYMOUS.
  * @return A pointer to the allocated memory block, or nullptr if
  * the allocation fails.
  */
-static void* __internal_alloc(itl::size_t size)
+static void* __internal_alloc(itl::size_t size, unsigned long extraFlags)
 {
     void* pointerToAllocatedMemory;
-    itl::size_t temporarySize = __internal_normalizeSize(size, PAGE_SIZE);
+    itl::size_t temporarySize = __internal_normalizeSize(size, itl::linux::auxv::getPageSize());
 
 #ifdef __x86_64__
     pointerToAllocatedMemory = itl::linux::syscall::mmap(
         0, ///< address
         temporarySize, ///< length
         PROT_READ | PROT_WRITE, ///< protection
-        MAP_PRIVATE | MAP_ANONYMOUS, ///< flags
+        MAP_PRIVATE | MAP_ANONYMOUS | extraFlags, ///< flags
         -1, ///< fileDescriptor
         0 ///< offset
     );
@@ -121,17 +403,1303 @@ static void* __internal_alloc(itl::size_t size)
         .address = 0,
         .length = temporarySize,
         .protection = PROT_READ | PROT_WRITE,
-        .flags = MAP_PRIVATE | MAP_ANONYMOUS,
-        .fileDescriptor = -1,
+        .flags = MAP_PRIVATE | MAP_ANONYMOUS | extraFlags,
+        .fileDescriptor = (unsigned long)-1,
         .offset = 0
     };
 
     pointerToAllocatedMemory = itl::linux::syscall::mmap(arguments);
 #endif
 
-    if (pointerToAllocatedMemory == MAP_FAILED)
+    STATS_COUNT_SHARED(internalSystemCallStats.mmapCalls, 1);
+
+    // The raw system call reports failures as a negated errno value.
+    if ((itl::uintptr_t)pointerToAllocatedMemory >= (itl::uintptr_t)-4095)
         return nullptr;
 
     return pointerToAllocatedMemory;
 }
+
+/**
+ * @brief Returns memory obtained from __internal_alloc to the system.
+ *
+ * @param pointerToMemory The start of the mapping.
+ * @param size The size that was requested from __internal_alloc, in bytes.
+ */
+static void __internal_free(void* pointerToMemory, itl::size_t size)
+{
+    itl::linux::syscall::munmap(
+        (unsigned long)pointerToMemory, __internal_normalizeSize(size, itl::linux::auxv::getPageSize()));
+    STATS_COUNT_SHARED(internalSystemCallStats.munmapCalls, 1);
+}
+
+/**
+ * @brief Gives advice about a range of memory obtained from __internal_alloc.
+ *
+ * @param address The start of the range, aligned to a page.
+ * @param length The length of the range, in bytes.
+ * @param advice The advice to apply.
+ * @return 0 on success, or a negated errno value on failure.
+ */
+static int __internal_advise(itl::uintptr_t address, itl::size_t length, int advice)
+{
+    STATS_COUNT_SHARED(internalSystemCallStats.madviseCalls, 1);
+
+    return itl::linux::syscall::madvise((unsigned long)address, length, advice);
+}
+
+/**
+ * @brief Resizes or moves memory obtained from __internal_alloc.
+ *
+ * @param pointerToMemory The start of the mapping.
+ * @param oldSize The current size of the mapping, in bytes.
+ * @param newSize The new size of the mapping, in bytes.
+ * @param flags The mremap flags.
+ * @param target The new address of the mapping, with MREMAP_FIXED.
+ * @return The address of the mapping, or nullptr on failure.
+ */
+static void* __internal_remap(void* pointerToMemory, itl::size_t oldSize, itl::size_t newSize, unsigned long flags, void* target)
+{
+    void* result = itl::linux::syscall::mremap(
+        (unsigned long)pointerToMemory, oldSize, newSize, flags, (unsigned long)target);
+
+    STATS_COUNT_SHARED(internalSystemCallStats.mremapCalls, 1);
+
+    if ((itl::uintptr_t)result >= (itl::uintptr_t)-4095)
+        return nullptr;
+
+    return result;
+}
+
+/**
+ * @brief Maps memory aligned to a power-of-two boundary.
+ *
+ * The mapping is over-sized by the alignment and the unaligned head and
+ * tail are returned to the system.
+ *
+ * @param size The size of the mapping, in bytes.
+ * @param alignment The required alignment, a multiple of the page size.
+ * @return A pointer to the aligned mapping, or nullptr on failure.
+ */
+static void* __internal_allocAligned(itl::size_t size, itl::size_t alignment)
+{
+    itl::size_t mappedSize = __internal_normalizeSize(size, itl::linux::auxv::getPageSize());
+    unsigned char* raw = (unsigned char*)__internal_alloc(mappedSize + alignment, 0);
+
+    if (raw == nullptr)
+        return nullptr;
+
+    unsigned char* aligned = (unsigned char*)(((itl::uintptr_t)raw + alignment - 1) & ~(alignment - 1));
+    itl::size_t head = aligned - raw;
+    itl::size_t tail = alignment - head;
+
+    if (head > 0) {
+        itl::linux::syscall::munmap((unsigned long)raw, head);
+        STATS_COUNT_SHARED(internalSystemCallStats.munmapCalls, 1);
+    }
+
+    if (tail > 0) {
+        itl::linux::syscall::munmap((unsigned long)(aligned + mappedSize), tail);
+        STATS_COUNT_SHARED(internalSystemCallStats.munmapCalls, 1);
+    }
+
+    return aligned;
+}
+
+/**
+ * @brief Maps the memory of a block according to the huge page configuration.
+ *
+ * Explicit mode first asks for hugetlb pages, whose mappings are naturally
+ * aligned to BLOCK_SIZE. When the hugetlb pool cannot serve the request,
+ * or in transparent mode, the memory is mapped with regular pages and the
+ * whole huge pages it contains are advised with MADV_HUGEPAGE, and
+ * optionally collapsed right away.
+ *
+ * @param size The size of the block, in bytes. Updated with the mapped size.
+ * @param allowHugePages Whether the block may be backed by huge pages.
+ * @param backing Receives the backing of the mapping.
+ * @return A pointer to the BLOCK_SIZE aligned mapping, or nullptr on failure.
+ */
+static void* __internal_allocBlockMemory(itl::size_t* size, bool allowHugePages, itl::MemoryBacking* backing)
+{
+    itl::HugePageMode mode = __atomic_load_n(&internalHugePageConfig.mode, __ATOMIC_RELAXED);
+
+    *backing = BACKING_REGULAR;
+
+    if (!allowHugePages)
+        mode = HUGE_PAGES_DISABLED;
+
+    if (mode == HUGE_PAGES_EXPLICIT) {
+        itl::size_t hugeSize = __internal_normalizeSize(*size, BLOCK_SIZE);
+        void* memory = __internal_alloc(hugeSize, MAP_HUGETLB);
+
+        if (memory != nullptr) {
+            *size = hugeSize;
+            *backing = BACKING_HUGETLB;
+            __atomic_fetch_add(&internalHugePageStats.hugetlbBytes, hugeSize, __ATOMIC_RELAXED);
+
+            return memory;
+        }
+
+        __atomic_fetch_add(&internalHugePageStats.hugetlbFallbacks, 1, __ATOMIC_RELAXED);
+    }
+
+    *size = __internal_normalizeSize(*size, itl::linux::auxv::getPageSize());
+
+    void* memory = __internal_allocAligned(*size, BLOCK_SIZE);
+    itl::size_t hugeSize = *size & BLOCK_MASK;
+
+    if (memory == nullptr || mode == HUGE_PAGES_DISABLED || hugeSize == 0)
+        return memory;
+
+    if (__internal_advise((itl::uintptr_t)memory, hugeSize, MADV_HUGEPAGE) != 0)
+        return memory;
+
+    *backing = BACKING_TRANSPARENT;
+
+    if (__atomic_load_n(&internalHugePageConfig.collapse, __ATOMIC_RELAXED)
+        && __internal_advise((itl::uintptr_t)memory, hugeSize, MADV_COLLAPSE) == 0) {
+        *backing = BACKING_COLLAPSED;
+        __atomic_fetch_add(&internalHugePageStats.collapsedBytes, hugeSize, __ATOMIC_RELAXED);
+    } else {
+        __atomic_fetch_add(&internalHugePageStats.transparentBytes, hugeSize, __ATOMIC_RELAXED);
+    }
+
+    return memory;
+}
+
+/**
+ * @brief Removes the memory of a block from the huge page statistics.
+ *
+ * @param block The block whose mapping is about to change or disappear.
+ */
+static void __internal_untrackBlockMemory(itl::MemoryBlock* block)
+{
+    itl::size_t hugeSize = block->mappedSize & BLOCK_MASK;
+
+    switch (block->backing) {
+    case BACKING_HUGETLB:
+        __atomic_fetch_sub(&internalHugePageStats.hugetlbBytes, block->mappedSize, __ATOMIC_RELAXED);
+        break;
+    case BACKING_COLLAPSED:
+        __atomic_fetch_sub(&internalHugePageStats.collapsedBytes, hugeSize, __ATOMIC_RELAXED);
+        break;
+    case BACKING_TRANSPARENT:
+        __atomic_fetch_sub(&internalHugePageStats.transparentBytes, hugeSize, __ATOMIC_RELAXED);
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Unmaps the memory of a block and updates the huge page statistics.
+ *
+ * @param block The block to release.
+ */
+static void __internal_freeBlockMemory(itl::MemoryBlock* block)
+{
+    __internal_untrackBlockMemory(block);
+    __internal_free(block, block->mappedSize);
+}
+
+/**
+ * @brief Adds a block to the memory map. The heap lock must be held.
+ *
+ * @param block The block to register.
+ * @return true if the block was registered, false if the map is full.
+ */
+static bool __internal_registerBlock(itl::MemoryBlock* block)
+{
+    if (internalMemoryMap.blockCount == MAX_BLOCKS)
+        return false;
+
+    block->registryIndex = internalMemoryMap.blockCount;
+    internalMemoryMap.blocks[internalMemoryMap.blockCount++] = block;
+
+    return true;
+}
+
+/**
+ * @brief Removes a block from the memory map. The heap lock must be held.
+ *
+ * The last block of the map takes the place of the removed one.
+ *
+ * @param block The block to unregister.
+ */
+static void __internal_unregisterBlock(itl::MemoryBlock* block)
+{
+    itl::MemoryBlock* last = internalMemoryMap.blocks[--internalMemoryMap.blockCount];
+
+    last->registryIndex = block->registryIndex;
+    internalMemoryMap.blocks[block->registryIndex] = last;
+    internalMemoryMap.blocks[internalMemoryMap.blockCount] = nullptr;
+}
+
+/**
+ * @brief Links a block at the head of the partial list of its size class.
+ *
+ * @param block The block that gained a free chunk.
+ */
+static void __internal_linkPartial(itl::MemoryBlock* block)
+{
+    itl::SizeClass* sizeClass = &internalMemoryMap.classes[block->sizeClass];
+
+    block->previousPartial = nullptr;
+    block->nextPartial = sizeClass->partialBlocks;
+
+    if (sizeClass->partialBlocks != nullptr)
+        sizeClass->partialBlocks->previousPartial = block;
+
+    sizeClass->partialBlocks = block;
+}
+
+/**
+ * @brief Unlinks a block from the partial list of its size class.
+ *
+ * @param block The block that ran out of free chunks.
+ */
+static void __internal_unlinkPartial(itl::MemoryBlock* block)
+{
+    itl::SizeClass* sizeClass = &internalMemoryMap.classes[block->sizeClass];
+
+    if (block->previousPartial != nullptr)
+        block->previousPartial->nextPartial = block->nextPartial;
+    else
+        sizeClass->partialBlocks = block->nextPartial;
+
+    if (block->nextPartial != nullptr)
+        block->nextPartial->previousPartial = block->previousPartial;
+
+    block->nextPartial = nullptr;
+    block->previousPartial = nullptr;
+}
+
+/**
+ * @brief Maps and registers a new block of a size class. The heap lock
+ * must be held.
+ *
+ * Fresh mappings are zero-filled, so only the bits past the last chunk
+ * need to be marked as used.
+ *
+ * @param index The size class served by the block.
+ * @return The new block, or nullptr if it could not be created.
+ */
+static itl::MemoryBlock* __internal_createBlock(itl::size_t index)
+{
+    itl::SizeClass* sizeClass = __internal_getSizeClass(index);
+    itl::size_t mappedSize = BLOCK_SIZE;
+    itl::MemoryBacking backing;
+    itl::MemoryBlock* block = (itl::MemoryBlock*)__internal_allocBlockMemory(&mappedSize, true, &backing);
+
+    if (block == nullptr)
+        return nullptr;
+
+    block->base = (unsigned char*)block + sizeClass->headerSize;
+    block->chunkSize = sizeClass->chunkSize;
+    block->totalChunks = sizeClass->chunksPerBlock;
+    block->usedChunks = 0;
+    block->sizeClass = index;
+    block->mappedSize = mappedSize;
+    block->searchHint = 0;
+    block->backing = backing;
+    block->releasedChunks = 0;
+    block->nextPartial = nullptr;
+    block->previousPartial = nullptr;
+
+    itl::size_t tailBits = block->totalChunks % BITS_PER_WORD;
+
+    if (tailBits != 0)
+        __internal_bitmap(block)[block->totalChunks / BITS_PER_WORD] = ~(((itl::size_t)1 << tailBits) - 1);
+
+    if (!__internal_registerBlock(block)) {
+        __internal_freeBlockMemory(block);
+        return nullptr;
+    }
+
+    __internal_linkPartial(block);
+
+    return block;
+}
+
+/**
+ * @brief Takes the chunk designated by a successful search out of its block.
+ * The heap lock must be held.
+ *
+ * @param search The search result naming the block and the chunk index.
+ * @return A pointer to the chunk.
+ */
+static void* __internal_takeChunk(itl::AllocationSearch search)
+{
+    itl::MemoryBlock* block = search.block;
+
+    __internal_bitmap(block)[search.index / BITS_PER_WORD] |= (itl::size_t)1 << (search.index % BITS_PER_WORD);
+
+    if (++block->usedChunks == block->totalChunks)
+        __internal_unlinkPartial(block);
+
+    return (unsigned char*)block->base + search.index * block->chunkSize;
+}
+
+/**
+ * @brief Puts a chunk back into its block. The heap lock must be held.
+ *
+ * Chunks whose bit is already clear are ignored, so a chunk returned twice
+ * to its block does not corrupt the counters of the block. This does not
+ * catch double frees in general: a chunk freed twice while it still sits
+ * in a thread cache is cached twice and later handed out to two owners.
+ *
+ * @param block The block that owns the chunk.
+ * @param chunk The chunk to release.
+ */
+static void __internal_returnChunk(itl::MemoryBlock* block, void* chunk)
+{
+    itl::size_t index = ((itl::uintptr_t)chunk - (itl::uintptr_t)block->base) / block->chunkSize;
+    itl::size_t word = index / BITS_PER_WORD;
+    itl::size_t bit = (itl::size_t)1 << (index % BITS_PER_WORD);
+    itl::size_t* bitmap = __internal_bitmap(block);
+
+    if ((bitmap[word] & bit) == 0)
+        return;
+
+    bitmap[word] &= ~bit;
+
+    if (word < block->searchHint)
+        block->searchHint = word;
+
+    if (block->usedChunks-- == block->totalChunks)
+        __internal_linkPartial(block);
+
+    block->releasedChunks++;
+    internalMemoryMap.dirtyBytes += block->chunkSize;
+    internalMemoryMap.returnsSincePurge++;
+}
+
+/**
+ * @brief Finds the next chunk of a block in a given state.
+ *
+ * @param block The block to scan.
+ * @param index The index of the first chunk to consider.
+ * @param used Whether to look for a used chunk rather than a free one.
+ * @return The index of the chunk, or the number of chunks of the block if
+ * there is none.
+ */
+static itl::size_t __internal_findBit(itl::MemoryBlock* block, itl::size_t index, bool used)
+{
+    itl::size_t* bitmap = __internal_bitmap(block);
+
+    while (index < block->totalChunks) {
+        itl::size_t word = used ? bitmap[index / BITS_PER_WORD] : ~bitmap[index / BITS_PER_WORD];
+
+        word >>= index % BITS_PER_WORD;
+
+        if (word != 0) {
+            index += __builtin_ctzl(word);
+            return index < block->totalChunks ? index : block->totalChunks;
+        }
+
+        index = (index / BITS_PER_WORD + 1) * BITS_PER_WORD;
+    }
+
+    return block->totalChunks;
+}
+
+/**
+ * @brief Releases the pages of a block that only hold free chunks.
+ * The heap lock must be held.
+ *
+ * The bitmap is walked run by run: every run of free chunks is shrunk to
+ * the whole pages it covers, which are then released with the configured
+ * advice. Blocks backed by huge pages are skipped, because advising part of
+ * a huge page would split it.
+ *
+ * @param block The block to purge.
+ * @param advice The advice to apply, MADV_FREE or MADV_DONTNEED.
+ * @return The number of bytes released.
+ */
+static itl::size_t __internal_purgeBlockPages(itl::MemoryBlock* block, int advice)
+{
+    if (block->backing != BACKING_REGULAR)
+        return 0;
+
+    itl::size_t pageSize = itl::linux::auxv::getPageSize();
+    itl::size_t released = 0;
+    itl::size_t index = 0;
+
+    while (index < block->totalChunks) {
+        itl::size_t runStart = __internal_findBit(block, index, false);
+
+        index = __internal_findBit(block, runStart, true);
+
+        itl::uintptr_t start = (itl::uintptr_t)block->base + runStart * block->chunkSize;
+        itl::uintptr_t end = (itl::uintptr_t)block->base + index * block->chunkSize;
+
+        start = (start + pageSize - 1) & ~(pageSize - 1);
+        end &= ~(pageSize - 1);
+
+        if (start < end && __internal_advise(start, end - start, advice) == 0)
+            released += end - start;
+    }
+
+    block->releasedChunks = 0;
+
+    return released;
+}
+
+/**
+ * @brief Unregisters an empty block and returns its memory to the system.
+ * The heap lock must be held.
+ *
+ * @param block The block to destroy.
+ */
+static void __internal_destroyBlock(itl::MemoryBlock* block)
+{
+    __internal_unlinkPartial(block);
+    __internal_unregisterBlock(block);
+    __internal_freeBlockMemory(block);
+}
+
+/**
+ * @brief Purges the central heap. The heap lock must be held.
+ *
+ * @return The number of bytes returned to the kernel.
+ */
+static itl::size_t __internal_purgeLocked()
+{
+    itl::size_t emptyBlocks[SIZE_CLASS_COUNT];
+    itl::size_t retained = __atomic_load_n(&internalPurgeConfig.retainedEmptyBlocks, __ATOMIC_RELAXED);
+    int advice = __atomic_load_n(&internalPurgeConfig.advice, __ATOMIC_RELAXED);
+    itl::size_t released = 0;
+
+    for (itl::size_t index = 0; index < SIZE_CLASS_COUNT; ++index)
+        emptyBlocks[index] = 0;
+
+    for (itl::size_t position = internalMemoryMap.blockCount; position-- > 0;) {
+        itl::MemoryBlock* block = internalMemoryMap.blocks[position];
+
+        if (block->usedChunks == 0 && emptyBlocks[block->sizeClass]++ >= retained) {
+            released += block->mappedSize;
+            __internal_destroyBlock(block);
+        } else if (block->releasedChunks > 0) {
+            released += __internal_purgeBlockPages(block, advice);
+        }
+    }
+
+    internalMemoryMap.dirtyBytes = 0;
+    internalMemoryMap.returnsSincePurge = 0;
+
+    return released;
+}
+
+/**
+ * @brief Purges the central heap if the purge policy asks for it.
+ * The heap lock must be held.
+ */
+static void __internal_maybePurge()
+{
+    itl::size_t threshold = __atomic_load_n(&internalPurgeConfig.dirtyThreshold, __ATOMIC_RELAXED);
+    itl::size_t decay = __atomic_load_n(&internalPurgeConfig.decayReturns, __ATOMIC_RELAXED);
+
+    if ((threshold != 0 && internalMemoryMap.dirtyBytes >= threshold)
+        || (decay != 0 && internalMemoryMap.returnsSincePurge >= decay))
+        __internal_purgeLocked();
+}
+
+/**
+ * @brief Moves a batch of chunks from the central heap into a cache bin.
+ *
+ * @param bin The empty bin to refill.
+ * @param index The size class of the bin.
+ * @return true if at least one chunk was cached, false if memory is exhausted.
+ */
+static bool __internal_refillBin(itl::CacheBin* bin, itl::size_t index)
+{
+    itl::size_t batch = __internal_batchSize(index);
+    itl::size_t chunkSize = sizeClassTable[index];
+
+    __internal_lockHeap();
+
+    while (bin->count < batch) {
+        itl::AllocationSearch search = __internal_searchAvailableChunks(chunkSize);
+
+        if (!search.found) {
+            if (__internal_createBlock(index) == nullptr)
+                break;
+
+            continue;
+        }
+
+        void* chunk = __internal_takeChunk(search);
+
+        *(void**)chunk = bin->head;
+        bin->head = chunk;
+        bin->count++;
+    }
+
+    __internal_unlockHeap();
+
+    return bin->count > 0;
+}
+
+/**
+ * @brief Moves chunks from a cache bin back to the central heap.
+ *
+ * @param bin The bin to drain.
+ * @param count The number of chunks to return.
+ */
+static void __internal_drainBin(itl::CacheBin* bin, itl::size_t count)
+{
+    __internal_lockHeap();
+
+    while (count-- > 0 && bin->head != nullptr) {
+        void* chunk = bin->head;
+
+        bin->head = *(void**)chunk;
+        bin->count--;
+
+        __internal_returnChunk(__internal_blockOf(chunk), chunk);
+    }
+
+    __internal_maybePurge();
+    __internal_unlockHeap();
+}
+
+/**
+ * @brief Finds the first entry of the large object index that is not below
+ * a block number. The index lock must be held.
+ *
+ * @param key The block number to look for.
+ * @return The position of the entry, between 0 and the entry count.
+ */
+static itl::size_t __internal_lowerBoundLarge(itl::uint32_t key)
+{
+    itl::size_t low = 0;
+    itl::size_t high = internalLargeObjects.count;
+
+    while (low < high) {
+        itl::size_t middle = low + (high - low) / 2;
+
+        if (internalLargeObjects.entries[middle] < key)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    return low;
+}
+
+/**
+ * @brief Records a large block in the index. The index lock must be held.
+ *
+ * The entry array is mapped on first use and doubled with mremap when it
+ * is full, which moves its pages rather than copying them.
+ *
+ * @param block The large block to record.
+ * @return false if the array could not grow.
+ */
+static bool __internal_indexLarge(itl::MemoryBlock* block)
+{
+    itl::LargeObjectIndex* index = &internalLargeObjects;
+
+    if (index->count == index->capacity) {
+        itl::size_t capacity = index->capacity == 0 ? LARGE_INDEX_MIN_CAPACITY : index->capacity * 2;
+        void* entries;
+
+        if (index->entries == nullptr) {
+            entries = __internal_alloc(capacity * sizeof(itl::uint32_t), 0);
+        } else {
+            entries = __internal_remap(index->entries,
+                __internal_normalizeSize(index->capacity * sizeof(itl::uint32_t), itl::linux::auxv::getPageSize()),
+                __internal_normalizeSize(capacity * sizeof(itl::uint32_t), itl::linux::auxv::getPageSize()),
+                MREMAP_MAYMOVE, nullptr);
+        }
+
+        if (entries == nullptr)
+            return false;
+
+        index->entries = (itl::uint32_t*)entries;
+        index->capacity = capacity;
+    }
+
+    itl::uint32_t key = (itl::uint32_t)((itl::uintptr_t)block >> BLOCK_SHIFT);
+    itl::size_t position = __internal_lowerBoundLarge(key);
+
+    itl::simd::copy(&index->entries[position + 1], &index->entries[position],
+        (index->count - position) * sizeof(itl::uint32_t));
+
+    index->entries[position] = key;
+    index->count++;
+    index->mappedBytes += block->mappedSize;
+
+    return true;
+}
+
+/**
+ * @brief Removes a large block from the index. The index lock must be held.
+ *
+ * @param block The large block to remove.
+ */
+static void __internal_unindexLarge(itl::MemoryBlock* block)
+{
+    itl::LargeObjectIndex* index = &internalLargeObjects;
+    itl::size_t position = __internal_lowerBoundLarge((itl::uint32_t)((itl::uintptr_t)block >> BLOCK_SHIFT));
+
+    itl::simd::copy(&index->entries[position], &index->entries[position + 1],
+        (index->count - position - 1) * sizeof(itl::uint32_t));
+
+    index->count--;
+    index->mappedBytes -= block->mappedSize;
+}
+
+/**
+ * @brief Allocates a dedicated block for a request above MAX_SMALL_SIZE.
+ *
+ * The block is mapped directly and recorded in the large object index;
+ * the central heap lock is never taken. The header is padded so that the
+ * allocation starts at the requested alignment.
+ *
+ * @param size The size requested by the caller, in bytes.
+ * @param alignment The alignment of the allocation, a power of two below
+ * BLOCK_SIZE.
+ * @return A pointer to the allocated memory, or nullptr on failure.
+ */
+static void* __internal_allocLarge(itl::size_t size, itl::size_t alignment)
+{
+    itl::size_t headerSize = __internal_normalizeSize(
+        __internal_headerSize(1), alignment > BLOCK_HEADER_ALIGNMENT ? alignment : BLOCK_HEADER_ALIGNMENT);
+    itl::size_t mappedSize = headerSize + size;
+    bool allowHugePages = size >= __atomic_load_n(&internalHugePageConfig.minimumLargeSize, __ATOMIC_RELAXED);
+    itl::MemoryBacking backing;
+    itl::MemoryBlock* block = (itl::MemoryBlock*)__internal_allocBlockMemory(&mappedSize, allowHugePages, &backing);
+
+    if (block == nullptr)
+        return nullptr;
+
+    block->base = (unsigned char*)block + headerSize;
+    block->chunkSize = mappedSize - headerSize;
+    block->totalChunks = 1;
+    block->usedChunks = 1;
+    block->sizeClass = LARGE_CLASS;
+    block->mappedSize = mappedSize;
+    block->backing = backing;
+    __internal_bitmap(block)[0] = 1;
+
+    __internal_lockLarge();
+
+    bool indexed = __internal_indexLarge(block);
+
+    if (indexed)
+        STATS_COUNT(internalLargeObjects.allocations, 1);
+
+    __internal_unlockLarge();
+
+    if (!indexed) {
+        __internal_freeBlockMemory(block);
+        return nullptr;
+    }
+
+    return block->base;
+}
+
+/**
+ * @brief Unmaps a large block and removes it from the index.
+ *
+ * @param block The large block to release.
+ */
+static void __internal_freeLarge(itl::MemoryBlock* block)
+{
+    __internal_lockLarge();
+    __internal_unindexLarge(block);
+    STATS_COUNT(internalLargeObjects.frees, 1);
+    __internal_unlockLarge();
+
+    __internal_freeBlockMemory(block);
+}
+
+/**
+ * @brief Resizes a large block by remapping its pages instead of copying them.
+ * The index lock must be held.
+ *
+ * Shrinking releases the tail of the mapping in place. Growing first
+ * extends the mapping in place; when the following address range is taken,
+ * a new BLOCK_SIZE aligned range is reserved and the pages are moved there
+ * with MREMAP_FIXED, which replaces the reservation. Blocks backed by
+ * hugetlb pages are not remapped.
+ *
+ * @param block The large block to resize.
+ * @param newSize The size requested by the caller, in bytes.
+ * @return The address of the allocation after the resize, or nullptr if
+ * the block could not be remapped and must be copied instead.
+ */
+static void* __internal_resizeLarge(itl::MemoryBlock* block, itl::size_t newSize)
+{
+    if (block->backing == BACKING_HUGETLB)
+        return nullptr;
+
+    itl::size_t headerSize = (unsigned char*)block->base - (unsigned char*)block;
+    itl::size_t oldSize = block->mappedSize;
+    itl::size_t mappedSize = __internal_normalizeSize(headerSize + newSize, itl::linux::auxv::getPageSize());
+
+    if (mappedSize == oldSize)
+        return block->base;
+
+    void* result = __internal_remap(block, oldSize, mappedSize, 0, nullptr);
+    bool moved = false;
+
+    if (result == nullptr) {
+        void* target = __internal_allocAligned(mappedSize, BLOCK_SIZE);
+
+        if (target == nullptr)
+            return nullptr;
+
+        // The entry is keyed by the address, so it is replaced after the move.
+        __internal_unindexLarge(block);
+
+        result = __internal_remap(block, oldSize, mappedSize, MREMAP_MAYMOVE | MREMAP_FIXED, target);
+
+        if (result == nullptr) {
+            __internal_indexLarge(block);
+            __internal_free(target, mappedSize);
+            return nullptr;
+        }
+
+        moved = true;
+    } else {
+        internalLargeObjects.mappedBytes -= oldSize;
+    }
+
+    // The header moved along with the pages.
+    block = (itl::MemoryBlock*)result;
+    __internal_untrackBlockMemory(block);
+
+    // Pages added by growing are only advised, whatever the old pages were.
+    if ((block->backing == BACKING_TRANSPARENT || block->backing == BACKING_COLLAPSED)
+        && (mappedSize & BLOCK_MASK) > (oldSize & BLOCK_MASK)) {
+        __internal_advise((itl::uintptr_t)block + (oldSize & BLOCK_MASK), (mappedSize & BLOCK_MASK) - (oldSize & BLOCK_MASK),
+            MADV_HUGEPAGE);
+        block->backing = BACKING_TRANSPARENT;
+    }
+
+    block->base = (unsigned char*)block + headerSize;
+    block->chunkSize = mappedSize - headerSize;
+    block->mappedSize = mappedSize;
+
+    if (block->backing == BACKING_TRANSPARENT)
+        __atomic_fetch_add(&internalHugePageStats.transparentBytes, mappedSize & BLOCK_MASK, __ATOMIC_RELAXED);
+    else if (block->backing == BACKING_COLLAPSED)
+        __atomic_fetch_add(&internalHugePageStats.collapsedBytes, mappedSize & BLOCK_MASK, __ATOMIC_RELAXED);
+
+    if (moved) {
+        // Cannot fail, since an entry was just removed.
+        __internal_indexLarge(block);
+        internalLargeObjects.movedResizes++;
+    } else {
+        internalLargeObjects.mappedBytes += mappedSize;
+        internalLargeObjects.inPlaceResizes++;
+    }
+
+    return block->base;
+}
+
+#if ITL_ALLOCATOR_STATS
+/**
+ * @brief Adds the cache of the calling thread to the registry, once.
+ */
+static void __internal_registerThreadCache()
+{
+    itl::ThreadCache* cache = &internalThreadCache;
+
+    if (__builtin_expect(cache->registered, 1))
+        return;
+
+    __internal_lockHeap();
+
+    cache->previousCache = nullptr;
+    cache->nextCache = internalThreadCaches;
+
+    if (internalThreadCaches != nullptr)
+        internalThreadCaches->previousCache = cache;
+
+    internalThreadCaches = cache;
+    cache->registered = true;
+
+    __internal_unlockHeap();
+}
+
+/**
+ * @brief Folds the counters of the calling thread into the retired totals
+ * and removes its cache from the registry.
+ */
+static void __internal_unregisterThreadCache()
+{
+    itl::ThreadCache* cache = &internalThreadCache;
+
+    if (!cache->registered)
+        return;
+
+    __internal_lockHeap();
+
+    for (itl::size_t index = 0; index < SIZE_CLASS_COUNT; ++index) {
+        internalRetiredStats.allocations[index] += cache->stats.allocations[index];
+        internalRetiredStats.frees[index] += cache->stats.frees[index];
+        cache->stats.allocations[index] = 0;
+        cache->stats.frees[index] = 0;
+    }
+
+    if (cache->previousCache != nullptr)
+        cache->previousCache->nextCache = cache->nextCache;
+    else
+        internalThreadCaches = cache->nextCache;
+
+    if (cache->nextCache != nullptr)
+        cache->nextCache->previousCache = cache->previousCache;
+
+    cache->registered = false;
+
+    __internal_unlockHeap();
+}
+#endif // ITL_ALLOCATOR_STATS
+
+/**
+ * @brief Takes a chunk of a size class from the cache of the calling thread.
+ *
+ * @param index The index of the size class.
+ * @return A pointer to the chunk, or nullptr if the bin could not be refilled.
+ */
+static inline void* __internal_allocSmall(itl::size_t index)
+{
+    itl::CacheBin* bin = &internalThreadCache.bins[index];
+
+    if (bin->head == nullptr) {
+#if ITL_ALLOCATOR_STATS
+        __internal_registerThreadCache();
+#endif
+        if (!__internal_refillBin(bin, index))
+            return nullptr;
+    }
+
+    void* chunk = bin->head;
+
+    bin->head = *(void**)chunk;
+    bin->count--;
+    STATS_COUNT(internalThreadCache.stats.allocations[index], 1);
+
+    return chunk;
+}
+
+/**
+ * @brief Puts a chunk of a size class into the cache of the calling thread.
+ *
+ * @param chunk The chunk to cache.
+ * @param index The index of the size class of the chunk.
+ */
+static inline void __internal_freeSmall(void* chunk, itl::size_t index)
+{
+    itl::CacheBin* bin = &internalThreadCache.bins[index];
+
+#if ITL_ALLOCATOR_STATS
+    __internal_registerThreadCache();
+    STATS_COUNT(internalThreadCache.stats.frees[index], 1);
+#endif
+
+    *(void**)chunk = bin->head;
+    bin->head = chunk;
+
+    if (++bin->count >= 2 * __internal_batchSize(index))
+        __internal_drainBin(bin, __internal_batchSize(index));
+}
+
+#if ITL_ALLOCATOR_PROFILING
+/**
+ * @brief Counts the bytes of an allocation towards the next sample of the
+ * calling thread.
+ *
+ * Each thread takes one sample every time its allocated bytes cross a
+ * multiple of the interval, so the same run always samples the same
+ * allocations. The sample stands for the interval times the number of
+ * multiples crossed. A remainder carried over from a larger interval is
+ * wrapped into the current one, so lowering the interval does not charge
+ * the bytes allocated before it to the next sample. While profiling is
+ * off, only the interval is read.
+ *
+ * @param pointerToMemory The allocation, or nullptr if it failed.
+ * @param size The bytes requested.
+ */
+static inline void __internal_profileAllocation(void* pointerToMemory, itl::size_t size)
+{
+    itl::size_t interval = __atomic_load_n(&itl::profiler::internalSampler.interval, __ATOMIC_RELAXED);
+
+    if (__builtin_expect(interval == 0 || pointerToMemory == nullptr, 1))
+        return;
+
+    itl::size_t sampledBytes = internalThreadCache.sampledBytes;
+
+    if (__builtin_expect(sampledBytes >= interval, 0))
+        sampledBytes %= interval;
+
+    sampledBytes += size;
+
+    if (sampledBytes < interval) {
+        internalThreadCache.sampledBytes = sampledBytes;
+        return;
+    }
+
+    internalThreadCache.sampledBytes = sampledBytes % interval;
+    itl::profiler::recordAllocation(pointerToMemory, size, sampledBytes - sampledBytes % interval);
+}
+
+/**
+ * @brief Tells the profiler an allocation is about to be freed, when any
+ * sampled allocation is still live.
+ *
+ * @param pointerToMemory The allocation.
+ */
+static inline void __internal_profileFree(void* pointerToMemory)
+{
+    if (__builtin_expect(__atomic_load_n(&itl::profiler::internalSampler.liveSamples, __ATOMIC_RELAXED) != 0, 0))
+        itl::profiler::recordFree(pointerToMemory);
+}
+#else
+#define __internal_profileAllocation(pointerToMemory, size) ((void)0)
+#define __internal_profileFree(pointerToMemory) ((void)0)
+#endif // ITL_ALLOCATOR_PROFILING
+
+void* alloc(itl::size_t size)
+{
+    if (size == 0)
+        return nullptr;
+
+    void* pointerToMemory = size > MAX_SMALL_SIZE ? __internal_allocLarge(size, BLOCK_HEADER_ALIGNMENT)
+                                                  : __internal_allocSmall(__internal_sizeClassIndex(size));
+
+    __internal_profileAllocation(pointerToMemory, size);
+
+    return pointerToMemory;
+}
+
+void* allocAligned(itl::size_t size, itl::size_t alignment)
+{
+    if (size == 0 || alignment == 0 || (alignment & (alignment - 1)) != 0 || alignment >= BLOCK_SIZE)
+        return nullptr;
+
+    if (size <= MAX_SMALL_SIZE && alignment <= MIN_PAGE_SIZE) {
+        itl::size_t index = __internal_sizeClassIndex(size);
+
+        // Chunks are aligned to the lowest set bit of their size, up to a page.
+        while (index < SIZE_CLASS_COUNT && (sizeClassTable[index] & (alignment - 1)) != 0)
+            ++index;
+
+        if (index < SIZE_CLASS_COUNT) {
+            void* pointerToMemory = __internal_allocSmall(index);
+
+            __internal_profileAllocation(pointerToMemory, size);
+
+            return pointerToMemory;
+        }
+    }
+
+    void* pointerToMemory = __internal_allocLarge(size, alignment);
+
+    __internal_profileAllocation(pointerToMemory, size);
+
+    return pointerToMemory;
+}
+
+void* calloc(itl::size_t number, itl::size_t size)
+{
+    itl::size_t total;
+
+    if (__builtin_mul_overflow(number, size, &total))
+        return nullptr;
+
+    void* pointerToMemory = alloc(total);
+
+    if (pointerToMemory != nullptr)
+        itl::simd::fill(pointerToMemory, 0, total);
+
+    return pointerToMemory;
+}
+
+void* realloc(void* pointerToMemory, itl::size_t newSize)
+{
+    if (pointerToMemory == nullptr)
+        return alloc(newSize);
+
+    if (newSize == 0) {
+        free(pointerToMemory);
+        return nullptr;
+    }
+
+    itl::MemoryBlock* block = __internal_blockOf(pointerToMemory);
+
+    if (block->sizeClass != LARGE_CLASS) {
+        // Staying in the same class keeps the size known to freeSized valid.
+        if (newSize <= MAX_SMALL_SIZE && __internal_sizeClassIndex(newSize) == block->sizeClass)
+            return pointerToMemory;
+    } else if (newSize > MAX_SMALL_SIZE) {
+        __internal_lockLarge();
+
+        void* resized = __internal_resizeLarge(block, newSize);
+
+        __internal_unlockLarge();
+
+#if ITL_ALLOCATOR_PROFILING
+        if (resized != nullptr && resized != pointerToMemory
+            && __atomic_load_n(&itl::profiler::internalSampler.liveSamples, __ATOMIC_RELAXED) != 0)
+            itl::profiler::recordMove(pointerToMemory, resized);
+#endif
+
+        if (resized != nullptr)
+            return resized;
+
+        if (newSize <= block->chunkSize)
+            return pointerToMemory;
+    }
+
+    void* newPointer = alloc(newSize);
+
+    if (newPointer == nullptr)
+        return nullptr;
+
+    itl::simd::copy(newPointer, pointerToMemory, newSize < block->chunkSize ? newSize : block->chunkSize);
+    free(pointerToMemory);
+
+    return newPointer;
+}
+
+void free(void* pointerToMemory)
+{
+    if (pointerToMemory == nullptr)
+        return;
+
+    __internal_profileFree(pointerToMemory);
+
+    itl::MemoryBlock* block = __internal_blockOf(pointerToMemory);
+
+    if (block->sizeClass == LARGE_CLASS) {
+        __internal_freeLarge(block);
+        return;
+    }
+
+    __internal_freeSmall(pointerToMemory, block->sizeClass);
+}
+
+itl::size_t usableSize(const void* pointerToMemory)
+{
+    if (pointerToMemory == nullptr)
+        return 0;
+
+    itl::MemoryBlock* block = __internal_blockOf((void*)pointerToMemory);
+
+    if (block->sizeClass != LARGE_CLASS)
+        return block->chunkSize;
+
+    return block->mappedSize - ((const unsigned char*)pointerToMemory - (const unsigned char*)block);
+}
+
+void freeSized(void* pointerToMemory, itl::size_t size)
+{
+    if (pointerToMemory == nullptr)
+        return;
+
+    if (size == 0 || size > MAX_SMALL_SIZE) {
+        free(pointerToMemory);
+        return;
+    }
+
+    __internal_profileFree(pointerToMemory);
+    __internal_freeSmall(pointerToMemory, __internal_sizeClassIndex(size));
+}
+
+void* allocPages(itl::size_t size)
+{
+    return __internal_alloc(size, 0);
+}
+
+void freePages(void* pointerToMemory, itl::size_t size)
+{
+    if (pointerToMemory != nullptr)
+        __internal_free(pointerToMemory, size);
+}
+
+void* findLargeAllocation(const void* address)
+{
+    itl::uint32_t key = (itl::uint32_t)((itl::uintptr_t)address >> BLOCK_SHIFT);
+    void* found = nullptr;
+
+    __internal_lockLarge();
+
+    itl::size_t position = __internal_lowerBoundLarge(key + 1);
+
+    if (position > 0) {
+        itl::MemoryBlock* block = (itl::MemoryBlock*)((itl::uintptr_t)internalLargeObjects.entries[position - 1] << BLOCK_SHIFT);
+
+        if ((unsigned char*)address >= (unsigned char*)block->base
+            && (unsigned char*)address < (unsigned char*)block + block->mappedSize)
+            found = block->base;
+    }
+
+    __internal_unlockLarge();
+
+    return found;
+}
+
+void getLargeObjectStats(itl::LargeObjectStats* stats)
+{
+    __internal_lockLarge();
+
+    stats->count = internalLargeObjects.count;
+    stats->mappedBytes = internalLargeObjects.mappedBytes;
+    stats->inPlaceResizes = internalLargeObjects.inPlaceResizes;
+    stats->movedResizes = internalLargeObjects.movedResizes;
+
+    __internal_unlockLarge();
+}
+
+#if ITL_ALLOCATOR_STATS
+/**
+ * @brief Derives the bytes in use and the fragmentation of a size class
+ * from its counters.
+ *
+ * @param stats The statistics to complete.
+ */
+static void __internal_finishClassStats(itl::SizeClassStats* stats)
+{
+    // Counters of running threads are read one by one and may be skewed.
+    if (stats->chunkSize != 0)
+        stats->bytesInUse = stats->allocations > stats->frees ? (stats->allocations - stats->frees) * stats->chunkSize : 0;
+
+    if (stats->bytesInUse > stats->bytesMapped)
+        stats->bytesInUse = stats->bytesMapped;
+
+    stats->fragmentation = stats->bytesMapped == 0 ? 0.0 : 1.0 - (double)stats->bytesInUse / (double)stats->bytesMapped;
+}
+#endif // ITL_ALLOCATOR_STATS
+
+void getAllocatorStats(itl::AllocatorStats* stats)
+{
+    itl::simd::fill(stats, 0, sizeof(itl::AllocatorStats));
+
+#if ITL_ALLOCATOR_STATS
+    __internal_lockHeap();
+
+    for (itl::size_t index = 0; index < SIZE_CLASS_COUNT; ++index) {
+        itl::SizeClassStats* classStats = &stats->classes[index];
+
+        classStats->chunkSize = sizeClassTable[index];
+        classStats->allocations = internalRetiredStats.allocations[index];
+        classStats->frees = internalRetiredStats.frees[index];
+        classStats->probes = internalMemoryMap.classes[index].probes;
+    }
+
+    for (itl::ThreadCache* cache = internalThreadCaches; cache != nullptr; cache = cache->nextCache) {
+        for (itl::size_t index = 0; index < SIZE_CLASS_COUNT; ++index) {
+            stats->classes[index].allocations += __atomic_load_n(&cache->stats.allocations[index], __ATOMIC_RELAXED);
+            stats->classes[index].frees += __atomic_load_n(&cache->stats.frees[index], __ATOMIC_RELAXED);
+        }
+
+        stats->threads++;
+    }
+
+    for (itl::size_t index = 0; index < internalMemoryMap.blockCount; ++index) {
+        itl::MemoryBlock* block = internalMemoryMap.blocks[index];
+
+        stats->classes[block->sizeClass].blocks++;
+        stats->classes[block->sizeClass].bytesMapped += block->mappedSize;
+    }
+
+    __internal_unlockHeap();
+
+    __internal_lockLarge();
+
+    stats->large.allocations = internalLargeObjects.allocations;
+    stats->large.frees = internalLargeObjects.frees;
+    stats->large.blocks = internalLargeObjects.count;
+    stats->large.bytesMapped = internalLargeObjects.mappedBytes;
+
+    for (itl::size_t index = 0; index < internalLargeObjects.count; ++index)
+        stats->large.bytesInUse += ((itl::MemoryBlock*)((itl::uintptr_t)internalLargeObjects.entries[index] << BLOCK_SHIFT))->chunkSize;
+
+    __internal_unlockLarge();
+
+    for (itl::size_t index = 0; index < SIZE_CLASS_COUNT; ++index) {
+        __internal_finishClassStats(&stats->classes[index]);
+        stats->bytesInUse += stats->classes[index].bytesInUse;
+        stats->bytesMapped += stats->classes[index].bytesMapped;
+    }
+
+    __internal_finishClassStats(&stats->large);
+    stats->bytesInUse += stats->large.bytesInUse;
+    stats->bytesMapped += stats->large.bytesMapped;
+    stats->fragmentation = stats->bytesMapped == 0 ? 0.0 : 1.0 - (double)stats->bytesInUse / (double)stats->bytesMapped;
+
+    stats->systemCalls.mmapCalls = __atomic_load_n(&internalSystemCallStats.mmapCalls, __ATOMIC_RELAXED);
+    stats->systemCalls.munmapCalls = __atomic_load_n(&internalSystemCallStats.munmapCalls, __ATOMIC_RELAXED);
+    stats->systemCalls.mremapCalls = __atomic_load_n(&internalSystemCallStats.mremapCalls, __ATOMIC_RELAXED);
+    stats->systemCalls.madviseCalls = __atomic_load_n(&internalSystemCallStats.madviseCalls, __ATOMIC_RELAXED);
+#endif // ITL_ALLOCATOR_STATS
+}
+
+void releaseThreadCache()
+{
+    for (itl::size_t index = 0; index < SIZE_CLASS_COUNT; ++index) {
+        itl::CacheBin* bin = &internalThreadCache.bins[index];
+
+        if (bin->count > 0)
+            __internal_drainBin(bin, bin->count);
+    }
+
+#if ITL_ALLOCATOR_STATS
+    __internal_unregisterThreadCache();
+#endif
+}
+
+itl::size_t purge()
+{
+    __internal_lockHeap();
+
+    itl::size_t released = __internal_purgeLocked();
+
+    __internal_unlockHeap();
+
+    return released;
+}
+
+void setPurgeConfig(const itl::PurgeConfig* config)
+{
+    __atomic_store_n(&internalPurgeConfig.dirtyThreshold, config->dirtyThreshold, __ATOMIC_RELAXED);
+    __atomic_store_n(&internalPurgeConfig.decayReturns, config->decayReturns, __ATOMIC_RELAXED);
+    __atomic_store_n(&internalPurgeConfig.retainedEmptyBlocks, config->retainedEmptyBlocks, __ATOMIC_RELAXED);
+    __atomic_store_n(&internalPurgeConfig.advice, config->advice, __ATOMIC_RELAXED);
+}
+
+void getPurgeConfig(itl::PurgeConfig* config)
+{
+    config->dirtyThreshold = __atomic_load_n(&internalPurgeConfig.dirtyThreshold, __ATOMIC_RELAXED);
+    config->decayReturns = __atomic_load_n(&internalPurgeConfig.decayReturns, __ATOMIC_RELAXED);
+    config->retainedEmptyBlocks = __atomic_load_n(&internalPurgeConfig.retainedEmptyBlocks, __ATOMIC_RELAXED);
+    config->advice = __atomic_load_n(&internalPurgeConfig.advice, __ATOMIC_RELAXED);
+}
+
+void setHugePageConfig(const itl::HugePageConfig* config)
+{
+    __atomic_store_n(&internalHugePageConfig.collapse, config->collapse, __ATOMIC_RELAXED);
+    __atomic_store_n(&internalHugePageConfig.minimumLargeSize, config->minimumLargeSize, __ATOMIC_RELAXED);
+    __atomic_store_n(&internalHugePageConfig.mode, config->mode, __ATOMIC_RELEASE);
+}
+
+void getHugePageConfig(itl::HugePageConfig* config)
+{
+    config->mode = __atomic_load_n(&internalHugePageConfig.mode, __ATOMIC_ACQUIRE);
+    config->collapse = __atomic_load_n(&internalHugePageConfig.collapse, __ATOMIC_RELAXED);
+    config->minimumLargeSize = __atomic_load_n(&internalHugePageConfig.minimumLargeSize, __ATOMIC_RELAXED);
+}
+
+void getHugePageStats(itl::HugePageStats* stats)
+{
+    stats->hugetlbBytes = __atomic_load_n(&internalHugePageStats.hugetlbBytes, __ATOMIC_RELAXED);
+    stats->collapsedBytes = __atomic_load_n(&internalHugePageStats.collapsedBytes, __ATOMIC_RELAXED);
+    stats->transparentBytes = __atomic_load_n(&internalHugePageStats.transparentBytes, __ATOMIC_RELAXED);
+    stats->hugetlbFallbacks = __atomic_load_n(&internalHugePageStats.hugetlbFallbacks, __ATOMIC_RELAXED);
+}
 } // namespace itl
@@ -0,0 +1,147 @@
+/**
+ * @file src/memory/arena.cpp
+ * @brief Implements bump-pointer memory arenas for the ITL library.
+ * @category Memory Management
+ *
+ * This file contains the slow paths of the arena allocator: mapping new
+ * chunks, rewinding to checkpoints and releasing whole arenas. Chunks are
+ * mapped directly through the allocator page interface.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#include "memory/arena.hpp"
+#include "memory/allocator.hpp"
+#include "system/auxv.hpp"
+#include "typing/ctypes.hpp"
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace arena {
+    /**
+     * @brief Makes a chunk the current chunk of an arena.
+     *
+     * @param arena The arena that owns the chunk.
+     * @param chunk The chunk to activate.
+     */
+    static void __internal_activateChunk(itl::arena::Arena* arena, itl::arena::ArenaChunk* chunk)
+    {
+        chunk->previous = arena->current;
+        arena->current = chunk;
+        arena->position = (unsigned char*)(chunk + 1);
+        arena->end = (unsigned char*)chunk + chunk->size;
+    }
+
+    /**
+     * @brief Unmaps a chunk, or keeps it as the spare of the arena.
+     *
+     * @param arena The arena that owns the chunk.
+     * @param chunk The chunk to release.
+     */
+    static void __internal_releaseChunk(itl::arena::Arena* arena, itl::arena::ArenaChunk* chunk)
+    {
+        if (arena->spare == nullptr && chunk->size == arena->chunkSize) {
+            arena->spare = chunk;
+            return;
+        }
+
+        itl::freePages(chunk, chunk->size);
+    }
+
+    void create(itl::arena::Arena* arena, itl::size_t chunkSize)
+    {
+        itl::size_t pageSize = itl::linux::auxv::getPageSize();
+
+        if (chunkSize == 0)
+            chunkSize = ARENA_DEFAULT_CHUNK_SIZE;
+
+        arena->current = nullptr;
+        arena->spare = nullptr;
+        arena->position = nullptr;
+        arena->end = nullptr;
+        arena->chunkSize = (chunkSize + pageSize - 1) & ~(pageSize - 1);
+    }
+
+    void* allocFromNewChunk(itl::arena::Arena* arena, itl::size_t size, itl::size_t alignment)
+    {
+        itl::size_t pageSize = itl::linux::auxv::getPageSize();
+        itl::size_t needed = sizeof(itl::arena::ArenaChunk) + alignment - 1 + size;
+        itl::arena::ArenaChunk* chunk;
+
+        if (needed < size)
+            return nullptr;
+
+        if (needed <= arena->chunkSize && arena->spare != nullptr) {
+            chunk = arena->spare;
+            arena->spare = nullptr;
+        } else {
+            itl::size_t chunkSize = needed <= arena->chunkSize
+                ? arena->chunkSize
+                : (needed + pageSize - 1) & ~(pageSize - 1);
+
+            chunk = (itl::arena::ArenaChunk*)itl::allocPages(chunkSize);
+
+            if (chunk == nullptr)
+                return nullptr;
+
+            chunk->size = chunkSize;
+        }
+
+        __internal_activateChunk(arena, chunk);
+
+        return itl::arena::alloc(arena, size, alignment);
+    }
+
+    void rewind(itl::arena::Arena* arena, itl::arena::Checkpoint checkpoint)
+    {
+        while (arena->current != checkpoint.chunk) {
+            itl::arena::ArenaChunk* chunk = arena->current;
+
+            arena->current = chunk->previous;
+            __internal_releaseChunk(arena, chunk);
+        }
+
+        if (arena->current == nullptr) {
+            arena->position = nullptr;
+            arena->end = nullptr;
+            return;
+        }
+
+        arena->position = checkpoint.position;
+        arena->end = (unsigned char*)arena->current + arena->current->size;
+    }
+
+    void reset(itl::arena::Arena* arena)
+    {
+        itl::arena::ArenaChunk* first = arena->current;
+
+        if (first == nullptr)
+            return;
+
+        while (first->previous != nullptr)
+            first = first->previous;
+
+        rewind(arena, (itl::arena::Checkpoint) {
+            .chunk = first,
+            .position = (unsigned char*)(first + 1)
+        });
+    }
+
+    void release(itl::arena::Arena* arena)
+    {
+        rewind(arena, (itl::arena::Checkpoint) {
+            .chunk = nullptr,
+            .position = nullptr
+        });
+
+        if (arena->spare != nullptr)
+            itl::freePages(arena->spare, arena->spare->size);
+
+        arena->spare = nullptr;
+    }
+}; // namespace arena
+} // namespace itl
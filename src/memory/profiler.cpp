@@ -0,0 +1,585 @@
+/**
+ * @file src/memory/profiler.cpp
+ * @brief Implements the sampling heap profiler of the ITL allocator.
+ * @category Memory Management
+ *
+ * This file contains the frame pointer walk, the lock-free table of
+ * sampled allocations that are still live, the ring that carries samples
+ * from the allocating threads to the per-stack totals, and the writer of
+ * the heap profile.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#include "memory/profiler.hpp"
+#include "containers/queue.hpp"
+#include "io/print.hpp"
+#include "memory/allocator.hpp"
+#include "memory/placement.hpp"
+#include "system/fmacros.hpp"
+#include "system/simd.hpp"
+#include "system/sync.hpp"
+#include "system/syscalls.hpp"
+#include "typing/ctypes.hpp"
+
+#define LIVE_EMPTY 0 ///< Address of a live table slot that was never used.
+#define LIVE_DELETED 1 ///< Address of a live table slot whose allocation was freed.
+#define MAPS_BUFFER_SIZE 4096 ///< Bytes of /proc/self/maps copied at once.
+
+/**
+ * @struct ProfilerTables
+ * @brief Everything the profiler keeps, mapped once with allocPages.
+ *
+ * The ring is mapped separately on huge pages, so none of the profiler
+ * state comes from the heap being profiled.
+ *
+ * The sites are only touched by the thread holding the profiler lock. The
+ * live table and the counters are shared by every allocating thread.
+ */
+typedef struct {
+    itl::queue::MpmcQueue<itl::profiler::ProfileSample> ring; ///< Samples not folded into the sites yet.
+    itl::profiler::ProfileSite sites[PROFILE_SITE_CAPACITY]; ///< Totals by call stack, open addressed by hash.
+    itl::profiler::ProfileSite overflow; ///< Totals of the stacks that found the site table full.
+    itl::profiler::LiveSample live[PROFILE_LIVE_CAPACITY]; ///< Sampled allocations, open addressed by address.
+    itl::size_t siteCount; ///< Sites in use.
+    itl::size_t samples; ///< Allocations sampled so far.
+    itl::size_t frees; ///< Sampled allocations freed so far.
+    itl::size_t droppedSamples; ///< Samples lost because the ring stayed full.
+    itl::size_t untrackedSamples; ///< Samples that found no room in the live table.
+} ProfilerTables;
+
+/**
+ * @brief Tables of the profiler, published once they are constructed.
+ */
+static ProfilerTables* internalTables = nullptr;
+
+/**
+ * @brief Guards the creation of the tables and the sites.
+ */
+static itl::thread::Mutex internalProfilerLock = MUTEX_INITIALIZER;
+
+/**
+ * @brief Follows the frame pointer chain of the calling thread.
+ *
+ * Each frame starts with the frame pointer of its caller, followed by the
+ * return address into it. The walk stops at the zeroed frame pointer of
+ * the outermost frame, or as soon as the next frame is not a little
+ * further up the stack, so a frame built without a frame pointer ends the
+ * stack instead of sending the walk into arbitrary memory.
+ *
+ * @param frames Receives the return addresses, innermost first.
+ * @param skip The number of innermost return addresses to leave out.
+ * @return The number of return addresses stored.
+ */
+__attribute__((noinline)) static itl::size_t __internal_captureStack(void** frames, itl::size_t skip)
+{
+    void** frame = (void**)__builtin_frame_address(0);
+    itl::size_t depth = 0;
+
+    while (frame != nullptr && depth < PROFILE_MAX_FRAMES) {
+        void** next = (void**)frame[0];
+        void* returnAddress = frame[1];
+
+        if (returnAddress == nullptr)
+            break;
+
+        if (skip > 0)
+            --skip;
+        else
+            frames[depth++] = returnAddress;
+
+        if (next <= frame || (itl::uintptr_t)next - (itl::uintptr_t)frame > PROFILE_MAX_FRAME_SIZE
+            || ((itl::uintptr_t)next & (sizeof(void*) - 1)) != 0)
+            break;
+
+        frame = next;
+    }
+
+    return depth;
+}
+
+/**
+ * @brief Hashes return addresses with FNV-1a, never returning 0.
+ */
+static itl::uint64_t __internal_hashStack(void* const* frames, itl::size_t depth)
+{
+    itl::uint64_t hash = 0xcbf29ce484222325ULL;
+
+    for (itl::size_t index = 0; index < depth; ++index) {
+        hash ^= (itl::uint64_t)(itl::uintptr_t)frames[index];
+        hash *= 0x100000001b3ULL;
+    }
+
+    hash ^= hash >> 29;
+
+    return hash == 0 ? 1 : hash;
+}
+
+/**
+ * @brief Returns the first live table slot probed for an address.
+ */
+static inline itl::size_t __internal_liveSlot(itl::uintptr_t address)
+{
+    return (itl::size_t)(((itl::uint64_t)(address >> 4) * 0x9e3779b97f4a7c15ULL) >> 32) & (PROFILE_LIVE_CAPACITY - 1);
+}
+
+/**
+ * @brief Records a sampled allocation in the live table.
+ *
+ * A slot is claimed by swapping its address from the empty or deleted
+ * marker, and only the PROFILE_MAX_PROBES slots after the first one are
+ * tried, so a lookup never searches further than that either.
+ *
+ * @return The claimed slot, or nullptr if all of them were taken.
+ */
+static itl::profiler::LiveSample* __internal_trackLive(ProfilerTables* tables, itl::uintptr_t address,
+    itl::uint64_t stackHash, itl::size_t size, itl::size_t weight)
+{
+    itl::size_t first = __internal_liveSlot(address);
+
+    for (itl::size_t probe = 0; probe < PROFILE_MAX_PROBES; ++probe) {
+        itl::profiler::LiveSample* slot = &tables->live[(first + probe) & (PROFILE_LIVE_CAPACITY - 1)];
+        itl::uintptr_t current = __atomic_load_n(&slot->address, __ATOMIC_RELAXED);
+
+        if (current != LIVE_EMPTY && current != LIVE_DELETED)
+            continue;
+
+        if (!__atomic_compare_exchange_n(&slot->address, &current, address, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+            continue;
+
+        // The allocation is not handed out yet, so nobody looks the slot
+        // up before these are written.
+        slot->stackHash = stackHash;
+        slot->size = size;
+        slot->weight = weight;
+        __atomic_fetch_add(&itl::profiler::internalSampler.liveSamples, 1, __ATOMIC_RELAXED);
+
+        return slot;
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Finds the live table slot of a sampled allocation.
+ *
+ * @return The slot, or nullptr if the allocation was not sampled.
+ */
+static itl::profiler::LiveSample* __internal_findLive(ProfilerTables* tables, itl::uintptr_t address)
+{
+    itl::size_t first = __internal_liveSlot(address);
+
+    for (itl::size_t probe = 0; probe < PROFILE_MAX_PROBES; ++probe) {
+        itl::profiler::LiveSample* slot = &tables->live[(first + probe) & (PROFILE_LIVE_CAPACITY - 1)];
+        itl::uintptr_t current = __atomic_load_n(&slot->address, __ATOMIC_ACQUIRE);
+
+        if (current == address)
+            return slot;
+
+        if (current == LIVE_EMPTY)
+            return nullptr;
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Releases a slot of the live table.
+ */
+static void __internal_untrackLive(itl::profiler::LiveSample* slot)
+{
+    __atomic_store_n(&slot->address, (itl::uintptr_t)LIVE_DELETED, __ATOMIC_RELEASE);
+    __atomic_fetch_sub(&itl::profiler::internalSampler.liveSamples, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Returns the site of a call stack, creating it for an allocation.
+ * The profiler lock must be held.
+ *
+ * Stacks that find the table full share the overflow site.
+ */
+static itl::profiler::ProfileSite* __internal_findSite(ProfilerTables* tables, const itl::profiler::ProfileSample* sample)
+{
+    itl::size_t first = (itl::size_t)sample->stackHash;
+
+    for (itl::size_t probe = 0; probe < PROFILE_SITE_CAPACITY; ++probe) {
+        itl::profiler::ProfileSite* site = &tables->sites[(first + probe) & (PROFILE_SITE_CAPACITY - 1)];
+
+        if (site->stackHash == sample->stackHash)
+            return site;
+
+        if (site->stackHash != 0)
+            continue;
+
+        // Keep one slot empty so searches for unknown stacks terminate.
+        if (sample->kind != itl::profiler::SAMPLE_ALLOCATION || tables->siteCount + 1 >= PROFILE_SITE_CAPACITY)
+            break;
+
+        site->stackHash = sample->stackHash;
+        site->depth = sample->depth;
+        itl::simd::copy(site->frames, sample->frames, sample->depth * sizeof(void*));
+        tables->siteCount++;
+
+        return site;
+    }
+
+    return &tables->overflow;
+}
+
+/**
+ * @brief Adds a sample to the totals of its site. The profiler lock must
+ * be held.
+ */
+static void __internal_foldSample(ProfilerTables* tables, const itl::profiler::ProfileSample* sample)
+{
+    itl::profiler::ProfileSite* site = __internal_findSite(tables, sample);
+    itl::size_t objects = sample->weight / sample->size;
+
+    if (objects == 0)
+        objects = 1;
+
+    if (sample->kind == itl::profiler::SAMPLE_FREE) {
+        site->liveObjects -= site->liveObjects < objects ? site->liveObjects : objects;
+        site->liveBytes -= site->liveBytes < sample->weight ? site->liveBytes : sample->weight;
+        tables->frees++;
+        return;
+    }
+
+    site->allocatedObjects += objects;
+    site->allocatedBytes += sample->weight;
+
+    if (sample->tracked) {
+        site->liveObjects += objects;
+        site->liveBytes += sample->weight;
+    }
+}
+
+/**
+ * @brief Folds every sample of the ring into the sites. The profiler lock
+ * must be held.
+ */
+static void __internal_drainLocked(ProfilerTables* tables)
+{
+    itl::profiler::ProfileSample sample;
+
+    while (tables->ring.pop(&sample))
+        __internal_foldSample(tables, &sample);
+}
+
+/**
+ * @brief Pushes a sample into the ring.
+ *
+ * A full ring is drained by the calling thread before it tries again.
+ * An allocation sample is dropped if other threads refilled the ring in
+ * between, but the release of a tracked allocation is retried until it
+ * fits, since losing it would leave its bytes live forever.
+ *
+ * @return false if the sample was dropped.
+ */
+static bool __internal_pushSample(ProfilerTables* tables, const itl::profiler::ProfileSample* sample)
+{
+    if (__builtin_expect(tables->ring.push(*sample), 1))
+        return true;
+
+    do {
+        itl::thread::lockMutex(&internalProfilerLock);
+        __internal_drainLocked(tables);
+        itl::thread::unlockMutex(&internalProfilerLock);
+
+        if (tables->ring.push(*sample))
+            return true;
+    } while (sample->kind == itl::profiler::SAMPLE_FREE);
+
+    __atomic_fetch_add(&tables->droppedSamples, 1, __ATOMIC_RELAXED);
+
+    return false;
+}
+
+/**
+ * @brief Returns the tables, or nullptr if profiling never started.
+ */
+static inline ProfilerTables* __internal_getTables()
+{
+    return __atomic_load_n(&internalTables, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Copies /proc/self/maps to a file descriptor with raw system
+ * calls, so a profile can be symbolized after the process is gone.
+ */
+static void __internal_copyMaps(int fileDescriptor)
+{
+    int maps = itl::linux::syscall::openat(AT_FDCWD, "/proc/self/maps", O_RDONLY | O_CLOEXEC, 0);
+
+    if (maps < 0)
+        return;
+
+    char buffer[MAPS_BUFFER_SIZE];
+    itl::ssize_t count;
+
+    while ((count = itl::linux::syscall::read(maps, buffer, MAPS_BUFFER_SIZE)) > 0) {
+        itl::ssize_t written = 0;
+
+        while (written < count) {
+            itl::ssize_t result = itl::linux::syscall::write(fileDescriptor, buffer + written, (itl::size_t)(count - written));
+
+            if (result <= 0)
+                break;
+
+            written += result;
+        }
+
+        if (written < count)
+            break;
+    }
+
+    itl::linux::syscall::close(maps);
+}
+
+/**
+ * @brief Prints the totals of a site as one line of a heap profile.
+ */
+static void __internal_writeSite(itl::io::Writer* writer, const itl::profiler::ProfileSite* site)
+{
+    itl::io::printTo(writer, "{6}: {8} [{6}: {8}] @", site->liveObjects, site->liveBytes, site->allocatedObjects,
+        site->allocatedBytes);
+
+    for (itl::size_t index = 0; index < site->depth; ++index)
+        itl::io::printTo(writer, " {}", (const void*)site->frames[index]);
+
+    itl::io::printlnTo(writer, "");
+}
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace profiler {
+    itl::profiler::SamplerState internalSampler = {
+        .interval = 0, ///< Sampling is off until startProfiling().
+        .liveSamples = 0
+    };
+
+    int startProfiling(itl::size_t interval)
+    {
+        itl::thread::lockMutex(&internalProfilerLock);
+
+        if (internalTables == nullptr) {
+            void* pages = itl::allocPages(sizeof(ProfilerTables));
+
+            if (pages == nullptr) {
+                itl::thread::unlockMutex(&internalProfilerLock);
+                return -ENOMEM;
+            }
+
+            // The pages come zeroed, which is the empty state of every table.
+            ProfilerTables* tables = new (pages) ProfilerTables;
+
+            if (!tables->ring.initialize(PROFILE_RING_CAPACITY, itl::queue::QUEUE_STORAGE_HUGE_PAGES)) {
+                itl::freePages(pages, sizeof(ProfilerTables));
+                itl::thread::unlockMutex(&internalProfilerLock);
+                return -ENOMEM;
+            }
+
+            __atomic_store_n(&internalTables, tables, __ATOMIC_RELEASE);
+        }
+
+        __atomic_store_n(&internalSampler.interval, interval == 0 ? PROFILE_DEFAULT_INTERVAL : interval, __ATOMIC_RELEASE);
+        itl::thread::unlockMutex(&internalProfilerLock);
+
+        return 0;
+    }
+
+    void stopProfiling()
+    {
+        __atomic_store_n(&internalSampler.interval, 0, __ATOMIC_RELAXED);
+    }
+
+    void recordAllocation(void* pointerToMemory, itl::size_t size, itl::size_t weight)
+    {
+        ProfilerTables* tables = __internal_getTables();
+
+        if (tables == nullptr)
+            return;
+
+        ProfileSample sample;
+
+        // Leave out the return addresses into this function and into the
+        // allocator entry point, so the stack starts at its caller.
+        sample.kind = SAMPLE_ALLOCATION;
+        sample.size = size;
+        sample.weight = weight;
+        sample.depth = __internal_captureStack(sample.frames, 2);
+        sample.stackHash = __internal_hashStack(sample.frames, sample.depth);
+
+        itl::profiler::LiveSample* slot = __internal_trackLive(tables, (itl::uintptr_t)pointerToMemory, sample.stackHash,
+            size, weight);
+
+        sample.tracked = slot != nullptr;
+
+        if (!__internal_pushSample(tables, &sample)) {
+            if (slot != nullptr)
+                __internal_untrackLive(slot);
+
+            return;
+        }
+
+        __atomic_fetch_add(&tables->samples, 1, __ATOMIC_RELAXED);
+
+        if (slot == nullptr)
+            __atomic_fetch_add(&tables->untrackedSamples, 1, __ATOMIC_RELAXED);
+    }
+
+    void recordFree(void* pointerToMemory)
+    {
+        ProfilerTables* tables = __internal_getTables();
+
+        if (tables == nullptr)
+            return;
+
+        itl::profiler::LiveSample* slot = __internal_findLive(tables, (itl::uintptr_t)pointerToMemory);
+
+        if (slot == nullptr)
+            return;
+
+        ProfileSample sample;
+
+        sample.kind = SAMPLE_FREE;
+        sample.stackHash = slot->stackHash;
+        sample.size = slot->size;
+        sample.weight = slot->weight;
+        sample.depth = 0;
+        sample.tracked = true;
+
+        __internal_untrackLive(slot);
+        __internal_pushSample(tables, &sample);
+    }
+
+    void recordMove(void* oldPointer, void* newPointer)
+    {
+        ProfilerTables* tables = __internal_getTables();
+
+        if (tables == nullptr)
+            return;
+
+        itl::profiler::LiveSample* slot = __internal_findLive(tables, (itl::uintptr_t)oldPointer);
+
+        if (slot == nullptr)
+            return;
+
+        itl::profiler::LiveSample moved = *slot;
+
+        __internal_untrackLive(slot);
+
+        if (__internal_trackLive(tables, (itl::uintptr_t)newPointer, moved.stackHash, moved.size, moved.weight) != nullptr)
+            return;
+
+        // No room at the new address: report the allocation as freed so
+        // its site does not keep it live forever.
+        ProfileSample sample;
+
+        sample.kind = SAMPLE_FREE;
+        sample.stackHash = moved.stackHash;
+        sample.size = moved.size;
+        sample.weight = moved.weight;
+        sample.depth = 0;
+        sample.tracked = true;
+
+        __internal_pushSample(tables, &sample);
+    }
+
+    int writeHeapProfile(int fileDescriptor)
+    {
+        ProfilerTables* tables = __internal_getTables();
+
+        if (tables == nullptr)
+            return -EINVAL;
+
+        itl::io::Writer writer;
+        itl::profiler::ProfileSite total = {};
+
+        itl::io::initializeWriter(&writer, fileDescriptor, IO_BUFFER_SIZE / 2);
+        itl::thread::lockMutex(&internalProfilerLock);
+        __internal_drainLocked(tables);
+
+        for (itl::size_t index = 0; index <= PROFILE_SITE_CAPACITY; ++index) {
+            const itl::profiler::ProfileSite* site = index < PROFILE_SITE_CAPACITY ? &tables->sites[index] : &tables->overflow;
+
+            total.liveObjects += site->liveObjects;
+            total.liveBytes += site->liveBytes;
+            total.allocatedObjects += site->allocatedObjects;
+            total.allocatedBytes += site->allocatedBytes;
+        }
+
+        // The totals are already scaled by the sampling interval, so the
+        // header names no sampling rate for pprof to apply again.
+        itl::io::printlnTo(&writer, "heap profile: {6}: {8} [{6}: {8}] @ heap", total.liveObjects, total.liveBytes,
+            total.allocatedObjects, total.allocatedBytes);
+
+        for (itl::size_t index = 0; index < PROFILE_SITE_CAPACITY; ++index) {
+            if (tables->sites[index].stackHash != 0)
+                __internal_writeSite(&writer, &tables->sites[index]);
+        }
+
+        if (tables->overflow.allocatedBytes != 0)
+            __internal_writeSite(&writer, &tables->overflow);
+
+        itl::thread::unlockMutex(&internalProfilerLock);
+
+        itl::io::printlnTo(&writer, "\nMAPPED_LIBRARIES:");
+        itl::io::flush(&writer);
+        __internal_copyMaps(fileDescriptor);
+
+        return 0;
+    }
+
+    int dumpHeapProfile(const char* path)
+    {
+        if (__internal_getTables() == nullptr)
+            return -EINVAL;
+
+        int fileDescriptor = itl::linux::syscall::openat(AT_FDCWD, path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+        if (fileDescriptor < 0)
+            return fileDescriptor;
+
+        int result = writeHeapProfile(fileDescriptor);
+
+        itl::linux::syscall::close(fileDescriptor);
+
+        return result;
+    }
+
+    void getProfileStats(itl::profiler::ProfileStats* stats)
+    {
+        ProfilerTables* tables = __internal_getTables();
+
+        itl::simd::fill(stats, 0, sizeof(itl::profiler::ProfileStats));
+        stats->interval = __atomic_load_n(&internalSampler.interval, __ATOMIC_RELAXED);
+
+        if (tables == nullptr)
+            return;
+
+        itl::thread::lockMutex(&internalProfilerLock);
+        __internal_drainLocked(tables);
+
+        stats->frees = tables->frees;
+        stats->sites = tables->siteCount;
+
+        for (itl::size_t index = 0; index <= PROFILE_SITE_CAPACITY; ++index) {
+            const itl::profiler::ProfileSite* site = index < PROFILE_SITE_CAPACITY ? &tables->sites[index] : &tables->overflow;
+
+            stats->allocatedBytes += site->allocatedBytes;
+            stats->liveBytes += site->liveBytes;
+        }
+
+        itl::thread::unlockMutex(&internalProfilerLock);
+
+        stats->samples = __atomic_load_n(&tables->samples, __ATOMIC_RELAXED);
+        stats->droppedSamples = __atomic_load_n(&tables->droppedSamples, __ATOMIC_RELAXED);
+        stats->untrackedSamples = __atomic_load_n(&tables->untrackedSamples, __ATOMIC_RELAXED);
+    }
+}; // namespace profiler
+} // namespace itl
\ No newline at end of file
@@ -0,0 +1,66 @@
+/**
+ * @file src/system/auxv.cpp
+ * @brief Implements access to the auxiliary vector of the process.
+ * @category System
+ *
+ * This file contains the implementation of the functions that locate the
+ * auxiliary vector on the initial stack and read its entries.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#include "system/auxv.hpp"
+#include "system/mmacros.hpp"
+#include "typing/ctypes.hpp"
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace linux {
+    namespace auxv {
+        /**
+         * @brief Auxiliary vector of the process, as pairs of type and value.
+         */
+        static unsigned long* internalAuxiliaryVector = nullptr;
+
+        /**
+         * @brief Page size of the system, read once from AT_PAGESZ.
+         */
+        static itl::size_t internalPageSize = PAGE_SIZE;
+
+        void initialize(itl::strvec environment)
+        {
+            while (*environment != nullptr)
+                ++environment;
+
+            internalAuxiliaryVector = (unsigned long*)(environment + 1);
+
+            itl::size_t pageSize = getValue(AT_PAGESZ);
+
+            if (pageSize != 0 && (pageSize & (pageSize - 1)) == 0)
+                internalPageSize = pageSize;
+        }
+
+        unsigned long getValue(unsigned long type)
+        {
+            if (internalAuxiliaryVector == nullptr)
+                return 0;
+
+            for (unsigned long* entry = internalAuxiliaryVector; entry[0] != AT_NULL; entry += 2) {
+                if (entry[0] == type)
+                    return entry[1];
+            }
+
+            return 0;
+        }
+
+        itl::size_t getPageSize()
+        {
+            return internalPageSize;
+        }
+    }; // namespace auxv
+}; // namespace linux
+} // namespace itl
@@ -0,0 +1,1113 @@
+/**
+ * @file src/system/simd.cpp
+ * @brief Implements the vectorized kernels of the ITL library.
+ * @category System
+ *
+ * This file contains the processor probe, the vector traits of every
+ * instruction set, the kernels written once over those traits and the
+ * dispatch table the public functions jump through. Each kernel falls
+ * back on the traits of the next narrower set for the bytes that do not
+ * fill a whole vector, down to 64-bit words and single bytes.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#include "system/simd.hpp"
+#include "typing/ctypes.hpp"
+
+// The kernels below are what memcpy and memset resolve to, so the
+// compiler must not turn their loops back into calls to them.
+#pragma GCC optimize("no-tree-loop-distribute-patterns")
+
+// The generic kernels pass wide vectors between traits functions, but are
+// only ever flattened into wrappers compiled for the matching instruction
+// set, so the ABI those vectors would have across a call never applies.
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+#define CPUID_FEATURES 1 ///< CPUID leaf reporting the basic features.
+#define CPUID_EXTENDED_FEATURES 7 ///< CPUID leaf reporting the extended features.
+#define CPUID_SSE2 (1U << 26) ///< SSE2 bit of the EDX register of leaf 1.
+#define CPUID_FMA (1U << 12) ///< FMA bit of the ECX register of leaf 1.
+#define CPUID_OSXSAVE (1U << 27) ///< XGETBV availability bit of the ECX register of leaf 1.
+#define CPUID_AVX (1U << 28) ///< AVX bit of the ECX register of leaf 1.
+#define CPUID_AVX2 (1U << 5) ///< AVX2 bit of the EBX register of leaf 7.
+#define CPUID_ERMS (1U << 9) ///< Enhanced rep movsb bit of the EBX register of leaf 7.
+#define CPUID_AVX512F (1U << 16) ///< AVX-512 foundation bit of the EBX register of leaf 7.
+#define CPUID_AVX512BW (1U << 30) ///< AVX-512 byte and word bit of the EBX register of leaf 7.
+#define XCR0_AVX_STATE 0x06 ///< SSE and YMM state enabled by the kernel.
+#define XCR0_AVX512_STATE 0xE6 ///< SSE, YMM, mask and ZMM state enabled by the kernel.
+
+#define SIMD_FEATURES_PROBED 0x80000000U ///< Set in the cached features once the processor was probed.
+#define SIMD_COUNT_ROUNDS 255 ///< Vectors counted in byte lanes before the lanes could overflow.
+
+#define SWAR_LOW_BITS 0x7F7F7F7F7F7F7F7FULL ///< Every bit but the highest of each byte.
+#define SWAR_HIGH_BITS 0x8080808080808080ULL ///< The highest bit of each byte.
+#define SWAR_ONES 0x0101010101010101ULL ///< The lowest bit of each byte.
+#define SWAR_EVEN_BYTES 0x00FF00FF00FF00FFULL ///< The even bytes of a word.
+#define SWAR_HALFWORD_ONES 0x0001000100010001ULL ///< The lowest bit of each 16-bit lane.
+
+typedef itl::uint16_t UnalignedHalf __attribute__((may_alias, aligned(1)));
+typedef itl::uint32_t UnalignedWord __attribute__((may_alias, aligned(1)));
+typedef itl::uint64_t UnalignedDouble __attribute__((may_alias, aligned(1)));
+typedef itl::uint64_t AlignedDouble __attribute__((may_alias));
+
+static itl::uint32_t internalFeatures = 0;
+static bool internalInitialized = false;
+static itl::simd::SimdLevel internalLevel = itl::simd::SIMD_LEVEL_SCALAR;
+
+/**
+ * @brief Returns the index of the lowest set bit of a nonzero mask.
+ */
+static inline itl::size_t __internal_lowestBit(itl::uint32_t mask)
+{
+    return __builtin_ctz(mask);
+}
+
+/**
+ * @brief Returns the index of the lowest set bit of a nonzero mask.
+ *
+ * 32-bit builds test the halves separately, since the 64-bit version
+ * would call into libgcc, which the ITL does not link.
+ */
+static inline itl::size_t __internal_lowestBit(itl::uint64_t mask)
+{
+#ifdef __x86_64__
+    return __builtin_ctzll(mask);
+#elif __i386__
+    itl::uint32_t low = (itl::uint32_t)mask;
+
+    return low != 0 ? __builtin_ctz(low) : 32 + __builtin_ctz((itl::uint32_t)(mask >> 32));
+#endif // #ifdef __x86_64__
+}
+
+/**
+ * @struct ScalarTraits
+ * @brief Treats 64-bit words as vectors of 8 bytes.
+ *
+ * Byte matches are reported in the highest bit of each byte, found
+ * without the carries between bytes that the shorter zero-byte test lets
+ * through, so every set bit is a true match.
+ */
+struct ScalarTraits {
+    static constexpr itl::size_t WIDTH = 8; ///< Bytes in a vector.
+    static constexpr itl::size_t FLOAT_LANES = 1; ///< Floats in a vector.
+    static constexpr unsigned MASK_SHIFT = 3; ///< Mask bits per byte, as a shift.
+
+    typedef itl::uint64_t Vector;
+    typedef itl::uint64_t Mask;
+    typedef itl::uint64_t Sums;
+    typedef float Floats;
+
+    static inline Vector load(const void* address) { return *(const UnalignedDouble*)address; }
+    static inline Vector loadAligned(const void* address) { return *(const AlignedDouble*)address; }
+    static inline void store(void* address, Vector value) { *(UnalignedDouble*)address = value; }
+    static inline void storeAligned(void* address, Vector value) { *(AlignedDouble*)address = value; }
+    static inline Vector splat(int value) { return (itl::uint64_t)(unsigned char)value * SWAR_ONES; }
+
+    static inline Mask equal(Vector first, Vector second)
+    {
+        Vector difference = first ^ second;
+
+        return ~(((difference & SWAR_LOW_BITS) + SWAR_LOW_BITS) | difference | SWAR_LOW_BITS);
+    }
+
+    static inline Mask differ(Vector first, Vector second)
+    {
+        Vector difference = first ^ second;
+
+        return (((difference & SWAR_LOW_BITS) + SWAR_LOW_BITS) | difference) & SWAR_HIGH_BITS;
+    }
+
+    static inline Vector ones(Vector first, Vector second) { return equal(first, second) >> 7; }
+
+    static inline Sums sad(Vector value)
+    {
+        Vector pairs = (value & SWAR_EVEN_BYTES) + ((value >> 8) & SWAR_EVEN_BYTES);
+
+        return (pairs * SWAR_HALFWORD_ONES) >> 48;
+    }
+
+    static inline itl::uint64_t reduce(Sums sums) { return sums; }
+    static inline Floats loadFloats(const float* address) { return *address; }
+    static inline Floats multiplyAdd(Floats first, Floats second, Floats addend) { return first * second + addend; }
+    static inline float reduceFloats(Floats value) { return value; }
+};
+
+#pragma GCC push_options
+#pragma GCC target("sse2")
+typedef char Sse2Vector __attribute__((vector_size(16)));
+typedef char Sse2Unaligned __attribute__((vector_size(16), may_alias, aligned(1)));
+typedef char Sse2Aligned __attribute__((vector_size(16), may_alias));
+typedef long long Sse2Sums __attribute__((vector_size(16)));
+typedef float Sse2Floats __attribute__((vector_size(16)));
+typedef float Sse2UnalignedFloats __attribute__((vector_size(16), may_alias, aligned(4)));
+
+/**
+ * @struct Sse2Traits
+ * @brief Treats XMM registers as vectors of 16 bytes.
+ */
+struct Sse2Traits {
+    static constexpr itl::size_t WIDTH = 16; ///< Bytes in a vector.
+    static constexpr itl::size_t FLOAT_LANES = 4; ///< Floats in a vector.
+    static constexpr unsigned MASK_SHIFT = 0; ///< Mask bits per byte, as a shift.
+
+    typedef Sse2Vector Vector;
+    typedef itl::uint32_t Mask;
+    typedef Sse2Sums Sums;
+    typedef Sse2Floats Floats;
+    typedef ScalarTraits Narrow;
+
+    static inline Vector load(const void* address) { return *(const Sse2Unaligned*)address; }
+    static inline Vector loadAligned(const void* address) { return *(const Sse2Aligned*)address; }
+    static inline void store(void* address, Vector value) { *(Sse2Unaligned*)address = value; }
+    static inline void storeAligned(void* address, Vector value) { *(Sse2Aligned*)address = value; }
+    static inline Vector splat(int value) { return (Vector) {} + (char)value; }
+    static inline Mask equal(Vector first, Vector second) { return (Mask)__builtin_ia32_pmovmskb128((Vector)(first == second)); }
+    static inline Mask differ(Vector first, Vector second) { return equal(first, second) ^ 0xFFFFU; }
+    static inline Vector ones(Vector first, Vector second) { return (Vector) {} - (Vector)(first == second); }
+    static inline Sums sad(Vector value) { return (Sums)__builtin_ia32_psadbw128(value, (Vector) {}); }
+    static inline itl::uint64_t reduce(Sums sums) { return sums[0] + sums[1]; }
+    static inline Floats loadFloats(const float* address) { return *(const Sse2UnalignedFloats*)address; }
+    static inline Floats multiplyAdd(Floats first, Floats second, Floats addend) { return first * second + addend; }
+    static inline float reduceFloats(Floats value) { return (value[0] + value[1]) + (value[2] + value[3]); }
+};
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+typedef char Avx2Vector __attribute__((vector_size(32)));
+typedef char Avx2Unaligned __attribute__((vector_size(32), may_alias, aligned(1)));
+typedef char Avx2Aligned __attribute__((vector_size(32), may_alias));
+typedef long long Avx2Sums __attribute__((vector_size(32)));
+typedef float Avx2Floats __attribute__((vector_size(32)));
+typedef float Avx2UnalignedFloats __attribute__((vector_size(32), may_alias, aligned(4)));
+
+/**
+ * @struct Avx2Traits
+ * @brief Treats YMM registers as vectors of 32 bytes.
+ */
+struct Avx2Traits {
+    static constexpr itl::size_t WIDTH = 32; ///< Bytes in a vector.
+    static constexpr itl::size_t FLOAT_LANES = 8; ///< Floats in a vector.
+    static constexpr unsigned MASK_SHIFT = 0; ///< Mask bits per byte, as a shift.
+
+    typedef Avx2Vector Vector;
+    typedef itl::uint32_t Mask;
+    typedef Avx2Sums Sums;
+    typedef Avx2Floats Floats;
+    typedef Sse2Traits Narrow;
+
+    static inline Vector load(const void* address) { return *(const Avx2Unaligned*)address; }
+    static inline Vector loadAligned(const void* address) { return *(const Avx2Aligned*)address; }
+    static inline void store(void* address, Vector value) { *(Avx2Unaligned*)address = value; }
+    static inline void storeAligned(void* address, Vector value) { *(Avx2Aligned*)address = value; }
+    static inline Vector splat(int value) { return (Vector) {} + (char)value; }
+    static inline Mask equal(Vector first, Vector second) { return (Mask)__builtin_ia32_pmovmskb256((Vector)(first == second)); }
+    static inline Mask differ(Vector first, Vector second) { return ~equal(first, second); }
+    static inline Vector ones(Vector first, Vector second) { return (Vector) {} - (Vector)(first == second); }
+    static inline Sums sad(Vector value) { return (Sums)__builtin_ia32_psadbw256(value, (Vector) {}); }
+    static inline itl::uint64_t reduce(Sums sums) { return (sums[0] + sums[1]) + (sums[2] + sums[3]); }
+    static inline Floats loadFloats(const float* address) { return *(const Avx2UnalignedFloats*)address; }
+    static inline Floats multiplyAdd(Floats first, Floats second, Floats addend) { return __builtin_ia32_vfmaddps256(first, second, addend); }
+
+    static inline float reduceFloats(Floats value)
+    {
+        return ((value[0] + value[4]) + (value[1] + value[5])) + ((value[2] + value[6]) + (value[3] + value[7]));
+    }
+};
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512bw,avx2,fma")
+typedef char Avx512Vector __attribute__((vector_size(64)));
+typedef char Avx512Unaligned __attribute__((vector_size(64), may_alias, aligned(1)));
+typedef char Avx512Aligned __attribute__((vector_size(64), may_alias));
+typedef long long Avx512Sums __attribute__((vector_size(64)));
+typedef float Avx512Floats __attribute__((vector_size(64)));
+typedef float Avx512UnalignedFloats __attribute__((vector_size(64), may_alias, aligned(4)));
+
+/**
+ * @struct Avx512Traits
+ * @brief Treats ZMM registers as vectors of 64 bytes, compared into mask
+ * registers.
+ */
+struct Avx512Traits {
+    static constexpr itl::size_t WIDTH = 64; ///< Bytes in a vector.
+    static constexpr itl::size_t FLOAT_LANES = 16; ///< Floats in a vector.
+    static constexpr unsigned MASK_SHIFT = 0; ///< Mask bits per byte, as a shift.
+
+    typedef Avx512Vector Vector;
+    typedef itl::uint64_t Mask;
+    typedef Avx512Sums Sums;
+    typedef Avx512Floats Floats;
+    typedef Avx2Traits Narrow;
+
+    static inline Vector load(const void* address) { return *(const Avx512Unaligned*)address; }
+    static inline Vector loadAligned(const void* address) { return *(const Avx512Aligned*)address; }
+    static inline void store(void* address, Vector value) { *(Avx512Unaligned*)address = value; }
+    static inline void storeAligned(void* address, Vector value) { *(Avx512Aligned*)address = value; }
+    static inline Vector splat(int value) { return (Vector) {} + (char)value; }
+    static inline Mask equal(Vector first, Vector second) { return __builtin_ia32_pcmpeqb512_mask(first, second, (Mask)-1); }
+    static inline Mask differ(Vector first, Vector second) { return ~equal(first, second); }
+    static inline Vector ones(Vector first, Vector second) { return (Vector) {} - (Vector)(first == second); }
+    static inline Sums sad(Vector value) { return (Sums)__builtin_ia32_psadbw512(value, (Vector) {}); }
+
+    static inline itl::uint64_t reduce(Sums sums)
+    {
+        return ((sums[0] + sums[1]) + (sums[2] + sums[3])) + ((sums[4] + sums[5]) + (sums[6] + sums[7]));
+    }
+
+    static inline Floats loadFloats(const float* address) { return *(const Avx512UnalignedFloats*)address; }
+    static inline Floats multiplyAdd(Floats first, Floats second, Floats addend) { return __builtin_ia32_vfmaddps512_mask(first, second, addend, (itl::uint16_t)-1, 4); }
+
+    static inline float reduceFloats(Floats value)
+    {
+        float sum = 0;
+
+        for (itl::size_t lane = 0; lane < FLOAT_LANES / 2; ++lane)
+            sum += value[lane] + value[lane + FLOAT_LANES / 2];
+
+        return sum;
+    }
+};
+#pragma GCC pop_options
+
+/**
+ * @brief Returns the offset of the first byte flagged in a nonzero mask.
+ */
+template <typename Traits>
+static inline itl::size_t __internal_maskIndex(typename Traits::Mask mask)
+{
+    return __internal_lowestBit(mask) >> Traits::MASK_SHIFT;
+}
+
+/**
+ * @brief Copies fewer than 8 bytes, loading them all before storing.
+ */
+static inline void __internal_copyTiny(unsigned char* to, const unsigned char* from, itl::size_t size)
+{
+    if (size >= 4) {
+        itl::uint32_t head = *(const UnalignedWord*)from;
+        itl::uint32_t tail = *(const UnalignedWord*)(from + size - 4);
+
+        *(UnalignedWord*)to = head;
+        *(UnalignedWord*)(to + size - 4) = tail;
+    } else if (size >= 2) {
+        itl::uint16_t head = *(const UnalignedHalf*)from;
+        itl::uint16_t tail = *(const UnalignedHalf*)(from + size - 2);
+
+        *(UnalignedHalf*)to = head;
+        *(UnalignedHalf*)(to + size - 2) = tail;
+    } else if (size == 1) {
+        *to = *from;
+    }
+}
+
+/**
+ * @brief Copies possibly overlapping bytes.
+ *
+ * The first and last vectors are loaded before anything is stored, and
+ * the middle is walked away from the overlap with aligned stores, so the
+ * unaligned ends never have to be split.
+ */
+template <typename Traits>
+static inline void* __internal_copy(void* destination, const void* source, itl::size_t size)
+{
+    constexpr itl::size_t width = Traits::WIDTH;
+    unsigned char* to = (unsigned char*)destination;
+    const unsigned char* from = (const unsigned char*)source;
+
+    if (size < width) {
+        if constexpr (width > 8)
+            return __internal_copy<typename Traits::Narrow>(destination, source, size);
+
+        __internal_copyTiny(to, from, size);
+        return destination;
+    }
+
+    typename Traits::Vector head = Traits::load(from);
+    typename Traits::Vector tail = Traits::load(from + size - width);
+
+    if (size <= 2 * width) {
+        Traits::store(to, head);
+        Traits::store(to + size - width, tail);
+        return destination;
+    }
+
+    itl::uintptr_t distance = (itl::uintptr_t)to - (itl::uintptr_t)from;
+
+    if (size >= SIMD_REP_MOVSB_THRESHOLD && (internalFeatures & SIMD_FEATURE_ERMS) != 0
+        && distance >= size && (itl::uintptr_t)from - (itl::uintptr_t)to >= size) {
+        __asm__ volatile("rep movsb"
+                         : "+D"(to), "+S"(from), "+c"(size)
+                         :
+                         : "memory");
+        return destination;
+    }
+
+    if (distance >= size) {
+        itl::size_t skip = width - ((itl::uintptr_t)to & (width - 1));
+        unsigned char* end = to + size - width;
+        unsigned char* at = to + skip;
+        const unsigned char* read = from + skip;
+
+        for (; at + 4 * width <= end; at += 4 * width, read += 4 * width) {
+            typename Traits::Vector first = Traits::load(read);
+            typename Traits::Vector second = Traits::load(read + width);
+            typename Traits::Vector third = Traits::load(read + 2 * width);
+            typename Traits::Vector fourth = Traits::load(read + 3 * width);
+
+            Traits::storeAligned(at, first);
+            Traits::storeAligned(at + width, second);
+            Traits::storeAligned(at + 2 * width, third);
+            Traits::storeAligned(at + 3 * width, fourth);
+        }
+
+        for (; at < end; at += width, read += width)
+            Traits::storeAligned(at, Traits::load(read));
+    } else {
+        unsigned char* at = (unsigned char*)((itl::uintptr_t)(to + size) & ~(itl::uintptr_t)(width - 1));
+        const unsigned char* read = from + (at - to);
+
+        while (at > to + width) {
+            at -= width;
+            read -= width;
+            Traits::storeAligned(at, Traits::load(read));
+        }
+    }
+
+    Traits::store(to, head);
+    Traits::store(to + size - width, tail);
+
+    return destination;
+}
+
+/**
+ * @brief Sets every byte of a region to a value.
+ */
+template <typename Traits>
+static inline void* __internal_fill(void* destination, int value, itl::size_t size)
+{
+    constexpr itl::size_t width = Traits::WIDTH;
+    unsigned char* to = (unsigned char*)destination;
+
+    if (size < width) {
+        if constexpr (width > 8)
+            return __internal_fill<typename Traits::Narrow>(destination, value, size);
+
+        itl::uint64_t pattern = ScalarTraits::splat(value);
+
+        if (size >= 4) {
+            *(UnalignedWord*)to = (itl::uint32_t)pattern;
+            *(UnalignedWord*)(to + size - 4) = (itl::uint32_t)pattern;
+        } else if (size >= 2) {
+            *(UnalignedHalf*)to = (itl::uint16_t)pattern;
+            *(UnalignedHalf*)(to + size - 2) = (itl::uint16_t)pattern;
+        } else if (size == 1) {
+            *to = (unsigned char)value;
+        }
+
+        return destination;
+    }
+
+    typename Traits::Vector pattern = Traits::splat(value);
+    unsigned char* end = to + size - width;
+
+    Traits::store(to, pattern);
+    Traits::store(end, pattern);
+
+    if (size <= 2 * width)
+        return destination;
+
+    unsigned char* at = to + (width - ((itl::uintptr_t)to & (width - 1)));
+
+    for (; at + 4 * width <= end; at += 4 * width) {
+        Traits::storeAligned(at, pattern);
+        Traits::storeAligned(at + width, pattern);
+        Traits::storeAligned(at + 2 * width, pattern);
+        Traits::storeAligned(at + 3 * width, pattern);
+    }
+
+    for (; at < end; at += width)
+        Traits::storeAligned(at, pattern);
+
+    return destination;
+}
+
+/**
+ * @brief Compares two regions as unsigned bytes.
+ */
+template <typename Traits>
+static inline int __internal_compare(const void* first, const void* second, itl::size_t size)
+{
+    constexpr itl::size_t width = Traits::WIDTH;
+    const unsigned char* left = (const unsigned char*)first;
+    const unsigned char* right = (const unsigned char*)second;
+
+    if (size < width) {
+        if constexpr (width > 8)
+            return __internal_compare<typename Traits::Narrow>(first, second, size);
+
+        for (itl::size_t index = 0; index < size; ++index)
+            if (left[index] != right[index])
+                return (int)left[index] - (int)right[index];
+
+        return 0;
+    }
+
+    itl::size_t offset = 0;
+
+    for (;;) {
+        typename Traits::Mask mask = Traits::differ(Traits::load(left + offset), Traits::load(right + offset));
+
+        if (mask != 0) {
+            offset += __internal_maskIndex<Traits>(mask);
+            return (int)left[offset] - (int)right[offset];
+        }
+
+        if (offset + width == size)
+            return 0;
+
+        // The last vector overlaps bytes already known to be equal.
+        offset = offset + 2 * width <= size ? offset + width : size - width;
+    }
+}
+
+/**
+ * @brief Finds the first occurrence of a byte in a region.
+ */
+template <typename Traits>
+static inline const void* __internal_findByte(const void* data, int value, itl::size_t size)
+{
+    constexpr itl::size_t width = Traits::WIDTH;
+    const unsigned char* bytes = (const unsigned char*)data;
+
+    if (size < width) {
+        if constexpr (width > 8)
+            return __internal_findByte<typename Traits::Narrow>(data, value, size);
+
+        for (itl::size_t index = 0; index < size; ++index)
+            if (bytes[index] == (unsigned char)value)
+                return bytes + index;
+
+        return nullptr;
+    }
+
+    typename Traits::Vector needle = Traits::splat(value);
+    itl::size_t offset = 0;
+
+    for (;;) {
+        typename Traits::Mask mask = Traits::equal(Traits::load(bytes + offset), needle);
+
+        if (mask != 0)
+            return bytes + offset + __internal_maskIndex<Traits>(mask);
+
+        if (offset + width == size)
+            return nullptr;
+
+        offset = offset + 2 * width <= size ? offset + width : size - width;
+    }
+}
+
+/**
+ * @brief Returns the length of a null-terminated string, reading whole
+ * aligned vectors.
+ */
+template <typename Traits>
+static inline itl::size_t __internal_stringLength(const char* string)
+{
+    constexpr itl::size_t width = Traits::WIDTH;
+    itl::uintptr_t start = (itl::uintptr_t)string;
+    const char* at = (const char*)(start & ~(itl::uintptr_t)(width - 1));
+    typename Traits::Vector zero = {};
+    typename Traits::Mask mask = Traits::equal(Traits::loadAligned(at), zero);
+
+    // Drop the bytes before the string in its first vector.
+    mask >>= (start - (itl::uintptr_t)at) << Traits::MASK_SHIFT;
+
+    if (mask != 0)
+        return __internal_maskIndex<Traits>(mask);
+
+    for (;;) {
+        at += width;
+        mask = Traits::equal(Traits::loadAligned(at), zero);
+
+        if (mask != 0)
+            return (itl::size_t)(at - string) + __internal_maskIndex<Traits>(mask);
+    }
+}
+
+/**
+ * @brief Finds the first occurrence of a byte sequence in a region.
+ */
+template <typename Traits>
+static inline const void* __internal_findBytes(const void* data, itl::size_t size, const void* pattern, itl::size_t patternSize)
+{
+    constexpr itl::size_t width = Traits::WIDTH;
+    const unsigned char* bytes = (const unsigned char*)data;
+    const unsigned char* needle = (const unsigned char*)pattern;
+
+    if (patternSize == 0)
+        return data;
+
+    if (patternSize > size)
+        return nullptr;
+
+    if (patternSize == 1)
+        return __internal_findByte<Traits>(data, needle[0], size);
+
+    itl::size_t last = patternSize - 1;
+    itl::size_t offset = 0;
+
+    if (size - last >= width) {
+        typename Traits::Vector first = Traits::splat(needle[0]);
+        typename Traits::Vector closing = Traits::splat(needle[last]);
+
+        for (; offset + last + width <= size; offset += width) {
+            typename Traits::Mask mask = Traits::equal(Traits::load(bytes + offset), first)
+                & Traits::equal(Traits::load(bytes + offset + last), closing);
+
+            while (mask != 0) {
+                itl::size_t candidate = offset + __internal_maskIndex<Traits>(mask);
+
+                if (__internal_compare<Traits>(bytes + candidate + 1, needle + 1, patternSize - 2) == 0)
+                    return bytes + candidate;
+
+                mask &= mask - 1;
+            }
+        }
+    }
+
+    if constexpr (width > 8) {
+        return __internal_findBytes<typename Traits::Narrow>(bytes + offset, size - offset, pattern, patternSize);
+    } else {
+        for (; offset + patternSize <= size; ++offset)
+            if (bytes[offset] == needle[0] && bytes[offset + last] == needle[last]
+                && __internal_compare<Traits>(bytes + offset + 1, needle + 1, patternSize - 2) == 0)
+                return bytes + offset;
+
+        return nullptr;
+    }
+}
+
+/**
+ * @brief Counts the occurrences of a byte in a region.
+ *
+ * Matches are added in byte lanes and folded into the total with a sum
+ * of absolute differences before any lane can wrap.
+ */
+template <typename Traits>
+static inline itl::size_t __internal_countByte(const void* data, int value, itl::size_t size)
+{
+    constexpr itl::size_t width = Traits::WIDTH;
+    const unsigned char* bytes = (const unsigned char*)data;
+    typename Traits::Vector needle = Traits::splat(value);
+    itl::size_t count = 0;
+    itl::size_t offset = 0;
+
+    while (size - offset >= width) {
+        typename Traits::Vector lanes = {};
+
+        for (unsigned round = 0; round < SIMD_COUNT_ROUNDS && size - offset >= width; ++round, offset += width)
+            lanes += Traits::ones(Traits::load(bytes + offset), needle);
+
+        count += (itl::size_t)Traits::reduce(Traits::sad(lanes));
+    }
+
+    if constexpr (width > 8) {
+        count += __internal_countByte<typename Traits::Narrow>(bytes + offset, value, size - offset);
+    } else {
+        for (; offset < size; ++offset)
+            count += bytes[offset] == (unsigned char)value;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Adds the bytes of a region as unsigned integers.
+ */
+template <typename Traits>
+static inline itl::uint64_t __internal_sumBytes(const void* data, itl::size_t size)
+{
+    constexpr itl::size_t width = Traits::WIDTH;
+    const unsigned char* bytes = (const unsigned char*)data;
+    typename Traits::Sums sums = {};
+    itl::size_t offset = 0;
+
+    for (; size - offset >= width; offset += width)
+        sums += Traits::sad(Traits::load(bytes + offset));
+
+    itl::uint64_t total = Traits::reduce(sums);
+
+    if constexpr (width > 8) {
+        total += __internal_sumBytes<typename Traits::Narrow>(bytes + offset, size - offset);
+    } else {
+        for (; offset < size; ++offset)
+            total += bytes[offset];
+    }
+
+    return total;
+}
+
+/**
+ * @brief Adds an array of floats in four independent accumulators.
+ */
+template <typename Traits>
+static inline float __internal_sumFloats(const float* values, itl::size_t count)
+{
+    constexpr itl::size_t lanes = Traits::FLOAT_LANES;
+    typename Traits::Floats first = {}, second = {}, third = {}, fourth = {};
+    itl::size_t index = 0;
+
+    for (; index + 4 * lanes <= count; index += 4 * lanes) {
+        first += Traits::loadFloats(values + index);
+        second += Traits::loadFloats(values + index + lanes);
+        third += Traits::loadFloats(values + index + 2 * lanes);
+        fourth += Traits::loadFloats(values + index + 3 * lanes);
+    }
+
+    for (; index + lanes <= count; index += lanes)
+        first += Traits::loadFloats(values + index);
+
+    float sum = Traits::reduceFloats((first + second) + (third + fourth));
+
+    if constexpr (lanes > 1)
+        sum += __internal_sumFloats<typename Traits::Narrow>(values + index, count - index);
+
+    return sum;
+}
+
+/**
+ * @brief Computes a dot product in four independent accumulators.
+ */
+template <typename Traits>
+static inline float __internal_dotFloats(const float* left, const float* right, itl::size_t count)
+{
+    constexpr itl::size_t lanes = Traits::FLOAT_LANES;
+    typename Traits::Floats first = {}, second = {}, third = {}, fourth = {};
+    itl::size_t index = 0;
+
+    for (; index + 4 * lanes <= count; index += 4 * lanes) {
+        first = Traits::multiplyAdd(Traits::loadFloats(left + index), Traits::loadFloats(right + index), first);
+        second = Traits::multiplyAdd(Traits::loadFloats(left + index + lanes), Traits::loadFloats(right + index + lanes), second);
+        third = Traits::multiplyAdd(Traits::loadFloats(left + index + 2 * lanes), Traits::loadFloats(right + index + 2 * lanes), third);
+        fourth = Traits::multiplyAdd(Traits::loadFloats(left + index + 3 * lanes), Traits::loadFloats(right + index + 3 * lanes), fourth);
+    }
+
+    for (; index + lanes <= count; index += lanes)
+        first = Traits::multiplyAdd(Traits::loadFloats(left + index), Traits::loadFloats(right + index), first);
+
+    float sum = Traits::reduceFloats((first + second) + (third + fourth));
+
+    if constexpr (lanes > 1)
+        sum += __internal_dotFloats<typename Traits::Narrow>(left + index, right + index, count - index);
+
+    return sum;
+}
+
+/**
+ * @brief Instantiates every kernel for one instruction set, with the
+ * traits and their narrower fallbacks inlined into it.
+ */
+#define SIMD_DEFINE_KERNELS(NAME, TRAITS, ...)                                                                        \
+    __attribute__((__VA_ARGS__)) static void* __internal_copy##NAME(void* destination, const void* source,            \
+        itl::size_t size)                                                                                             \
+    {                                                                                                                 \
+        return __internal_copy<TRAITS>(destination, source, size);                                                    \
+    }                                                                                                                 \
+    __attribute__((__VA_ARGS__)) static void* __internal_fill##NAME(void* destination, int value, itl::size_t size)   \
+    {                                                                                                                 \
+        return __internal_fill<TRAITS>(destination, value, size);                                                     \
+    }                                                                                                                 \
+    __attribute__((__VA_ARGS__)) static int __internal_compare##NAME(const void* first, const void* second,           \
+        itl::size_t size)                                                                                             \
+    {                                                                                                                 \
+        return __internal_compare<TRAITS>(first, second, size);                                                       \
+    }                                                                                                                 \
+    __attribute__((__VA_ARGS__)) static const void* __internal_findByte##NAME(const void* data, int value,            \
+        itl::size_t size)                                                                                             \
+    {                                                                                                                 \
+        return __internal_findByte<TRAITS>(data, value, size);                                                        \
+    }                                                                                                                 \
+    __attribute__((__VA_ARGS__)) static itl::size_t __internal_stringLength##NAME(const char* string)                 \
+    {                                                                                                                 \
+        return __internal_stringLength<TRAITS>(string);                                                               \
+    }                                                                                                                 \
+    __attribute__((__VA_ARGS__)) static const void* __internal_findBytes##NAME(const void* data, itl::size_t size,    \
+        const void* pattern, itl::size_t patternSize)                                                                 \
+    {                                                                                                                 \
+        return __internal_findBytes<TRAITS>(data, size, pattern, patternSize);                                        \
+    }                                                                                                                 \
+    __attribute__((__VA_ARGS__)) static itl::size_t __internal_countByte##NAME(const void* data, int value,           \
+        itl::size_t size)                                                                                             \
+    {                                                                                                                 \
+        return __internal_countByte<TRAITS>(data, value, size);                                                       \
+    }                                                                                                                 \
+    __attribute__((__VA_ARGS__)) static itl::uint64_t __internal_sumBytes##NAME(const void* data, itl::size_t size)   \
+    {                                                                                                                 \
+        return __internal_sumBytes<TRAITS>(data, size);                                                               \
+    }                                                                                                                 \
+    __attribute__((__VA_ARGS__)) static float __internal_sumFloats##NAME(const float* values, itl::size_t count)      \
+    {                                                                                                                 \
+        return __internal_sumFloats<TRAITS>(values, count);                                                           \
+    }                                                                                                                 \
+    __attribute__((__VA_ARGS__)) static float __internal_dotFloats##NAME(const float* first, const float* second,     \
+        itl::size_t count)                                                                                            \
+    {                                                                                                                 \
+        return __internal_dotFloats<TRAITS>(first, second, count);                                                    \
+    }
+
+#define SIMD_KERNEL_TABLE(NAME)                                                                                       \
+    {                                                                                                                 \
+        __internal_copy##NAME, __internal_fill##NAME, __internal_compare##NAME, __internal_findByte##NAME,            \
+            __internal_stringLength##NAME, __internal_findBytes##NAME, __internal_countByte##NAME,                    \
+            __internal_sumBytes##NAME, __internal_sumFloats##NAME, __internal_dotFloats##NAME                         \
+    }
+
+SIMD_DEFINE_KERNELS(Scalar, ScalarTraits, flatten)
+SIMD_DEFINE_KERNELS(Sse2, Sse2Traits, target("sse2"), flatten)
+SIMD_DEFINE_KERNELS(Avx2, Avx2Traits, target("avx2,fma"), flatten)
+SIMD_DEFINE_KERNELS(Avx512, Avx512Traits, target("avx512f,avx512bw,avx2,fma"), flatten)
+
+static const itl::simd::SimdKernels internalLevelKernels[] = {
+    SIMD_KERNEL_TABLE(Scalar),
+    SIMD_KERNEL_TABLE(Sse2),
+    SIMD_KERNEL_TABLE(Avx2),
+    SIMD_KERNEL_TABLE(Avx512),
+};
+
+/*
+ * Until the processor is probed, every entry points at a stub that probes
+ * it, installs the selected kernels and forwards the call to them.
+ */
+static void* __internal_resolveCopy(void* destination, const void* source, itl::size_t size);
+static void* __internal_resolveFill(void* destination, int value, itl::size_t size);
+static int __internal_resolveCompare(const void* first, const void* second, itl::size_t size);
+static const void* __internal_resolveFindByte(const void* data, int value, itl::size_t size);
+static itl::size_t __internal_resolveStringLength(const char* string);
+static const void* __internal_resolveFindBytes(const void* data, itl::size_t size, const void* pattern, itl::size_t patternSize);
+static itl::size_t __internal_resolveCountByte(const void* data, int value, itl::size_t size);
+static itl::uint64_t __internal_resolveSumBytes(const void* data, itl::size_t size);
+static float __internal_resolveSumFloats(const float* values, itl::size_t count);
+static float __internal_resolveDotFloats(const float* first, const float* second, itl::size_t count);
+
+static itl::simd::SimdKernels internalKernels = {
+    __internal_resolveCopy,
+    __internal_resolveFill,
+    __internal_resolveCompare,
+    __internal_resolveFindByte,
+    __internal_resolveStringLength,
+    __internal_resolveFindBytes,
+    __internal_resolveCountByte,
+    __internal_resolveSumBytes,
+    __internal_resolveSumFloats,
+    __internal_resolveDotFloats,
+};
+
+static void* __internal_resolveCopy(void* destination, const void* source, itl::size_t size)
+{
+    itl::simd::initialize();
+    return internalKernels.copy(destination, source, size);
+}
+
+static void* __internal_resolveFill(void* destination, int value, itl::size_t size)
+{
+    itl::simd::initialize();
+    return internalKernels.fill(destination, value, size);
+}
+
+static int __internal_resolveCompare(const void* first, const void* second, itl::size_t size)
+{
+    itl::simd::initialize();
+    return internalKernels.compare(first, second, size);
+}
+
+static const void* __internal_resolveFindByte(const void* data, int value, itl::size_t size)
+{
+    itl::simd::initialize();
+    return internalKernels.findByte(data, value, size);
+}
+
+static itl::size_t __internal_resolveStringLength(const char* string)
+{
+    itl::simd::initialize();
+    return internalKernels.stringLength(string);
+}
+
+static const void* __internal_resolveFindBytes(const void* data, itl::size_t size, const void* pattern, itl::size_t patternSize)
+{
+    itl::simd::initialize();
+    return internalKernels.findBytes(data, size, pattern, patternSize);
+}
+
+static itl::size_t __internal_resolveCountByte(const void* data, int value, itl::size_t size)
+{
+    itl::simd::initialize();
+    return internalKernels.countByte(data, value, size);
+}
+
+static itl::uint64_t __internal_resolveSumBytes(const void* data, itl::size_t size)
+{
+    itl::simd::initialize();
+    return internalKernels.sumBytes(data, size);
+}
+
+static float __internal_resolveSumFloats(const float* values, itl::size_t count)
+{
+    itl::simd::initialize();
+    return internalKernels.sumFloats(values, count);
+}
+
+static float __internal_resolveDotFloats(const float* first, const float* second, itl::size_t count)
+{
+    itl::simd::initialize();
+    return internalKernels.dotFloats(first, second, count);
+}
+
+/**
+ * @brief Executes the cpuid instruction.
+ */
+static void __internal_cpuid(itl::uint32_t leaf, itl::uint32_t registers[4])
+{
+    __asm__ volatile("cpuid"
+                     : "=a"(registers[0]), "=b"(registers[1]), "=c"(registers[2]), "=d"(registers[3])
+                     : "a"(leaf), "c"(0));
+}
+
+/**
+ * @brief Reads the register of the states the kernel saves on context
+ * switches.
+ */
+static itl::uint32_t __internal_enabledStates()
+{
+    itl::uint32_t low, high;
+
+    __asm__ volatile("xgetbv"
+                     : "=a"(low), "=d"(high)
+                     : "c"(0));
+
+    return low;
+}
+
+/**
+ * @brief Probes the processor once and caches its features.
+ *
+ * Instructions count only when the kernel also saves the registers they
+ * use, which XGETBV reports.
+ */
+static itl::uint32_t __internal_features()
+{
+    itl::uint32_t features = __atomic_load_n(&internalFeatures, __ATOMIC_ACQUIRE);
+
+    if (features & SIMD_FEATURES_PROBED)
+        return features;
+
+    itl::uint32_t registers[4];
+
+    features = SIMD_FEATURES_PROBED;
+    __internal_cpuid(0, registers);
+
+    itl::uint32_t lastLeaf = registers[0];
+
+    if (lastLeaf >= CPUID_FEATURES) {
+        __internal_cpuid(CPUID_FEATURES, registers);
+
+        itl::uint32_t states = (registers[2] & CPUID_OSXSAVE) != 0 ? __internal_enabledStates() : 0;
+
+        if (registers[3] & CPUID_SSE2)
+            features |= SIMD_FEATURE_SSE2;
+
+        if ((registers[2] & CPUID_AVX) && (states & XCR0_AVX_STATE) == XCR0_AVX_STATE) {
+            features |= SIMD_FEATURE_AVX;
+
+            if (registers[2] & CPUID_FMA)
+                features |= SIMD_FEATURE_FMA;
+        }
+
+        if (lastLeaf >= CPUID_EXTENDED_FEATURES) {
+            __internal_cpuid(CPUID_EXTENDED_FEATURES, registers);
+
+            if (registers[1] & CPUID_ERMS)
+                features |= SIMD_FEATURE_ERMS;
+
+            if ((features & SIMD_FEATURE_AVX) && (registers[1] & CPUID_AVX2))
+                features |= SIMD_FEATURE_AVX2;
+
+            if ((features & SIMD_FEATURE_AVX) && (states & XCR0_AVX512_STATE) == XCR0_AVX512_STATE
+                && (registers[1] & CPUID_AVX512F)) {
+                features |= SIMD_FEATURE_AVX512F;
+
+                if (registers[1] & CPUID_AVX512BW)
+                    features |= SIMD_FEATURE_AVX512BW;
+            }
+        }
+    }
+
+    __atomic_store_n(&internalFeatures, features, __ATOMIC_RELEASE);
+
+    return features;
+}
+
+/**
+ * @brief Returns the widest level the processor supports.
+ */
+static itl::simd::SimdLevel __internal_supportedLevel(itl::uint32_t features)
+{
+    constexpr itl::uint32_t avx512 = SIMD_FEATURE_AVX512F | SIMD_FEATURE_AVX512BW | SIMD_FEATURE_AVX2 | SIMD_FEATURE_FMA;
+    constexpr itl::uint32_t avx2 = SIMD_FEATURE_AVX2 | SIMD_FEATURE_FMA;
+
+    if ((features & avx512) == avx512)
+        return itl::simd::SIMD_LEVEL_AVX512;
+
+    if ((features & avx2) == avx2)
+        return itl::simd::SIMD_LEVEL_AVX2;
+
+    if (features & SIMD_FEATURE_SSE2)
+        return itl::simd::SIMD_LEVEL_SSE2;
+
+    return itl::simd::SIMD_LEVEL_SCALAR;
+}
+
+/**
+ * @brief Points every entry of the dispatch table at the kernels of a
+ * level.
+ *
+ * The entries are stored one by one, since copying the table as a whole
+ * may itself call memcpy, which goes through the table.
+ */
+static void __internal_install(itl::simd::SimdLevel level)
+{
+    const itl::simd::SimdKernels* kernels = &internalLevelKernels[level];
+
+    __atomic_store_n(&internalKernels.copy, kernels->copy, __ATOMIC_RELAXED);
+    __atomic_store_n(&internalKernels.fill, kernels->fill, __ATOMIC_RELAXED);
+    __atomic_store_n(&internalKernels.compare, kernels->compare, __ATOMIC_RELAXED);
+    __atomic_store_n(&internalKernels.findByte, kernels->findByte, __ATOMIC_RELAXED);
+    __atomic_store_n(&internalKernels.stringLength, kernels->stringLength, __ATOMIC_RELAXED);
+    __atomic_store_n(&internalKernels.findBytes, kernels->findBytes, __ATOMIC_RELAXED);
+    __atomic_store_n(&internalKernels.countByte, kernels->countByte, __ATOMIC_RELAXED);
+    __atomic_store_n(&internalKernels.sumBytes, kernels->sumBytes, __ATOMIC_RELAXED);
+    __atomic_store_n(&internalKernels.sumFloats, kernels->sumFloats, __ATOMIC_RELAXED);
+    __atomic_store_n(&internalKernels.dotFloats, kernels->dotFloats, __ATOMIC_RELAXED);
+    __atomic_store_n(&internalLevel, level, __ATOMIC_RELAXED);
+    __atomic_store_n(&internalInitialized, true, __ATOMIC_RELEASE);
+}
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace simd {
+    void initialize()
+    {
+        if (__atomic_load_n(&internalInitialized, __ATOMIC_ACQUIRE))
+            return;
+
+        __internal_install(__internal_supportedLevel(__internal_features()));
+    }
+
+    itl::uint32_t getFeatures()
+    {
+        return __internal_features() & ~SIMD_FEATURES_PROBED;
+    }
+
+    itl::simd::SimdLevel getLevel()
+    {
+        itl::simd::initialize();
+
+        return __atomic_load_n(&internalLevel, __ATOMIC_RELAXED);
+    }
+
+    itl::simd::SimdLevel setLevel(itl::simd::SimdLevel level)
+    {
+        itl::simd::SimdLevel supported = __internal_supportedLevel(__internal_features());
+
+        if (level > supported)
+            level = supported;
+
+        __internal_install(level);
+
+        return level;
+    }
+
+    const itl::simd::SimdKernels* getKernels(itl::simd::SimdLevel level)
+    {
+        return &internalLevelKernels[level];
+    }
+
+    void* copy(void* destination, const void* source, itl::size_t size)
+    {
+        return __atomic_load_n(&internalKernels.copy, __ATOMIC_RELAXED)(destination, source, size);
+    }
+
+    void* fill(void* destination, int value, itl::size_t size)
+    {
+        return __atomic_load_n(&internalKernels.fill, __ATOMIC_RELAXED)(destination, value, size);
+    }
+
+    int compare(const void* first, const void* second, itl::size_t size)
+    {
+        return __atomic_load_n(&internalKernels.compare, __ATOMIC_RELAXED)(first, second, size);
+    }
+
+    const void* findByte(const void* data, int value, itl::size_t size)
+    {
+        return __atomic_load_n(&internalKernels.findByte, __ATOMIC_RELAXED)(data, value, size);
+    }
+
+    itl::size_t stringLength(const char* string)
+    {
+        return __atomic_load_n(&internalKernels.stringLength, __ATOMIC_RELAXED)(string);
+    }
+
+    const void* findBytes(const void* data, itl::size_t size, const void* pattern, itl::size_t patternSize)
+    {
+        return __atomic_load_n(&internalKernels.findBytes, __ATOMIC_RELAXED)(data, size, pattern, patternSize);
+    }
+
+    itl::size_t countByte(const void* data, int value, itl::size_t size)
+    {
+        return __atomic_load_n(&internalKernels.countByte, __ATOMIC_RELAXED)(data, value, size);
+    }
+
+    itl::uint64_t sumBytes(const void* data, itl::size_t size)
+    {
+        return __atomic_load_n(&internalKernels.sumBytes, __ATOMIC_RELAXED)(data, size);
+    }
+
+    float sumFloats(const float* values, itl::size_t count)
+    {
+        return __atomic_load_n(&internalKernels.sumFloats, __ATOMIC_RELAXED)(values, count);
+    }
+
+    float dotFloats(const float* first, const float* second, itl::size_t count)
+    {
+        return __atomic_load_n(&internalKernels.dotFloats, __ATOMIC_RELAXED)(first, second, count);
+    }
+}; // namespace simd
+} // namespace itl
+
+// The compiler emits calls to these functions for aggregate copies and
+// initialization, and the library has no C library to provide them.
+extern "C" void* memcpy(void* destination, const void* source, itl::size_t size)
+{
+    return itl::simd::copy(destination, source, size);
+}
+
+extern "C" void* memmove(void* destination, const void* source, itl::size_t size)
+{
+    return itl::simd::copy(destination, source, size);
+}
+
+extern "C" void* memset(void* destination, int value, itl::size_t size)
+{
+    return itl::simd::fill(destination, value, size);
+}
+
+extern "C" int memcmp(const void* first, const void* second, itl::size_t size)
+{
+    return itl::simd::compare(first, second, size);
+}
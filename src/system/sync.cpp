@@ -0,0 +1,245 @@
+/**
+ * @file src/system/sync.cpp
+ * @brief Implements futex-based synchronization primitives.
+ * @category System
+ *
+ * This file contains the contended paths of the primitives: spinning for
+ * a while in the hope that the holder releases soon, then parking in the
+ * kernel on the futex word. Uncontended paths are inline in the header.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#include "system/sync.hpp"
+#include "system/syscalls.hpp"
+#include "typing/ctypes.hpp"
+
+/**
+ * @brief Tells the processor the thread is spinning.
+ */
+static inline void __internal_relax()
+{
+    __builtin_ia32_pause();
+}
+
+/**
+ * @brief Acquires a mutex by marking it contended, parking while it is
+ * held.
+ *
+ * Once a thread has parked, the mutex stays contended until it is
+ * released, so the holder wakes the next waiter. Threads woken from a
+ * condition variable take this path too, since broadcastCondition() may
+ * have queued other threads on the mutex.
+ */
+static void __internal_lockParked(itl::thread::Mutex* mutex)
+{
+    while (__atomic_exchange_n(&mutex->state, MUTEX_CONTENDED, __ATOMIC_ACQUIRE) != MUTEX_UNLOCKED)
+        itl::thread::futexWait(&mutex->state, MUTEX_CONTENDED, nullptr);
+}
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace thread {
+    void lockMutexContended(itl::thread::Mutex* mutex)
+    {
+        itl::uint32_t spins = __atomic_load_n(&mutex->spins, __ATOMIC_RELAXED);
+        itl::uint32_t limit = spins * 2 + 10;
+
+        if (limit > MUTEX_MAX_SPINS)
+            limit = MUTEX_MAX_SPINS;
+
+        // The spin budget follows the spins that recently acquired the
+        // mutex, so short critical sections are waited out in user space
+        // while long ones park almost at once.
+        for (itl::uint32_t count = 0; count < limit; ++count) {
+            if (__atomic_load_n(&mutex->state, __ATOMIC_RELAXED) == MUTEX_UNLOCKED && tryLockMutex(mutex)) {
+                __atomic_store_n(&mutex->spins, spins + ((int)count - (int)spins) / 8, __ATOMIC_RELAXED);
+                return;
+            }
+
+            __internal_relax();
+        }
+
+        __atomic_store_n(&mutex->spins, spins + ((int)limit - (int)spins) / 8, __ATOMIC_RELAXED);
+        __internal_lockParked(mutex);
+    }
+
+    void waitCondition(itl::thread::Condition* condition, itl::thread::Mutex* mutex)
+    {
+        timedWaitCondition(condition, mutex, nullptr);
+    }
+
+    bool timedWaitCondition(itl::thread::Condition* condition, itl::thread::Mutex* mutex,
+        const itl::linux::syscall::timespec_struct* timeout)
+    {
+        // Both happen under the mutex, so a signaler that changes the
+        // predicate under the mutex sees the waiter and bumps the sequence
+        // after it was read.
+        itl::uint32_t sequence = __atomic_load_n(&condition->sequence, __ATOMIC_RELAXED);
+
+        __atomic_fetch_add(&condition->waiters, 1, __ATOMIC_RELAXED);
+        __atomic_store_n(&condition->mutex, mutex, __ATOMIC_RELAXED);
+
+        unlockMutex(mutex);
+
+        int result = futexWait(&condition->sequence, sequence, timeout);
+
+        __atomic_fetch_sub(&condition->waiters, 1, __ATOMIC_RELAXED);
+        __internal_lockParked(mutex);
+
+        return result != -ETIMEDOUT;
+    }
+
+    void signalCondition(itl::thread::Condition* condition)
+    {
+        if (__atomic_load_n(&condition->waiters, __ATOMIC_ACQUIRE) == 0)
+            return;
+
+        __atomic_fetch_add(&condition->sequence, 1, __ATOMIC_RELEASE);
+        futexWake(&condition->sequence, 1);
+    }
+
+    void broadcastCondition(itl::thread::Condition* condition)
+    {
+        if (__atomic_load_n(&condition->waiters, __ATOMIC_ACQUIRE) == 0)
+            return;
+
+        itl::uint32_t sequence = __atomic_add_fetch(&condition->sequence, 1, __ATOMIC_RELEASE);
+        itl::thread::Mutex* mutex = __atomic_load_n(&condition->mutex, __ATOMIC_RELAXED);
+
+        // Wake one waiter and move the others to the mutex. The woken
+        // thread locks the mutex as contended, so its unlock releases the
+        // next one, and so on down the queue.
+        if (mutex != nullptr) {
+            long result = itl::linux::syscall::futex(&condition->sequence, FUTEX_CMP_REQUEUE_PRIVATE, 1,
+                (const itl::linux::syscall::timespec_struct*)(itl::uintptr_t)FUTEX_WAKE_ALL, &mutex->state, sequence);
+
+            if (result >= 0)
+                return;
+        }
+
+        futexWake(&condition->sequence, FUTEX_WAKE_ALL);
+    }
+
+    void readLockContended(itl::thread::RwLock* lock)
+    {
+        itl::uint32_t spins = 0;
+
+        while (true) {
+            itl::uint32_t state = __atomic_load_n(&lock->state, __ATOMIC_RELAXED);
+
+            if (!(state & (RWLOCK_WRITER | RWLOCK_WRITER_PENDING))) {
+                if (__atomic_compare_exchange_n(&lock->state, &state, state + 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+                    return;
+
+                continue;
+            }
+
+            if (spins < SYNC_SPIN_LIMIT) {
+                ++spins;
+                __internal_relax();
+                continue;
+            }
+
+            itl::uint32_t parked = state | RWLOCK_WAITERS;
+
+            if (parked != state && !__atomic_compare_exchange_n(&lock->state, &state, parked, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                continue;
+
+            futexWait(&lock->state, parked, nullptr);
+        }
+    }
+
+    void writeLockContended(itl::thread::RwLock* lock)
+    {
+        itl::uint32_t spins = 0;
+
+        while (true) {
+            itl::uint32_t state = __atomic_load_n(&lock->state, __ATOMIC_RELAXED);
+
+            if (!(state & (RWLOCK_WRITER | RWLOCK_READERS_MASK))) {
+                if (__atomic_compare_exchange_n(&lock->state, &state, (state | RWLOCK_WRITER) & ~RWLOCK_WRITER_PENDING,
+                        false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+                    return;
+
+                continue;
+            }
+
+            if (spins < SYNC_SPIN_LIMIT) {
+                ++spins;
+                __internal_relax();
+                continue;
+            }
+
+            // A parked writer holds new readers back, so a steady stream
+            // of readers cannot starve it.
+            itl::uint32_t parked = state | RWLOCK_WAITERS | RWLOCK_WRITER_PENDING;
+
+            if (parked != state && !__atomic_compare_exchange_n(&lock->state, &state, parked, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                continue;
+
+            futexWait(&lock->state, parked, nullptr);
+        }
+    }
+
+    void waitEvent(itl::thread::Event* event)
+    {
+        for (itl::uint32_t spins = 0; spins < SYNC_SPIN_LIMIT; ++spins) {
+            if (__atomic_load_n(&event->state, __ATOMIC_ACQUIRE) == 1)
+                return;
+
+            __internal_relax();
+        }
+
+        while (true) {
+            itl::uint32_t state = __atomic_load_n(&event->state, __ATOMIC_ACQUIRE);
+
+            if (state == 1)
+                return;
+
+            if (state == 0 && !__atomic_compare_exchange_n(&event->state, &state, 2, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                continue;
+
+            futexWait(&event->state, 2, nullptr);
+        }
+    }
+
+    bool arriveAndWait(itl::thread::Barrier* barrier)
+    {
+        itl::uint32_t generation = __atomic_load_n(&barrier->generation, __ATOMIC_ACQUIRE);
+
+        if (__atomic_add_fetch(&barrier->arrived, 1, __ATOMIC_ACQ_REL) == barrier->count) {
+            __atomic_store_n(&barrier->arrived, 0, __ATOMIC_RELAXED);
+            __atomic_add_fetch(&barrier->generation, 1, __ATOMIC_SEQ_CST);
+
+            if (__atomic_load_n(&barrier->sleepers, __ATOMIC_SEQ_CST) != 0)
+                futexWake(&barrier->generation, FUTEX_WAKE_ALL);
+
+            return true;
+        }
+
+        for (itl::uint32_t spins = 0; spins < SYNC_SPIN_LIMIT; ++spins) {
+            if (__atomic_load_n(&barrier->generation, __ATOMIC_ACQUIRE) != generation)
+                return false;
+
+            __internal_relax();
+        }
+
+        // The sleeper count is raised before the generation is checked
+        // again by the kernel, and the last thread raises the generation
+        // before reading the count, so one of the two always sees the
+        // other.
+        __atomic_add_fetch(&barrier->sleepers, 1, __ATOMIC_SEQ_CST);
+
+        while (__atomic_load_n(&barrier->generation, __ATOMIC_SEQ_CST) == generation)
+            futexWait(&barrier->generation, generation, nullptr);
+
+        __atomic_sub_fetch(&barrier->sleepers, 1, __ATOMIC_RELAXED);
+        return false;
+    }
+}; // namespace thread
+} // namespace itl
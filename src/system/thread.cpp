@@ -0,0 +1,416 @@
+/**
+ * @file src/system/thread.cpp
+ * @brief Implements threads created with clone.
+ * @category System
+ *
+ * This file contains the lookup of the thread-local storage template, the
+ * mapping of the stack and storage of each thread, the assembly
+ * trampolines that start a thread on its own stack, and joining.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#include "system/thread.hpp"
+#include "io/print.hpp"
+#include "memory/allocator.hpp"
+#include "system/auxv.hpp"
+#include "system/mmacros.hpp"
+#include "system/rawSyscalls.hpp"
+#include "system/simd.hpp"
+#include "system/sync.hpp"
+#include "system/syscalls.hpp"
+#include "typing/ctypes.hpp"
+
+#define PT_PHDR 6 ///< Program header describing the program headers.
+#define PT_TLS 7 ///< Program header describing the TLS template.
+
+#ifdef __x86_64__
+#define ARCH_SET_FS 0x1002 ///< arch_prctl code setting the FS base.
+#define ARCH_GET_FS 0x1003 ///< arch_prctl code reading the FS base.
+
+/**
+ * @struct ProgramHeader
+ * @brief ELF64 program header, as found through AT_PHDR.
+ */
+typedef struct {
+    itl::uint32_t type; ///< Segment type.
+    itl::uint32_t flags; ///< Segment flags.
+    itl::uint64_t offset; ///< Offset of the segment in the file.
+    itl::uint64_t virtualAddress; ///< Address of the segment in memory.
+    itl::uint64_t physicalAddress; ///< Unused physical address.
+    itl::uint64_t fileSize; ///< Bytes of the segment stored in the file.
+    itl::uint64_t memorySize; ///< Bytes of the segment in memory.
+    itl::uint64_t alignment; ///< Alignment of the segment.
+} ProgramHeader;
+#elif __i386__
+#define TLS_SEGMENT_LIMIT 0xfffff ///< Limit of the TLS segment: all of the address space, in pages.
+#define TLS_SEGMENT_FLAGS 0x51 ///< 32-bit, limit in pages, usable.
+
+/**
+ * @struct ProgramHeader
+ * @brief ELF32 program header, as found through AT_PHDR.
+ */
+typedef struct {
+    itl::uint32_t type; ///< Segment type.
+    itl::uint32_t offset; ///< Offset of the segment in the file.
+    itl::uint32_t virtualAddress; ///< Address of the segment in memory.
+    itl::uint32_t physicalAddress; ///< Unused physical address.
+    itl::uint32_t fileSize; ///< Bytes of the segment stored in the file.
+    itl::uint32_t memorySize; ///< Bytes of the segment in memory.
+    itl::uint32_t flags; ///< Segment flags.
+    itl::uint32_t alignment; ///< Alignment of the segment.
+} ProgramHeader;
+#endif // #ifdef __x86_64__
+
+/**
+ * @struct StorageTemplate
+ * @brief Thread-local storage template of the program.
+ */
+typedef struct {
+    const unsigned char* image; ///< Initialized TLS data.
+    itl::size_t imageSize; ///< Bytes of initialized data.
+    itl::size_t blockSize; ///< Size of the TLS block, rounded to its alignment.
+    itl::size_t alignment; ///< Alignment of the thread pointer.
+} StorageTemplate;
+
+static StorageTemplate internalStorageTemplate = {
+    .image = nullptr,
+    .imageSize = 0,
+    .blockSize = 0,
+    .alignment = THREAD_CONTROL_BLOCK_SIZE
+};
+
+extern "C" void __internal_threadStart(itl::thread::Thread* thread) __attribute__((used, noreturn));
+extern "C" long __internal_cloneThread(unsigned long flags, void* stackTop, int* threadId, void* tls,
+    itl::thread::Thread* thread);
+
+// The child starts on its new stack, where the descriptor was stored, and
+// never returns through the trampoline.
+#ifdef __x86_64__
+__asm__(
+    ".section .text\n"
+    ".global __internal_cloneThread\n"
+    "__internal_cloneThread:\n"
+    "    sub $16, %rsi\n"
+    "    mov %r8, (%rsi)\n" // thread descriptor, read by the child
+    "    mov %rdx, %r10\n" // identifier cleared on exit
+    "    mov %rcx, %r8\n" // thread pointer
+    "    mov $56, %eax\n" // syscall number for clone; rdx receives the identifier
+    "    syscall\n"
+    "    test %rax, %rax\n"
+    "    jnz 1f\n"
+    "    xor %ebp, %ebp\n" // mark the outermost frame
+    "    mov (%rsp), %rdi\n"
+    "    call __internal_threadStart\n"
+    "1:\n"
+    "    ret\n");
+#elif __i386__
+__asm__(
+    ".section .text\n"
+    ".global __internal_cloneThread\n"
+    "__internal_cloneThread:\n"
+    "    push %ebx\n"
+    "    push %esi\n"
+    "    push %edi\n"
+    "    mov 16(%esp), %ebx\n" // flags
+    "    mov 20(%esp), %ecx\n" // stack top
+    "    mov 24(%esp), %edx\n" // receives the identifier
+    "    mov 28(%esp), %esi\n" // TLS segment descriptor
+    "    mov %edx, %edi\n" // identifier cleared on exit
+    "    mov 32(%esp), %eax\n"
+    "    sub $16, %ecx\n"
+    "    mov %eax, (%ecx)\n" // thread descriptor, the argument of the child
+    "    mov $120, %eax\n" // syscall number for clone
+    "    int $0x80\n"
+    "    test %eax, %eax\n"
+    "    jnz 1f\n"
+    "    xor %ebp, %ebp\n" // mark the outermost frame
+    "    call __internal_threadStart\n"
+    "1:\n"
+    "    pop %edi\n"
+    "    pop %esi\n"
+    "    pop %ebx\n"
+    "    ret\n");
+#endif // #ifdef __x86_64__
+
+/**
+ * @brief Locates the TLS template through the program headers.
+ */
+static void __internal_findStorageTemplate()
+{
+    const ProgramHeader* headers = (const ProgramHeader*)itl::linux::auxv::getValue(AT_PHDR);
+    itl::size_t count = itl::linux::auxv::getValue(AT_PHNUM);
+    itl::uintptr_t bias = 0;
+
+    if (headers == nullptr)
+        return;
+
+    for (itl::size_t index = 0; index < count; ++index) {
+        if (headers[index].type == PT_PHDR)
+            bias = (itl::uintptr_t)headers - headers[index].virtualAddress;
+    }
+
+    for (itl::size_t index = 0; index < count; ++index) {
+        if (headers[index].type != PT_TLS)
+            continue;
+
+        itl::size_t alignment = headers[index].alignment == 0 ? 1 : headers[index].alignment;
+
+        internalStorageTemplate.image = (const unsigned char*)(bias + headers[index].virtualAddress);
+        internalStorageTemplate.imageSize = headers[index].fileSize;
+        internalStorageTemplate.blockSize = (headers[index].memorySize + alignment - 1) & ~(alignment - 1);
+
+        if (alignment > internalStorageTemplate.alignment)
+            internalStorageTemplate.alignment = alignment;
+    }
+}
+
+/**
+ * @brief Maps anonymous, private, read-write memory.
+ *
+ * @return The mapping, or a negated errno value cast to a pointer.
+ */
+static void* __internal_mapAnonymous(itl::size_t size, unsigned long flags)
+{
+#ifdef __x86_64__
+    return itl::linux::syscall::mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+#elif __i386__
+    return itl::linux::syscall::mmap2(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+#endif // #ifdef __x86_64__
+}
+
+/**
+ * @brief Returns the bytes needed at the end of a mapping for the TLS
+ * block and the control block, rounded to a page.
+ */
+static itl::size_t __internal_storageSize(itl::size_t pageSize)
+{
+    itl::size_t size = internalStorageTemplate.blockSize + internalStorageTemplate.alignment + THREAD_CONTROL_BLOCK_SIZE;
+
+    return (size + pageSize - 1) & ~(pageSize - 1);
+}
+
+/**
+ * @brief Initializes the thread-local storage at the end of a mapping.
+ *
+ * On x86 and x86_64 the TLS block sits right below the thread pointer,
+ * which points to a control block whose first word points to itself. The
+ * mapping is fresh, so the part of the block past the image is already
+ * zero.
+ *
+ * @param end The end of the mapping.
+ * @return The thread pointer.
+ */
+static unsigned char* __internal_prepareStorage(unsigned char* end)
+{
+    itl::uintptr_t threadPointer = ((itl::uintptr_t)end - THREAD_CONTROL_BLOCK_SIZE)
+        & ~(itl::uintptr_t)(internalStorageTemplate.alignment - 1);
+
+    itl::simd::copy((unsigned char*)threadPointer - internalStorageTemplate.blockSize, internalStorageTemplate.image,
+        internalStorageTemplate.imageSize);
+    *(void**)threadPointer = (void*)threadPointer;
+
+    return (unsigned char*)threadPointer;
+}
+
+#ifdef __i386__
+/**
+ * @brief Reads the index of the TLS segment of the calling thread.
+ */
+static unsigned __internal_segmentEntry()
+{
+    unsigned short selector;
+
+    __asm__ volatile("mov %%gs, %0" : "=r"(selector));
+    return selector >> 3;
+}
+
+/**
+ * @brief Describes a TLS segment based at a thread pointer.
+ */
+static void __internal_describeSegment(itl::linux::syscall::user_desc_struct* descriptor, unsigned entry,
+    unsigned char* threadPointer)
+{
+    descriptor->entryNumber = entry;
+    descriptor->baseAddress = (unsigned)(itl::uintptr_t)threadPointer;
+    descriptor->limit = TLS_SEGMENT_LIMIT;
+    descriptor->flags = TLS_SEGMENT_FLAGS;
+}
+#endif // #ifdef __i386__
+
+/**
+ * @brief Reports whether the calling thread already has a thread pointer.
+ */
+static bool __internal_hasThreadPointer()
+{
+#ifdef __x86_64__
+    unsigned long base = 0;
+
+    itl::linux::syscall::arch_prctl(ARCH_GET_FS, (unsigned long)&base);
+    return base != 0;
+#elif __i386__
+    return __internal_segmentEntry() != 0;
+#endif // #ifdef __x86_64__
+}
+
+/**
+ * @brief Installs a thread pointer for the calling thread.
+ *
+ * @return 0 on success, or a negated errno value on failure.
+ */
+static int __internal_setThreadPointer(unsigned char* threadPointer)
+{
+#ifdef __x86_64__
+    return itl::linux::syscall::arch_prctl(ARCH_SET_FS, (unsigned long)threadPointer);
+#elif __i386__
+    itl::linux::syscall::user_desc_struct descriptor;
+
+    __internal_describeSegment(&descriptor, (unsigned)-1, threadPointer);
+
+    int result = itl::linux::syscall::set_thread_area(&descriptor);
+
+    if (result < 0)
+        return result;
+
+    unsigned short selector = (unsigned short)((descriptor.entryNumber << 3) | 3);
+
+    __asm__ volatile("mov %0, %%gs" : : "r"(selector));
+    return 0;
+#endif // #ifdef __x86_64__
+}
+
+/**
+ * @brief Turns the first page of a stack mapping into a guard page.
+ *
+ * MADV_GUARD_INSTALL marks the page in the page tables and keeps the
+ * mapping a single area; older kernels reject it, and the page is then
+ * protected instead, which splits the mapping in two.
+ */
+static void __internal_installGuard(void* mapping, itl::size_t pageSize)
+{
+    if (itl::linux::syscall::madvise((unsigned long)mapping, pageSize, MADV_GUARD_INSTALL) < 0)
+        itl::linux::syscall::mprotect((unsigned long)mapping, pageSize, PROT_NONE);
+}
+
+extern "C" void __internal_threadStart(itl::thread::Thread* thread)
+{
+    thread->function(thread->argument);
+
+    itl::io::flush();
+    itl::releaseThreadCache();
+
+    // Only this thread exits; the kernel then clears the identifier and
+    // wakes the thread joining it.
+    itl::linux::syscall::syscall1(SYS_EXIT, 0);
+    __builtin_unreachable();
+}
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace thread {
+    int initialize()
+    {
+        __internal_findStorageTemplate();
+
+        if (__internal_hasThreadPointer())
+            return 0;
+
+        itl::size_t size = __internal_storageSize(itl::linux::auxv::getPageSize());
+        void* mapping = __internal_mapAnonymous(size, 0);
+
+        if (SYSCALL_FAILED(mapping))
+            return (int)(long)mapping;
+
+        int result = __internal_setThreadPointer(__internal_prepareStorage((unsigned char*)mapping + size));
+
+        if (result < 0)
+            itl::linux::syscall::munmap((unsigned long)mapping, size);
+
+        return result;
+    }
+
+    int createThread(itl::thread::Thread* thread, void (*function)(void*), void* argument, itl::size_t stackSize)
+    {
+        itl::size_t pageSize = itl::linux::auxv::getPageSize();
+
+        if (stackSize == 0)
+            stackSize = THREAD_DEFAULT_STACK_SIZE;
+
+        stackSize = (stackSize + pageSize - 1) & ~(pageSize - 1);
+
+        // One mapping holds, from the bottom up, the guard page, the stack
+        // and the thread-local storage, so a thread costs one mmap.
+        itl::size_t size = pageSize + stackSize + __internal_storageSize(pageSize);
+        void* mapping = __internal_mapAnonymous(size, MAP_STACK);
+
+        if (SYSCALL_FAILED(mapping))
+            return (int)(long)mapping;
+
+        __internal_installGuard(mapping, pageSize);
+
+        unsigned char* threadPointer = __internal_prepareStorage((unsigned char*)mapping + size);
+        unsigned char* stackTop = (unsigned char*)((itl::uintptr_t)(threadPointer - internalStorageTemplate.blockSize) & ~(itl::uintptr_t)15);
+
+        thread->threadId = 0;
+        thread->mapping = mapping;
+        thread->mappingSize = size;
+        thread->function = function;
+        thread->argument = argument;
+
+#ifdef __x86_64__
+        void* tls = threadPointer;
+#elif __i386__
+        // The child keeps the segment selector of its creator, so its
+        // descriptor replaces the same entry.
+        itl::linux::syscall::user_desc_struct descriptor;
+
+        __internal_describeSegment(&descriptor, __internal_segmentEntry(), threadPointer);
+
+        void* tls = &descriptor;
+#endif // #ifdef __x86_64__
+
+        long result = __internal_cloneThread(THREAD_CLONE_FLAGS, stackTop, &thread->threadId, tls, thread);
+
+        if (result < 0) {
+            itl::linux::syscall::munmap((unsigned long)mapping, size);
+            thread->mapping = nullptr;
+            return (int)result;
+        }
+
+        return 0;
+    }
+
+    void joinThread(itl::thread::Thread* thread)
+    {
+        int threadId;
+
+        // The kernel wakes the identifier as a shared futex.
+        while ((threadId = __atomic_load_n(&thread->threadId, __ATOMIC_ACQUIRE)) != 0)
+            itl::linux::syscall::futex((itl::uint32_t*)&thread->threadId, FUTEX_WAIT, (itl::uint32_t)threadId, nullptr, nullptr, 0);
+
+        itl::linux::syscall::munmap((unsigned long)thread->mapping, thread->mappingSize);
+        thread->mapping = nullptr;
+    }
+
+    itl::uint32_t getCpuCount()
+    {
+        unsigned long mask[THREAD_MAX_CPUS / (8 * sizeof(unsigned long))];
+        int size = itl::linux::syscall::sched_getaffinity(0, sizeof(mask), mask);
+        itl::uint32_t count = 0;
+
+        if (size <= 0)
+            return 1;
+
+        for (itl::size_t index = 0; index < (itl::size_t)size / sizeof(unsigned long); ++index) {
+            for (unsigned long bits = mask[index]; bits != 0; bits &= bits - 1)
+                ++count;
+        }
+
+        return count == 0 ? 1 : count;
+    }
+}; // namespace thread
+} // namespace itl
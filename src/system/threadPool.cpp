@@ -0,0 +1,484 @@
+/**
+ * @file src/system/threadPool.cpp
+ * @brief Implements the work-stealing thread pool.
+ * @category System
+ *
+ * This file contains the worker loop, the search for work (own deque,
+ * injection queue, then stealing from random victims), the sleeping and
+ * waking of idle workers, task groups and the fork-join helpers built on
+ * them.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#include "system/threadPool.hpp"
+#include "memory/allocator.hpp"
+#include "system/rawSyscalls.hpp"
+#include "system/sync.hpp"
+#include "system/thread.hpp"
+#include "typing/ctypes.hpp"
+
+#define POOL_MAX_SPLITS (8 * sizeof(itl::size_t)) ///< Halvings of a parallelFor range by one thread.
+#define POOL_PIECES_PER_THREAD 8 ///< Pieces per thread of a parallelFor range without a grain.
+
+/**
+ * @struct ParallelJob
+ * @brief Shared description of a parallelFor call.
+ */
+typedef struct {
+    itl::thread::ThreadPool* pool; ///< Pool running the job.
+    void (*function)(void*, itl::size_t, itl::size_t); ///< Function called on each piece.
+    void* argument; ///< Argument passed to the function.
+    itl::size_t grain; ///< Largest piece run by one call.
+} ParallelJob;
+
+/**
+ * @struct ParallelRange
+ * @brief A piece of a parallelFor range, run by one task.
+ */
+typedef struct {
+    const ParallelJob* job; ///< Job the piece belongs to.
+    itl::size_t begin; ///< First index.
+    itl::size_t end; ///< One past the last index.
+} ParallelRange;
+
+/**
+ * @brief Worker running on the calling thread, if any.
+ */
+static thread_local itl::thread::Worker* internalCurrentWorker
+    __attribute__((tls_model("initial-exec")));
+
+/**
+ * @brief Tells the processor the thread is spinning.
+ */
+static inline void __internal_relax()
+{
+    __builtin_ia32_pause();
+}
+
+/**
+ * @brief Advances a xorshift generator, used to pick steal victims.
+ */
+static inline itl::uint32_t __internal_nextRandom(itl::uint32_t* state)
+{
+    itl::uint32_t value = *state;
+
+    value ^= value << 13;
+    value ^= value >> 17;
+    value ^= value << 5;
+    *state = value;
+
+    return value;
+}
+
+/**
+ * @brief Wakes one sleeping worker, if any, after work was queued.
+ *
+ * The fence orders the publication of the task before the read of the
+ * sleeper count, while a worker raises the count before looking for work
+ * a last time, so one of the two always sees the other.
+ */
+static void __internal_notify(itl::thread::ThreadPool* pool)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    if (__atomic_load_n(&pool->sleepers, __ATOMIC_RELAXED) == 0)
+        return;
+
+    __atomic_add_fetch(&pool->epoch, 1, __ATOMIC_RELEASE);
+    itl::thread::futexWake(&pool->epoch, 1);
+}
+
+/**
+ * @brief Takes the oldest task of the injection queue.
+ */
+static itl::thread::Task* __internal_takeInjected(itl::thread::ThreadPool* pool)
+{
+    // Checked without the lock, so workers do not contend on an empty
+    // queue.
+    if (__atomic_load_n(&pool->injectedHead, __ATOMIC_RELAXED) == nullptr)
+        return nullptr;
+
+    itl::thread::lockMutex(&pool->injectionLock);
+
+    itl::thread::Task* task = pool->injectedHead;
+
+    if (task != nullptr) {
+        __atomic_store_n(&pool->injectedHead, task->next, __ATOMIC_RELAXED);
+
+        if (task->next == nullptr)
+            pool->injectedTail = nullptr;
+    }
+
+    itl::thread::unlockMutex(&pool->injectionLock);
+    return task;
+}
+
+/**
+ * @brief Queues a task from a thread outside the pool.
+ */
+static void __internal_inject(itl::thread::ThreadPool* pool, itl::thread::Task* task)
+{
+    itl::thread::lockMutex(&pool->injectionLock);
+
+    if (pool->injectedTail != nullptr)
+        pool->injectedTail->next = task;
+    else
+        __atomic_store_n(&pool->injectedHead, task, __ATOMIC_RELAXED);
+
+    pool->injectedTail = task;
+
+    itl::thread::unlockMutex(&pool->injectionLock);
+}
+
+/**
+ * @brief Steals a task from the workers, starting at a random one.
+ *
+ * When the victim has more tasks left, another sleeping worker is woken
+ * to help with them.
+ */
+static itl::thread::Task* __internal_steal(itl::thread::ThreadPool* pool, itl::thread::Worker* self, itl::uint32_t* random)
+{
+    itl::uint32_t count = pool->workerCount;
+    itl::uint32_t start = __internal_nextRandom(random) % count;
+
+    for (itl::uint32_t offset = 0; offset < count; ++offset) {
+        itl::uint32_t index = start + offset;
+        itl::thread::Worker* victim = &pool->workers[index < count ? index : index - count];
+
+        if (victim == self)
+            continue;
+
+        itl::thread::Task* task = itl::thread::stealDeque(&victim->deque);
+
+        if (task == nullptr)
+            continue;
+
+        if (!itl::thread::isDequeEmpty(&victim->deque))
+            __internal_notify(pool);
+
+        return task;
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Looks for a task to run: the own deque first, then the
+ * injection queue, then the deques of the other workers.
+ *
+ * @param worker The calling worker, or nullptr for other threads.
+ */
+static itl::thread::Task* __internal_findTask(itl::thread::ThreadPool* pool, itl::thread::Worker* worker, itl::uint32_t* random)
+{
+    itl::thread::Task* task;
+
+    if (worker != nullptr && (task = itl::thread::popDeque(&worker->deque)) != nullptr)
+        return task;
+
+    if ((task = __internal_takeInjected(pool)) != nullptr)
+        return task;
+
+    return __internal_steal(pool, worker, random);
+}
+
+/**
+ * @brief Runs a task and completes it in its group.
+ *
+ * The group may belong to a frame that returns as soon as the count
+ * drops to zero, so the word is only passed to the futex wake afterwards,
+ * never read; a stale wake at worst wakes a waiter that checks again.
+ */
+static void __internal_runTask(itl::thread::Task* task)
+{
+    itl::thread::TaskGroup* group = task->group;
+
+    task->function(task->argument);
+
+    if (__atomic_fetch_sub(&group->pending, 1, __ATOMIC_ACQ_REL) == (TASK_GROUP_WAITING | 1))
+        itl::thread::futexWake(&group->pending, FUTEX_WAKE_ALL);
+}
+
+/**
+ * @brief Main loop of a worker thread.
+ */
+static void __internal_workerMain(void* argument)
+{
+    itl::thread::Worker* worker = (itl::thread::Worker*)argument;
+    itl::thread::ThreadPool* pool = worker->pool;
+    itl::uint32_t idle = 0;
+
+    internalCurrentWorker = worker;
+
+    while (true) {
+        itl::thread::Task* task = __internal_findTask(pool, worker, &worker->random);
+
+        if (task != nullptr) {
+            __internal_runTask(task);
+            idle = 0;
+            continue;
+        }
+
+        if (__atomic_load_n(&pool->stopping, __ATOMIC_ACQUIRE))
+            break;
+
+        if (idle < POOL_SPIN_ROUNDS) {
+            ++idle;
+            __internal_relax();
+            continue;
+        }
+
+        // Announce the sleep, then look once more: a task queued before
+        // the announcement is found here, and one queued after it bumps
+        // the epoch, which the wait then sees.
+        itl::uint32_t epoch = __atomic_load_n(&pool->epoch, __ATOMIC_ACQUIRE);
+
+        __atomic_add_fetch(&pool->sleepers, 1, __ATOMIC_SEQ_CST);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+        task = __internal_findTask(pool, worker, &worker->random);
+
+        if (task == nullptr && !__atomic_load_n(&pool->stopping, __ATOMIC_ACQUIRE))
+            itl::thread::futexWait(&pool->epoch, epoch, nullptr);
+
+        __atomic_sub_fetch(&pool->sleepers, 1, __ATOMIC_RELAXED);
+        idle = 0;
+
+        if (task != nullptr)
+            __internal_runTask(task);
+    }
+
+    internalCurrentWorker = nullptr;
+}
+
+/**
+ * @brief Stops the first workers of a pool and joins them.
+ */
+static void __internal_stopWorkers(itl::thread::ThreadPool* pool, itl::uint32_t count)
+{
+    __atomic_store_n(&pool->stopping, 1, __ATOMIC_RELEASE);
+    __atomic_add_fetch(&pool->epoch, 1, __ATOMIC_SEQ_CST);
+    itl::thread::futexWake(&pool->epoch, FUTEX_WAKE_ALL);
+
+    for (itl::uint32_t index = 0; index < count; ++index)
+        itl::thread::joinThread(&pool->workers[index].thread);
+}
+
+/**
+ * @brief Runs a piece of a parallelFor range.
+ *
+ * The piece is halved down to the grain; each upper half is spawned and
+ * the lower one kept, so the oldest tasks on the deque, which thieves
+ * take first, are the largest.
+ */
+static void __internal_runRange(void* argument)
+{
+    const ParallelRange* range = (const ParallelRange*)argument;
+    const ParallelJob* job = range->job;
+    ParallelRange halves[POOL_MAX_SPLITS];
+    itl::thread::Task tasks[POOL_MAX_SPLITS];
+    itl::thread::TaskGroup group;
+    itl::size_t begin = range->begin;
+    itl::size_t end = range->end;
+    itl::size_t count = 0;
+
+    itl::thread::initializeTaskGroup(&group);
+
+    while (end - begin > job->grain && count < POOL_MAX_SPLITS) {
+        itl::size_t middle = begin + (end - begin) / 2;
+
+        halves[count].job = job;
+        halves[count].begin = middle;
+        halves[count].end = end;
+
+        itl::thread::spawnTask(job->pool, &group, &tasks[count], __internal_runRange, &halves[count]);
+
+        ++count;
+        end = middle;
+    }
+
+    job->function(job->argument, begin, end);
+
+    if (count != 0)
+        itl::thread::waitTaskGroup(job->pool, &group);
+}
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace thread {
+    int createPool(itl::thread::ThreadPool* pool, itl::uint32_t workerCount)
+    {
+        if (workerCount == 0) {
+            itl::uint32_t cpus = getCpuCount();
+            workerCount = cpus > 1 ? cpus - 1 : 1;
+        }
+
+        if (workerCount > POOL_MAX_WORKERS)
+            workerCount = POOL_MAX_WORKERS;
+
+        itl::thread::Worker* workers = (itl::thread::Worker*)itl::allocAligned(sizeof(itl::thread::Worker) * workerCount,
+            CACHE_LINE_SIZE);
+
+        if (workers == nullptr)
+            return -ENOMEM;
+
+        pool->workers = workers;
+        pool->workerCount = workerCount;
+        pool->stopping = 0;
+        initializeMutex(&pool->injectionLock);
+        pool->injectedHead = nullptr;
+        pool->injectedTail = nullptr;
+        pool->epoch = 0;
+        pool->sleepers = 0;
+
+        for (itl::uint32_t index = 0; index < workerCount; ++index) {
+            workers[index].deque.top = 0;
+            workers[index].deque.bottom = 0;
+            workers[index].pool = pool;
+            workers[index].index = index;
+            workers[index].random = (index + 1) * 0x9e3779b9U;
+        }
+
+        for (itl::uint32_t index = 0; index < workerCount; ++index) {
+            int result = createThread(&workers[index].thread, __internal_workerMain, &workers[index], 0);
+
+            if (result < 0) {
+                __internal_stopWorkers(pool, index);
+                itl::free(workers);
+                pool->workers = nullptr;
+                pool->workerCount = 0;
+                return result;
+            }
+        }
+
+        return 0;
+    }
+
+    void destroyPool(itl::thread::ThreadPool* pool)
+    {
+        if (pool->workers == nullptr)
+            return;
+
+        __internal_stopWorkers(pool, pool->workerCount);
+        itl::free(pool->workers);
+
+        pool->workers = nullptr;
+        pool->workerCount = 0;
+    }
+
+    void spawnTask(itl::thread::ThreadPool* pool, itl::thread::TaskGroup* group, itl::thread::Task* task,
+        void (*function)(void*), void* argument)
+    {
+        itl::thread::Worker* worker = internalCurrentWorker;
+
+        task->function = function;
+        task->argument = argument;
+        task->group = group;
+        task->next = nullptr;
+
+        __atomic_fetch_add(&group->pending, 1, __ATOMIC_RELAXED);
+
+        if (worker == nullptr || worker->pool != pool) {
+            __internal_inject(pool, task);
+        } else if (!pushDeque(&worker->deque, task)) {
+            // A full deque already holds plenty of work for the thieves.
+            __internal_runTask(task);
+            return;
+        }
+
+        __internal_notify(pool);
+    }
+
+    void waitTaskGroup(itl::thread::ThreadPool* pool, itl::thread::TaskGroup* group)
+    {
+        itl::thread::Worker* worker = internalCurrentWorker;
+        itl::uint32_t random = (itl::uint32_t)(itl::uintptr_t)group | 1;
+        itl::uint32_t idle = 0;
+
+        if (worker != nullptr && worker->pool != pool)
+            worker = nullptr;
+
+        while (true) {
+            itl::uint32_t pending = __atomic_load_n(&group->pending, __ATOMIC_ACQUIRE);
+
+            if ((pending & TASK_GROUP_COUNT_MASK) == 0)
+                break;
+
+            itl::thread::Task* task = __internal_findTask(pool, worker, &random);
+
+            if (task != nullptr) {
+                __internal_runTask(task);
+                idle = 0;
+                continue;
+            }
+
+            if (idle < POOL_SPIN_ROUNDS) {
+                ++idle;
+                __internal_relax();
+                continue;
+            }
+
+            // Every remaining task is running on another thread; the last
+            // one to finish sees the flag and wakes the group.
+            if (!(pending & TASK_GROUP_WAITING)
+                && !__atomic_compare_exchange_n(&group->pending, &pending, pending | TASK_GROUP_WAITING, false,
+                    __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                continue;
+
+            futexWait(&group->pending, pending | TASK_GROUP_WAITING, nullptr);
+        }
+
+        __atomic_fetch_and(&group->pending, TASK_GROUP_COUNT_MASK, __ATOMIC_RELAXED);
+    }
+
+    void forkJoin(itl::thread::ThreadPool* pool, void (*first)(void*), void* firstArgument,
+        void (*second)(void*), void* secondArgument)
+    {
+        itl::thread::TaskGroup group;
+        itl::thread::Task task;
+
+        initializeTaskGroup(&group);
+        spawnTask(pool, &group, &task, second, secondArgument);
+
+        first(firstArgument);
+        waitTaskGroup(pool, &group);
+    }
+
+    void parallelFor(itl::thread::ThreadPool* pool, itl::size_t begin, itl::size_t end, itl::size_t grain,
+        void (*function)(void*, itl::size_t, itl::size_t), void* argument)
+    {
+        if (end <= begin)
+            return;
+
+        if (grain == 0) {
+            grain = (end - begin) / ((pool->workerCount + 1) * POOL_PIECES_PER_THREAD);
+
+            if (grain == 0)
+                grain = 1;
+        }
+
+        ParallelJob job;
+        ParallelRange range;
+
+        job.pool = pool;
+        job.function = function;
+        job.argument = argument;
+        job.grain = grain;
+
+        range.job = &job;
+        range.begin = begin;
+        range.end = end;
+
+        __internal_runRange(&range);
+    }
+
+    int getWorkerIndex()
+    {
+        return internalCurrentWorker != nullptr ? (int)internalCurrentWorker->index : -1;
+    }
+}; // namespace thread
+} // namespace itl
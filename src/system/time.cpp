@@ -0,0 +1,673 @@
+/**
+ * @file src/system/time.cpp
+ * @brief Implements high-resolution clocks for the ITL library.
+ * @category System
+ *
+ * This file contains the parser that looks up clock functions in the
+ * symbol table of the vDSO, the clock readers built on them and the
+ * calibration of the time stamp counter.
+ *
+ * @author Ismael Moreira <ismaelmoreirakt@gmail.com>
+ * @date 16.10.2026
+ */
+#include "system/time.hpp"
+#include "system/auxv.hpp"
+#include "system/syscalls.hpp"
+#include "typing/ctypes.hpp"
+
+// ELF constants used to parse the vDSO
+#define PT_LOAD 1 ///< Loadable segment.
+#define PT_DYNAMIC 2 ///< Dynamic linking table.
+#define DT_NULL 0 ///< End of the dynamic table.
+#define DT_HASH 4 ///< Address of the SysV symbol hash table.
+#define DT_STRTAB 5 ///< Address of the string table.
+#define DT_SYMTAB 6 ///< Address of the symbol table.
+#define DT_GNU_HASH 0x6ffffef5 ///< Address of the GNU symbol hash table.
+#define DT_VERSYM 0x6ffffff0 ///< Address of the symbol version table.
+#define DT_VERDEF 0x6ffffffc ///< Address of the version definitions.
+#define STT_FUNC 2 ///< Symbol type of a function.
+#define STB_GLOBAL 1 ///< Global symbol binding.
+#define STB_WEAK 2 ///< Weak symbol binding.
+#define SHN_UNDEF 0 ///< Section index of an undefined symbol.
+#define VER_FLG_BASE 1 ///< Version definition of the file itself.
+#define VERSYM_HIDDEN 0x8000 ///< Hidden bit of a symbol version index.
+
+#define VDSO_VERSION "LINUX_2.6" ///< Version of the vDSO clock functions on x86.
+#define CPUID_EXTENDED_LEAVES 0x80000000 ///< CPUID leaf reporting the last extended leaf.
+#define CPUID_POWER_MANAGEMENT 0x80000007 ///< CPUID leaf reporting the invariant TSC.
+#define CPUID_INVARIANT_TSC (1U << 8) ///< Invariant TSC bit of the EDX register.
+#define TIME_MINIMUM_CALIBRATION 1000 ///< Shortest calibration accepted.
+#define TIME_MAXIMUM_CALIBRATION 1000000000 ///< Longest calibration accepted, keeping the products below 64 bits.
+
+#ifdef __x86_64__
+/**
+ * @struct ElfHeader
+ * @brief ELF64 file header.
+ */
+typedef struct {
+    unsigned char identification[16]; ///< Magic number and file class.
+    itl::uint16_t type; ///< Object file type.
+    itl::uint16_t machine; ///< Target architecture.
+    itl::uint32_t version; ///< Object file version.
+    itl::uint64_t entry; ///< Entry point address.
+    itl::uint64_t programHeaderOffset; ///< Offset of the program headers.
+    itl::uint64_t sectionHeaderOffset; ///< Offset of the section headers.
+    itl::uint32_t flags; ///< Processor-specific flags.
+    itl::uint16_t headerSize; ///< Size of this header.
+    itl::uint16_t programHeaderSize; ///< Size of one program header.
+    itl::uint16_t programHeaderCount; ///< Number of program headers.
+    itl::uint16_t sectionHeaderSize; ///< Size of one section header.
+    itl::uint16_t sectionHeaderCount; ///< Number of section headers.
+    itl::uint16_t sectionNameIndex; ///< Section holding the section names.
+} ElfHeader;
+
+/**
+ * @struct ElfProgramHeader
+ * @brief ELF64 program header.
+ */
+typedef struct {
+    itl::uint32_t type; ///< Segment type.
+    itl::uint32_t flags; ///< Segment flags.
+    itl::uint64_t offset; ///< Offset of the segment in the file.
+    itl::uint64_t virtualAddress; ///< Address of the segment in memory.
+    itl::uint64_t physicalAddress; ///< Unused physical address.
+    itl::uint64_t fileSize; ///< Bytes of the segment stored in the file.
+    itl::uint64_t memorySize; ///< Bytes of the segment in memory.
+    itl::uint64_t alignment; ///< Alignment of the segment.
+} ElfProgramHeader;
+
+/**
+ * @struct ElfDynamic
+ * @brief ELF64 entry of the dynamic table.
+ */
+typedef struct {
+    itl::int64_t tag; ///< Type of the entry.
+    itl::uint64_t value; ///< Value or address of the entry.
+} ElfDynamic;
+
+/**
+ * @struct ElfSymbol
+ * @brief ELF64 entry of the symbol table.
+ */
+typedef struct {
+    itl::uint32_t name; ///< Offset of the name in the string table.
+    unsigned char info; ///< Type and binding.
+    unsigned char other; ///< Visibility.
+    itl::uint16_t sectionIndex; ///< Section defining the symbol.
+    itl::uint64_t value; ///< Address of the symbol.
+    itl::uint64_t size; ///< Size of the symbol.
+} ElfSymbol;
+#else
+/**
+ * @struct ElfHeader
+ * @brief ELF32 file header.
+ */
+typedef struct {
+    unsigned char identification[16]; ///< Magic number and file class.
+    itl::uint16_t type; ///< Object file type.
+    itl::uint16_t machine; ///< Target architecture.
+    itl::uint32_t version; ///< Object file version.
+    itl::uint32_t entry; ///< Entry point address.
+    itl::uint32_t programHeaderOffset; ///< Offset of the program headers.
+    itl::uint32_t sectionHeaderOffset; ///< Offset of the section headers.
+    itl::uint32_t flags; ///< Processor-specific flags.
+    itl::uint16_t headerSize; ///< Size of this header.
+    itl::uint16_t programHeaderSize; ///< Size of one program header.
+    itl::uint16_t programHeaderCount; ///< Number of program headers.
+    itl::uint16_t sectionHeaderSize; ///< Size of one section header.
+    itl::uint16_t sectionHeaderCount; ///< Number of section headers.
+    itl::uint16_t sectionNameIndex; ///< Section holding the section names.
+} ElfHeader;
+
+/**
+ * @struct ElfProgramHeader
+ * @brief ELF32 program header.
+ */
+typedef struct {
+    itl::uint32_t type; ///< Segment type.
+    itl::uint32_t offset; ///< Offset of the segment in the file.
+    itl::uint32_t virtualAddress; ///< Address of the segment in memory.
+    itl::uint32_t physicalAddress; ///< Unused physical address.
+    itl::uint32_t fileSize; ///< Bytes of the segment stored in the file.
+    itl::uint32_t memorySize; ///< Bytes of the segment in memory.
+    itl::uint32_t flags; ///< Segment flags.
+    itl::uint32_t alignment; ///< Alignment of the segment.
+} ElfProgramHeader;
+
+/**
+ * @struct ElfDynamic
+ * @brief ELF32 entry of the dynamic table.
+ */
+typedef struct {
+    itl::int32_t tag; ///< Type of the entry.
+    itl::uint32_t value; ///< Value or address of the entry.
+} ElfDynamic;
+
+/**
+ * @struct ElfSymbol
+ * @brief ELF32 entry of the symbol table.
+ */
+typedef struct {
+    itl::uint32_t name; ///< Offset of the name in the string table.
+    itl::uint32_t value; ///< Address of the symbol.
+    itl::uint32_t size; ///< Size of the symbol.
+    unsigned char info; ///< Type and binding.
+    unsigned char other; ///< Visibility.
+    itl::uint16_t sectionIndex; ///< Section defining the symbol.
+} ElfSymbol;
+#endif // #ifdef __x86_64__
+
+/**
+ * @struct ElfVersionDefinition
+ * @brief Entry of the version definition table.
+ */
+typedef struct {
+    itl::uint16_t version; ///< Revision of the structure.
+    itl::uint16_t flags; ///< Version flags.
+    itl::uint16_t index; ///< Index referenced by the version table.
+    itl::uint16_t count; ///< Number of auxiliary entries.
+    itl::uint32_t hash; ///< Hash of the version name.
+    itl::uint32_t auxiliary; ///< Offset of the first auxiliary entry.
+    itl::uint32_t next; ///< Offset of the next definition, or 0.
+} ElfVersionDefinition;
+
+/**
+ * @struct ElfVersionAuxiliary
+ * @brief Auxiliary entry of a version definition, holding its name.
+ */
+typedef struct {
+    itl::uint32_t name; ///< Offset of the name in the string table.
+    itl::uint32_t next; ///< Offset of the next auxiliary entry, or 0.
+} ElfVersionAuxiliary;
+
+/**
+ * @struct VdsoImage
+ * @brief Tables of the vDSO needed to look up a symbol.
+ */
+typedef struct {
+    itl::uintptr_t loadOffset; ///< Difference between run-time and link-time addresses.
+    const ElfSymbol* symbols; ///< Symbol table.
+    const char* strings; ///< String table.
+    const itl::uint16_t* versions; ///< Version of each symbol, or nullptr.
+    const ElfVersionDefinition* definitions; ///< Version definitions, or nullptr.
+    itl::size_t symbolCount; ///< Number of entries in the symbol table.
+} VdsoImage;
+
+/**
+ * @brief Signature of the clock functions of the vDSO.
+ */
+typedef int (*ClockFunction)(int clock, itl::time::TimeSpec* time);
+
+static ClockFunction internalClockGetTime = nullptr; ///< clock_gettime of the vDSO, or nullptr.
+static ClockFunction internalClockGetResolution = nullptr; ///< clock_getres of the vDSO, or nullptr.
+static int internalInitialized = 0; ///< Set once the vDSO was searched.
+
+/**
+ * @struct CycleCalibration
+ * @brief Result of the last calibration of the time stamp counter.
+ *
+ * The fields are published under a sequence lock: the sequence is odd
+ * while a calibration rewrites them, and readers retry until they read the
+ * same even sequence before and after copying them, so they never combine
+ * the factor of one calibration with the base of another.
+ */
+typedef struct {
+    itl::uint32_t sequence; ///< Incremented before and after every update.
+    itl::uint64_t nanosecondsPerCycle; ///< Conversion factor, in 32.32 fixed point.
+    itl::uint64_t frequency; ///< Cycles per second.
+    itl::uint64_t baseCycles; ///< Counter value at the end of the calibration.
+    itl::uint64_t baseNanoseconds; ///< Monotonic time at the end of the calibration.
+    bool invariant; ///< Whether the counter can serve as a timestamp.
+} CycleCalibration;
+
+static CycleCalibration internalCalibration = {
+    .sequence = 0,
+    .nanosecondsPerCycle = (itl::uint64_t)1 << 32,
+    .frequency = 0,
+    .baseCycles = 0,
+    .baseNanoseconds = 0,
+    .invariant = false
+};
+
+/**
+ * @brief Copies a consistent snapshot of the calibration.
+ *
+ * @param calibration Receives the fields of one calibration.
+ */
+static void __internal_readCalibration(CycleCalibration* calibration)
+{
+    itl::uint32_t sequence;
+
+    do {
+        sequence = __atomic_load_n(&internalCalibration.sequence, __ATOMIC_ACQUIRE);
+
+        calibration->nanosecondsPerCycle = internalCalibration.nanosecondsPerCycle;
+        calibration->frequency = internalCalibration.frequency;
+        calibration->baseCycles = internalCalibration.baseCycles;
+        calibration->baseNanoseconds = internalCalibration.baseNanoseconds;
+        calibration->invariant = internalCalibration.invariant;
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while ((sequence & 1) != 0 || __atomic_load_n(&internalCalibration.sequence, __ATOMIC_RELAXED) != sequence);
+}
+
+/**
+ * @brief Compares two null-terminated strings.
+ */
+static bool __internal_equals(const char* first, const char* second)
+{
+    while (*first != '\0' && *first == *second) {
+        ++first;
+        ++second;
+    }
+
+    return *first == *second;
+}
+
+/**
+ * @brief Counts the symbols of the vDSO from its SysV hash table.
+ */
+static itl::size_t __internal_countFromHash(const itl::uint32_t* hash)
+{
+    return hash[1];
+}
+
+/**
+ * @brief Counts the symbols of the vDSO from its GNU hash table.
+ *
+ * The GNU table does not store the count: it is one past the last symbol
+ * of the chain that starts at the highest bucket, whose last entry has its
+ * lowest bit set.
+ */
+static itl::size_t __internal_countFromGnuHash(const itl::uint32_t* hash)
+{
+    itl::uint32_t bucketCount = hash[0];
+    itl::uint32_t symbolOffset = hash[1];
+    itl::uint32_t bloomSize = hash[2];
+    const itl::uint32_t* buckets = (const itl::uint32_t*)((const itl::uintptr_t*)(hash + 4) + bloomSize);
+    const itl::uint32_t* chains = buckets + bucketCount;
+    itl::uint32_t last = 0;
+
+    for (itl::uint32_t index = 0; index < bucketCount; ++index) {
+        if (buckets[index] > last)
+            last = buckets[index];
+    }
+
+    if (last < symbolOffset)
+        return symbolOffset;
+
+    while ((chains[last - symbolOffset] & 1) == 0)
+        ++last;
+
+    return last + 1;
+}
+
+/**
+ * @brief Locates the symbol, string and version tables of the vDSO.
+ *
+ * @param image Receives the tables.
+ * @return false if the vDSO is missing or malformed.
+ */
+static bool __internal_parseVdso(VdsoImage* image)
+{
+    itl::uintptr_t base = itl::linux::auxv::getValue(AT_SYSINFO_EHDR);
+
+    if (base == 0)
+        return false;
+
+    const ElfHeader* header = (const ElfHeader*)base;
+    const ElfProgramHeader* programHeaders = (const ElfProgramHeader*)(base + header->programHeaderOffset);
+    const ElfDynamic* dynamic = nullptr;
+    bool loaded = false;
+
+    if (header->identification[0] != 0x7f || header->identification[1] != 'E'
+        || header->identification[2] != 'L' || header->identification[3] != 'F')
+        return false;
+
+    for (itl::size_t index = 0; index < header->programHeaderCount; ++index) {
+        if (programHeaders[index].type == PT_LOAD && !loaded) {
+            image->loadOffset = base + programHeaders[index].offset - programHeaders[index].virtualAddress;
+            loaded = true;
+        } else if (programHeaders[index].type == PT_DYNAMIC) {
+            dynamic = (const ElfDynamic*)(base + programHeaders[index].offset);
+        }
+    }
+
+    if (!loaded || dynamic == nullptr)
+        return false;
+
+    const itl::uint32_t* hash = nullptr;
+    const itl::uint32_t* gnuHash = nullptr;
+
+    image->symbols = nullptr;
+    image->strings = nullptr;
+    image->versions = nullptr;
+    image->definitions = nullptr;
+
+    for (; dynamic->tag != DT_NULL; ++dynamic) {
+        itl::uintptr_t address = image->loadOffset + dynamic->value;
+
+        switch (dynamic->tag) {
+        case DT_HASH:
+            hash = (const itl::uint32_t*)address;
+            break;
+        case DT_GNU_HASH:
+            gnuHash = (const itl::uint32_t*)address;
+            break;
+        case DT_STRTAB:
+            image->strings = (const char*)address;
+            break;
+        case DT_SYMTAB:
+            image->symbols = (const ElfSymbol*)address;
+            break;
+        case DT_VERSYM:
+            image->versions = (const itl::uint16_t*)address;
+            break;
+        case DT_VERDEF:
+            image->definitions = (const ElfVersionDefinition*)address;
+            break;
+        }
+    }
+
+    if (image->symbols == nullptr || image->strings == nullptr)
+        return false;
+
+    if (hash != nullptr)
+        image->symbolCount = __internal_countFromHash(hash);
+    else if (gnuHash != nullptr)
+        image->symbolCount = __internal_countFromGnuHash(gnuHash);
+    else
+        return false;
+
+    if (image->definitions == nullptr)
+        image->versions = nullptr;
+
+    return true;
+}
+
+/**
+ * @brief Checks that a symbol of the vDSO has the expected version.
+ *
+ * Symbols without version information are accepted.
+ */
+static bool __internal_matchesVersion(const VdsoImage* image, itl::size_t symbol, const char* version)
+{
+    if (image->versions == nullptr)
+        return true;
+
+    itl::uint16_t index = image->versions[symbol] & ~VERSYM_HIDDEN;
+    const ElfVersionDefinition* definition = image->definitions;
+
+    while (true) {
+        if ((definition->flags & VER_FLG_BASE) == 0 && definition->index == index) {
+            const ElfVersionAuxiliary* auxiliary = (const ElfVersionAuxiliary*)((const char*)definition + definition->auxiliary);
+
+            return __internal_equals(image->strings + auxiliary->name, version);
+        }
+
+        if (definition->next == 0)
+            return false;
+
+        definition = (const ElfVersionDefinition*)((const char*)definition + definition->next);
+    }
+}
+
+/**
+ * @brief Looks up a function exported by the vDSO.
+ *
+ * @return The address of the function, or nullptr if it is not exported.
+ */
+static void* __internal_findSymbol(const VdsoImage* image, const char* name, const char* version)
+{
+    for (itl::size_t index = 0; index < image->symbolCount; ++index) {
+        const ElfSymbol* symbol = &image->symbols[index];
+        unsigned type = symbol->info & 0xf;
+        unsigned binding = symbol->info >> 4;
+
+        if (type != STT_FUNC || (binding != STB_GLOBAL && binding != STB_WEAK))
+            continue;
+
+        if (symbol->sectionIndex == SHN_UNDEF || !__internal_equals(image->strings + symbol->name, name))
+            continue;
+
+        if (!__internal_matchesVersion(image, index, version))
+            continue;
+
+        return (void*)(image->loadOffset + symbol->value);
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Executes the cpuid instruction.
+ */
+static void __internal_cpuid(itl::uint32_t leaf, itl::uint32_t registers[4])
+{
+    __asm__ volatile("cpuid"
+                     : "=a"(registers[0]), "=b"(registers[1]), "=c"(registers[2]), "=d"(registers[3])
+                     : "a"(leaf), "c"(0));
+}
+
+/**
+ * @brief Reports whether the time stamp counter ticks at a constant rate,
+ * regardless of frequency scaling and sleep states.
+ */
+static bool __internal_hasInvariantCounter()
+{
+    itl::uint32_t registers[4];
+
+    __internal_cpuid(CPUID_EXTENDED_LEAVES, registers);
+
+    if (registers[0] < CPUID_POWER_MANAGEMENT)
+        return false;
+
+    __internal_cpuid(CPUID_POWER_MANAGEMENT, registers);
+
+    return (registers[3] & CPUID_INVARIANT_TSC) != 0;
+}
+
+/**
+ * @brief Divides two 64-bit integers by shifting and subtracting.
+ *
+ * Calibration runs once, and this keeps 32-bit builds from depending on
+ * the 64-bit division routines of libgcc, which the ITL does not link.
+ */
+static itl::uint64_t __internal_divide(itl::uint64_t dividend, itl::uint64_t divisor)
+{
+    itl::uint64_t quotient = 0;
+    itl::uint64_t remainder = 0;
+
+    for (int bit = 63; bit >= 0; --bit) {
+        remainder = (remainder << 1) | ((dividend >> bit) & 1);
+
+        if (remainder >= divisor) {
+            remainder -= divisor;
+            quotient |= (itl::uint64_t)1 << bit;
+        }
+    }
+
+    return quotient;
+}
+
+/**
+ * @brief Multiplies a value by a 32.32 fixed-point factor.
+ *
+ * The product is assembled from 32-bit halves, so it needs neither 128-bit
+ * arithmetic nor a helper routine on 32-bit targets.
+ */
+static itl::uint64_t __internal_scale(itl::uint64_t value, itl::uint64_t factor)
+{
+    itl::uint64_t valueHigh = value >> 32;
+    itl::uint64_t valueLow = value & 0xffffffffULL;
+    itl::uint64_t factorHigh = factor >> 32;
+    itl::uint64_t factorLow = factor & 0xffffffffULL;
+
+    return ((valueHigh * factorHigh) << 32) + valueHigh * factorLow + valueLow * factorHigh
+        + ((valueLow * factorLow) >> 32);
+}
+
+/**
+ * @brief Converts a time value to nanoseconds.
+ */
+static itl::uint64_t __internal_toNanoseconds(const itl::time::TimeSpec* time)
+{
+    return (itl::uint64_t)time->seconds * NANOSECONDS_PER_SECOND + (itl::uint64_t)time->nanoseconds;
+}
+
+/**
+ * @namespace itl
+ * @brief A general-purpose namespace for the ITL library, containing
+ * custom STL components, allocators, types, and utilities.
+ */
+namespace itl {
+namespace time {
+    void initialize()
+    {
+        VdsoImage image;
+
+        if (__internal_parseVdso(&image)) {
+            __atomic_store_n(&internalClockGetTime,
+                (ClockFunction)__internal_findSymbol(&image, "__vdso_clock_gettime", VDSO_VERSION), __ATOMIC_RELAXED);
+            __atomic_store_n(&internalClockGetResolution,
+                (ClockFunction)__internal_findSymbol(&image, "__vdso_clock_getres", VDSO_VERSION), __ATOMIC_RELAXED);
+        }
+
+        __atomic_store_n(&internalInitialized, 1, __ATOMIC_RELEASE);
+    }
+
+    bool hasVdso()
+    {
+        if (__atomic_load_n(&internalInitialized, __ATOMIC_ACQUIRE) == 0)
+            initialize();
+
+        return __atomic_load_n(&internalClockGetTime, __ATOMIC_RELAXED) != nullptr;
+    }
+
+    int getTime(int clock, itl::time::TimeSpec* time)
+    {
+        if (__builtin_expect(__atomic_load_n(&internalInitialized, __ATOMIC_ACQUIRE) == 0, 0))
+            initialize();
+
+        ClockFunction function = __atomic_load_n(&internalClockGetTime, __ATOMIC_RELAXED);
+
+        if (function != nullptr)
+            return function(clock, time);
+
+        return itl::linux::syscall::clock_gettime(clock, time);
+    }
+
+    int getResolution(int clock, itl::time::TimeSpec* resolution)
+    {
+        if (__atomic_load_n(&internalInitialized, __ATOMIC_ACQUIRE) == 0)
+            initialize();
+
+        ClockFunction function = __atomic_load_n(&internalClockGetResolution, __ATOMIC_RELAXED);
+
+        if (function != nullptr)
+            return function(clock, resolution);
+
+        return itl::linux::syscall::clock_getres(clock, resolution);
+    }
+
+    itl::uint64_t monotonicNanoseconds()
+    {
+        itl::time::TimeSpec time;
+
+        if (getTime(CLOCK_MONOTONIC, &time) != 0)
+            return 0;
+
+        return __internal_toNanoseconds(&time);
+    }
+
+    itl::uint64_t realtimeNanoseconds()
+    {
+        itl::time::TimeSpec time;
+
+        if (getTime(CLOCK_REALTIME, &time) != 0)
+            return 0;
+
+        return __internal_toNanoseconds(&time);
+    }
+
+    bool calibrateCycles(itl::uint64_t durationNanoseconds)
+    {
+        if (durationNanoseconds == 0)
+            durationNanoseconds = TIME_CALIBRATION_NANOSECONDS;
+        else if (durationNanoseconds < TIME_MINIMUM_CALIBRATION)
+            durationNanoseconds = TIME_MINIMUM_CALIBRATION;
+        else if (durationNanoseconds > TIME_MAXIMUM_CALIBRATION)
+            durationNanoseconds = TIME_MAXIMUM_CALIBRATION;
+
+        itl::uint64_t startTime = monotonicNanoseconds();
+        itl::uint64_t startCycles = readCycles();
+        itl::uint64_t endTime;
+        itl::uint64_t endCycles;
+
+        do {
+            endTime = monotonicNanoseconds();
+            endCycles = readCycles();
+        } while (endTime - startTime < durationNanoseconds);
+
+        itl::uint64_t elapsed = endTime - startTime;
+        itl::uint64_t cycles = endCycles - startCycles;
+
+        if (cycles == 0)
+            return false;
+
+        itl::uint64_t nanosecondsPerCycle = __internal_divide(elapsed << 32, cycles);
+        itl::uint64_t frequency = __internal_divide(cycles * NANOSECONDS_PER_SECOND, elapsed);
+        bool invariant = __internal_hasInvariantCounter();
+        itl::uint32_t sequence = __atomic_load_n(&internalCalibration.sequence, __ATOMIC_RELAXED);
+
+        // Make the sequence odd, waiting out a concurrent calibration.
+        do {
+            while ((sequence & 1) != 0)
+                sequence = __atomic_load_n(&internalCalibration.sequence, __ATOMIC_RELAXED);
+        } while (!__atomic_compare_exchange_n(&internalCalibration.sequence, &sequence, sequence + 1, true,
+            __ATOMIC_ACQUIRE, __ATOMIC_RELAXED));
+
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+
+        internalCalibration.nanosecondsPerCycle = nanosecondsPerCycle;
+        internalCalibration.frequency = frequency;
+        internalCalibration.baseCycles = endCycles;
+        internalCalibration.baseNanoseconds = endTime;
+        internalCalibration.invariant = invariant;
+
+        __atomic_store_n(&internalCalibration.sequence, sequence + 2, __ATOMIC_RELEASE);
+
+        return invariant;
+    }
+
+    itl::uint64_t getCycleFrequency()
+    {
+        CycleCalibration calibration;
+
+        __internal_readCalibration(&calibration);
+
+        return calibration.frequency;
+    }
+
+    itl::uint64_t cyclesToNanoseconds(itl::uint64_t cycles)
+    {
+        CycleCalibration calibration;
+
+        __internal_readCalibration(&calibration);
+
+        return __internal_scale(cycles, calibration.nanosecondsPerCycle);
+    }
+
+    itl::uint64_t timestamp()
+    {
+        CycleCalibration calibration;
+
+        __internal_readCalibration(&calibration);
+
+        if (!calibration.invariant)
+            return monotonicNanoseconds();
+
+        return calibration.baseNanoseconds + __internal_scale(readCycles() - calibration.baseCycles, calibration.nanosecondsPerCycle);
+    }
+}; // namespace time
+} // namespace itl